@@ -0,0 +1,441 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file GeometryBench.cpp
+/// \brief This file implements vkf_geometry_bench, a microbenchmark of the stages of the GeometryHandling pipeline.
+///
+/// Every stage of the geometry pipeline of the GraticuleActor (load, project, split, enlarge, clip and flatten) is run
+/// repeatedly on a generated graticule and on the bundled Natural Earth shapefiles. For each benchmark the time per
+/// iteration, the processed vertices per second, the heap allocations per iteration and the peak resident set size of
+/// the process are reported. The results are printed as a table and written as JSON, so that they can be compared
+/// across commits. The benchmark needs no GPU.
+///
+/// Usage: vkf_geometry_bench [--out=<file>] [--min_time=<seconds>] [--filter=<substring>]
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../vkf/common/GeometryHandling.h"
+#include "../vkf/common/PolylineIndex.h"
+#include "../vkf/common/PolylineSet.h"
+#include "../vkf/common/Utility.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gdal.h>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Heap allocation counter
+// =======================
+
+namespace
+{
+
+std::atomic<uint64_t> allocationCount{0};
+
+void *countedAllocate(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    return countedAllocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return countedAllocate(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+
+// Benchmark harness
+// =================
+
+struct BenchmarkOptions
+{
+    std::string outputFile = "geometry_bench.json";
+    double minTime = 0.5;
+    std::string filter;
+};
+
+struct BenchmarkResult
+{
+    std::string name;
+    uint64_t iterations{0};
+    double timePerIteration_ns{0.0};
+    uint64_t verticesPerIteration{0};
+    double verticesPerSecond{0.0};
+    double allocationsPerIteration{0.0};
+    uint64_t peakRss_bytes{0};
+};
+
+///
+/// \brief Peak resident set size of the process in bytes.
+///
+uint64_t getPeakRss()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+///
+/// \brief Runs benchmarks and collects their results.
+///
+/// Each iteration consists of an untimed setup, e.g. copying the input that a stage modifies in place, followed by
+/// the timed stage. Iterations are repeated until the accumulated time of the stage exceeds the minimum time.
+///
+class BenchmarkRunner
+{
+  public:
+    explicit BenchmarkRunner(BenchmarkOptions options) : options{std::move(options)}
+    {
+    }
+
+    void run(const std::string &name, uint64_t verticesPerIteration, const std::function<void()> &setup,
+             const std::function<void()> &stage)
+    {
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos)
+        {
+            return;
+        }
+
+        // Warm up caches and memory pools before measuring.
+        setup();
+        stage();
+
+        std::chrono::nanoseconds totalTime{0};
+        uint64_t totalAllocations = 0;
+        uint64_t iterations = 0;
+        const auto minTime = std::chrono::duration<double>(options.minTime);
+        while (iterations == 0 || totalTime < minTime)
+        {
+            setup();
+            uint64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+            auto start = std::chrono::steady_clock::now();
+            stage();
+            auto end = std::chrono::steady_clock::now();
+            totalAllocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+            totalTime += end - start;
+            iterations++;
+        }
+
+        BenchmarkResult result;
+        result.name = name;
+        result.iterations = iterations;
+        result.timePerIteration_ns = static_cast<double>(totalTime.count()) / static_cast<double>(iterations);
+        result.verticesPerIteration = verticesPerIteration;
+        result.verticesPerSecond = static_cast<double>(verticesPerIteration) / (result.timePerIteration_ns * 1.0e-9);
+        result.allocationsPerIteration = static_cast<double>(totalAllocations) / static_cast<double>(iterations);
+        result.peakRss_bytes = getPeakRss();
+
+        std::printf("%-48s %10.0f ns %10llu %14.4g %12.1f %10.1f\n", result.name.c_str(), result.timePerIteration_ns,
+                    static_cast<unsigned long long>(result.iterations), result.verticesPerSecond,
+                    result.allocationsPerIteration, static_cast<double>(result.peakRss_bytes) / (1024.0 * 1024.0));
+        std::fflush(stdout);
+
+        results.push_back(std::move(result));
+    }
+
+    void printHeader() const
+    {
+        std::printf("%-48s %13s %10s %14s %12s %10s\n", "Benchmark", "Time", "Iterations", "Vertices/s", "Allocs/iter",
+                    "Peak MiB");
+        std::printf("%s\n", std::string(112, '-').c_str());
+    }
+
+    bool writeJson() const
+    {
+        std::ofstream file(options.outputFile);
+        if (!file)
+        {
+            std::cerr << "Could not write benchmark results to " << options.outputFile << std::endl;
+            return false;
+        }
+
+        std::time_t now = std::time(nullptr);
+        char date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        // Same layout as the JSON output of Google Benchmark, with the additional counters as fields.
+        file << "{\n";
+        file << "  \"context\": {\n";
+        file << "    \"date\": \"" << date << "\",\n";
+        file << "    \"executable\": \"vkf_geometry_bench\",\n";
+        file << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+        file << "    \"library_build_type\": \"release\"\n";
+#else
+        file << "    \"library_build_type\": \"debug\"\n";
+#endif
+        file << "  },\n";
+        file << "  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const BenchmarkResult &result = results[i];
+            file << "    {\n";
+            file << "      \"name\": \"" << result.name << "\",\n";
+            file << "      \"iterations\": " << result.iterations << ",\n";
+            file << "      \"real_time\": " << result.timePerIteration_ns << ",\n";
+            file << "      \"time_unit\": \"ns\",\n";
+            file << "      \"vertices\": " << result.verticesPerIteration << ",\n";
+            file << "      \"items_per_second\": " << result.verticesPerSecond << ",\n";
+            file << "      \"allocations_per_iteration\": " << result.allocationsPerIteration << ",\n";
+            file << "      \"peak_rss_bytes\": " << result.peakRss_bytes << "\n";
+            file << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        file << "  ]\n";
+        file << "}\n";
+        return true;
+    }
+
+  private:
+    BenchmarkOptions options;
+    std::vector<BenchmarkResult> results;
+};
+
+BenchmarkOptions parseOptions(int argc, char **argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        if (argument.rfind("--out=", 0) == 0)
+        {
+            options.outputFile = argument.substr(6);
+        }
+        else if (argument.rfind("--min_time=", 0) == 0)
+        {
+            options.minTime = std::stod(argument.substr(11));
+        }
+        else if (argument.rfind("--filter=", 0) == 0)
+        {
+            options.filter = argument.substr(9);
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--out=<file>] [--min_time=<seconds>] [--filter=<substring>]"
+                      << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+    return options;
+}
+
+// Geometry pipeline stages
+// ========================
+
+// Same parameters as the GraticuleActor and the ProjectionComponent defaults.
+const std::string projString = "+proj=stere +lat_0=90 +lon_0=0 +x_0=0 +y_0=0 +datum=WGS84 +units=m +no_defs";
+const Met3D::PointF rotatedNorthPole = Met3D::PointF(-170.0f, 40.0f);
+constexpr double rotatedGridMaxSegmentLength_deg = 20.0;
+// Densification tolerance of the 1:50m datasets and its equivalent in proj map units.
+constexpr double densificationTolerance_deg = 0.225;
+constexpr double projMapUnitsPerDegree = 111320.0 / Met3D::MetConstants::scaleFactorToFitProjectedCoordsTo360Range;
+const Met3D::RectF globalBBox = Met3D::RectF(-180.0f, -90.0f, 180.0f, 90.0f);
+const Met3D::RectF europeBBox = Met3D::RectF(-30.0f, 30.0f, 50.0f, 75.0f);
+const Met3D::RectF wideBBox = Met3D::RectF(-540.0f, -90.0f, 540.0f, 90.0f);
+
+void runPipelineBenchmarks(BenchmarkRunner &runner, const std::string &dataset, const Met3D::PolylineSet &geometry)
+{
+    Met3D::GeometryHandling geo;
+    geo.initProjProjection(projString);
+    geo.initRotatedLonLatProjection(rotatedNorthPole);
+
+    const uint64_t numVertices = geometry.getNumVertices();
+    Met3D::PolylineSet input{geo.getPolylineMemoryResource()};
+    Met3D::PolylineSet output{geo.getPolylineMemoryResource()};
+    auto copyInput = [&]() {
+        input.clear();
+        input.appendPolylines(geometry);
+    };
+    auto clearOutput = [&]() { output.clear(); };
+
+    // Projection
+    // ----------
+    runner.run("project/cylindrical/" + dataset, numVertices, clearOutput,
+               [&]() { output.appendPolylines(geometry); });
+    runner.run("project/proj/" + dataset, numVertices, copyInput,
+               [&]() { geo.geographicalToProjectedCoordinates(&input); });
+    geo.setClosedFormProjectionsEnabled(true);
+    runner.run("project/closed_form/" + dataset, numVertices, copyInput,
+               [&]() { geo.geographicalToProjectedCoordinates(&input); });
+    geo.setClosedFormProjectionsEnabled(false);
+    runner.run("project/rotated/" + dataset, numVertices, copyInput,
+               [&]() { geo.geographicalToRotatedCoordinates(&input); });
+    runner.run("project/proj_adaptive/" + dataset, numVertices, copyInput, [&]() {
+        geo.geographicalToProjectedCoordinatesAdaptive(&input, densificationTolerance_deg * projMapUnitsPerDegree);
+    });
+    runner.run("project/rotated_adaptive/" + dataset, numVertices, copyInput,
+               [&]() { geo.geographicalToRotatedCoordinatesAdaptive(&input, densificationTolerance_deg); });
+
+    // Split
+    // -----
+    Met3D::PolylineSet rotatedGeometry{geo.getPolylineMemoryResource()};
+    rotatedGeometry.appendPolylines(geometry);
+    geo.geographicalToRotatedCoordinates(&rotatedGeometry);
+    runner.run("split/rotated/" + dataset, numVertices,
+               [&]() {
+                   input.clear();
+                   input.appendPolylines(rotatedGeometry);
+               },
+               [&]() { geo.splitLineSegmentsLongerThanThreshold(&input, rotatedGridMaxSegmentLength_deg); });
+
+    // Enlarge
+    // -------
+    runner.run("enlarge/-540..540/" + dataset, numVertices, copyInput,
+               [&]() { geo.enlargeGeometryToBBoxIfNecessary(&input, wideBBox); });
+
+    // Clip
+    // ----
+    Met3D::PolylineIndex index(geometry);
+    runner.run("clip/global/" + dataset, numVertices, clearOutput,
+               [&]() { geo.clipPolygons(geometry, index, globalBBox, &output); });
+    runner.run("clip/europe/" + dataset, numVertices, clearOutput,
+               [&]() { geo.clipPolygons(geometry, index, europeBBox, &output); });
+    runner.run("clip/europe_without_index/" + dataset, numVertices, clearOutput,
+               [&]() { geo.clipPolygons(geometry, europeBBox, &output); });
+    runner.run("index/build/" + dataset, numVertices, []() {},
+               [&]() { index = Met3D::PolylineIndex(geometry); });
+
+    // Flatten
+    // -------
+    std::vector<int> startIndices;
+    std::vector<int> vertexCounts;
+    runner.run("flatten/" + dataset, numVertices,
+               [&]() {
+                   startIndices.clear();
+                   vertexCounts.clear();
+               },
+               [&]() { geo.flattenPolygonsToVertexList(geometry, &startIndices, &vertexCounts); });
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    BenchmarkOptions options = parseOptions(argc, argv);
+    spdlog::set_level(spdlog::level::warn);
+    GDALAllRegister();
+
+    BenchmarkRunner runner(options);
+    runner.printHeader();
+
+    // Generated graticule with the defaults of the GraticuleComponent.
+    {
+        Met3D::GeometryHandling geo;
+        std::vector<float> longitudes = vkf::createRange(-180.0f, 180.0f, 20.0f);
+        std::vector<float> latitudes = vkf::createRange(-90.0f, 90.0f, 10.0f);
+        Met3D::Vector2D spacing = Met3D::Vector2D(Met3D::PointF(1.0f, 1.0f));
+
+        Met3D::PolylineSet graticule;
+        geo.generate2DGraticuleGeometry(longitudes, latitudes, spacing, &graticule);
+        runner.run("generate/graticule", graticule.getNumVertices(), [&]() { graticule.clear(); },
+                   [&]() { geo.generate2DGraticuleGeometry(longitudes, latitudes, spacing, &graticule); });
+        runPipelineBenchmarks(runner, "graticule", graticule);
+    }
+
+    // Natural Earth shapefiles used by the GraticuleActor.
+    const std::vector<std::pair<std::string, std::string>> shapefiles = {
+        {"coastline", "/assets/ne_50m_coastline/ne_50m_coastline.shp"},
+        {"borderline", "/assets/ne_50m_admin_0_boundary_lines_land/ne_50m_admin_0_boundary_lines_land.shp"}};
+
+    for (const auto &[dataset, path] : shapefiles)
+    {
+        std::string fileName = PROJECT_ROOT_DIR + path;
+        Met3D::GeometryHandling geo;
+        Met3D::PolylineSet geometry;
+
+        // The first load fills the geometry cache, the benchmark measures loads from the cache.
+        if (!geo.read2DGeometryFromShapefile(fileName, globalBBox, &geometry))
+        {
+            std::cerr << "Skipping " << dataset << ", could not read " << fileName << std::endl;
+            continue;
+        }
+        runner.run("load/" + dataset, geometry.getNumVertices(), [&]() { geometry.clear(); },
+                   [&]() { geo.read2DGeometryFromShapefile(fileName, globalBBox, &geometry); });
+        runPipelineBenchmarks(runner, dataset, geometry);
+    }
+
+    bool written = runner.writeJson();
+    return written ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -40,6 +40,8 @@
 #define TEXTURE_BINDING 2
 
 #define MAX_PUSH_CONSTANTS 32
+// The last push constant is the uniform handle of versioned uniform 0 of the frame, see BindlessManager.
+#define FRAME_BASE_INDEX 31
 
 #define INIT_PUSH_CONSTANTS                                                                                            \
     layout(push_constant) uniform PushConstants                                                                        \
@@ -58,6 +60,8 @@
 
 #define GET_DATA(name, index) name[pushConstants.indices[index]]
 
+#define GET_VERSIONED_DATA(name, index) name[pushConstants.indices[FRAME_BASE_INDEX] + pushConstants.indices[index]]
+
 INIT_PUSH_CONSTANTS;
 
 NEW_UNIFORM_BUFFER(data, {
@@ -80,7 +84,7 @@ NEW_TEXTURE(mapTexture);
 #extension GL_EXT_nonuniform_qualifier : enable
 
 mat4 mvpMatrix = GET_DATA(camera, CAMERA_INDEX).viewMatrix;
-vec4 cornersData = GET_DATA(data, DATA_INDEX).cornersData;
+vec4 cornersData = GET_VERSIONED_DATA(data, DATA_INDEX).cornersData;
 
 layout(location = 0) in vec2 position;
 
@@ -110,10 +114,10 @@ void main()
 #define DEG2RAD M_PI / 180.0
 #define RAD2DEG 180.0 / M_PI
 
-float colorIntensity = GET_DATA(data, DATA_INDEX).colorIntensity; // 0..1 with 1 = rgb texture used, 0 = grey scales
-vec4 cornersData = GET_DATA(data, DATA_INDEX).cornersData;
-float poleLat = GET_DATA(data, DATA_INDEX).poleLat;
-float poleLon = GET_DATA(data, DATA_INDEX).poleLon;
+float colorIntensity = GET_VERSIONED_DATA(data, DATA_INDEX).colorIntensity; // 0..1 with 1 = rgb texture used, 0 = grey scales
+vec4 cornersData = GET_VERSIONED_DATA(data, DATA_INDEX).cornersData;
+float poleLat = GET_VERSIONED_DATA(data, DATA_INDEX).poleLat;
+float poleLon = GET_VERSIONED_DATA(data, DATA_INDEX).poleLon;
 
 layout(location = 0) in smooth vec2 position2D;
 
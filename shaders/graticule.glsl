@@ -0,0 +1,193 @@
+// shader::global
+#define BINDLESS 1
+
+#define DESCRIPTOR_SET 0
+
+#define CAMERA_INDEX 0
+#define COLOR_INDEX 1
+#define MODEL_INDEX 2
+#define REPETITION_INDEX 3
+#define GRATICULE_INDEX 4
+
+#define UNIFORM_BINDING 0
+#define STORAGE_BINDING 1
+#define TEXTURE_BINDING 2
+
+#define MAX_PUSH_CONSTANTS 32
+// The last push constant is the uniform handle of versioned uniform 0 of the frame, see BindlessManager.
+#define FRAME_BASE_INDEX 31
+
+#define INIT_PUSH_CONSTANTS                                                                                            \
+    layout(push_constant) uniform PushConstants                                                                        \
+    {                                                                                                                  \
+        uint indices[MAX_PUSH_CONSTANTS];                                                                              \
+    }                                                                                                                  \
+    pushConstants
+
+#define NEW_UNIFORM_BUFFER(name, data)                                                                                 \
+    layout(set = DESCRIPTOR_SET, binding = UNIFORM_BINDING) uniform name##Buffer data name[]
+
+#define NEW_STORAGE_BUFFER(bufferLayout, bufferAccess, name, data)                                                     \
+    layout(bufferLayout, set = DESCRIPTOR_SET, binding = UNIFORM_BINDING) bufferAccess buffer name##Buffer data name[]
+
+#define NEW_TEXTURE(name) layout(set = DESCRIPTOR_SET, binding = TEXTURE_BINDING) uniform sampler2D name[]
+
+#define GET_DATA(name, index) name[pushConstants.indices[index]]
+
+#define GET_VERSIONED_DATA(name, index) name[pushConstants.indices[FRAME_BASE_INDEX] + pushConstants.indices[index]]
+
+INIT_PUSH_CONSTANTS;
+
+NEW_UNIFORM_BUFFER(model, { mat4 modelMatrix; });
+
+NEW_UNIFORM_BUFFER(camera, { mat4 viewMatrix; });
+
+NEW_UNIFORM_BUFFER(colors, { vec4 color; });
+
+NEW_UNIFORM_BUFFER(repetition, {
+    vec4 clipRect;    // left, lower, right and upper limit of the bbox
+    float firstShift; // x offset of the first instance
+    float shift;      // x offset between two instances, 360 for cylindrical projections
+    vec2 padding;
+});
+
+NEW_UNIFORM_BUFFER(graticule, {
+    vec4 meridians;   // first longitude, distance between meridians, first latitude, vertex spacing
+    vec4 parallels;   // first latitude, distance between parallels, first longitude, vertex spacing
+    uvec4 counts;     // number of meridians, segments per meridian, number of parallels, segments per parallel
+    vec4 rotatedPole; // pole longitude, pole latitude, 1 for rotated lon-lat projections, maximum segment length
+});
+
+/*****************************************************************************
+ ***                           VERTEX SHADER
+ *****************************************************************************/
+// shader::vertex
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_EXT_nonuniform_qualifier : enable
+
+#define M_PI 3.1415926535897932384626433832795
+#define DEG2RAD M_PI / 180.0
+#define RAD2DEG 180.0 / M_PI
+
+out float gl_ClipDistance[4];
+
+mat4 modelMatrix = GET_DATA(model, MODEL_INDEX).modelMatrix;
+mat4 viewMatrix = GET_DATA(camera, CAMERA_INDEX).viewMatrix;
+vec4 clipRect = GET_VERSIONED_DATA(repetition, REPETITION_INDEX).clipRect;
+float firstShift = GET_VERSIONED_DATA(repetition, REPETITION_INDEX).firstShift;
+float shift = GET_VERSIONED_DATA(repetition, REPETITION_INDEX).shift;
+vec4 meridians = GET_VERSIONED_DATA(graticule, GRATICULE_INDEX).meridians;
+vec4 parallels = GET_VERSIONED_DATA(graticule, GRATICULE_INDEX).parallels;
+uvec4 counts = GET_VERSIONED_DATA(graticule, GRATICULE_INDEX).counts;
+vec4 rotatedPole = GET_VERSIONED_DATA(graticule, GRATICULE_INDEX).rotatedPole;
+
+// Geographical coordinates of the given vertex of the given line segment of
+// the graticule. The meridians are stored before the parallels.
+vec2 getGraticuleVertex(uint segment, uint vertex);
+
+// Ported from the scalar geographicalToRotated kernel of
+// RotatedPoleKernels.cpp, see there for the origin of the code.
+vec2 geographicalToRotatedCoords(vec2 position);
+
+// Vertex shader that generates the graticule procedurally. Two consecutive
+// vertices form a line segment, so that segments which cross the map domain
+// after projection can be dropped without splitting a line strip.
+void main()
+{
+    uint segment = uint(gl_VertexIndex) / 2;
+    vec2 start = getGraticuleVertex(segment, 0);
+    vec2 end = getGraticuleVertex(segment, 1);
+
+    bool isVisible = true;
+    if (rotatedPole.z > 0.0)
+    {
+        start = geographicalToRotatedCoords(start);
+        end = geographicalToRotatedCoords(end);
+
+        // Same heuristic as GeometryHandling::splitLineSegmentsLongerThanThreshold().
+        isVisible = length(end - start) < rotatedPole.w;
+    }
+
+    // Each instance draws one repetition of the globe, shifted in x.
+    vec2 position = (gl_VertexIndex % 2 == 0) ? start : end;
+    position.x += firstShift + float(gl_InstanceIndex) * shift;
+
+    // Clip the graticule to the bbox, invisible segments are clipped entirely.
+    gl_ClipDistance[0] = position.x - clipRect.x;
+    gl_ClipDistance[1] = clipRect.z - position.x;
+    gl_ClipDistance[2] = position.y - clipRect.y;
+    gl_ClipDistance[3] = clipRect.w - position.y;
+    if (!isVisible)
+    {
+        gl_ClipDistance[0] = -1.0;
+    }
+
+    gl_Position = viewMatrix * modelMatrix * vec4(position.x, 0.3, -position.y, 1.0);
+}
+
+vec2 getGraticuleVertex(uint segment, uint vertex)
+{
+    uint numMeridianSegments = counts.x * counts.y;
+    if (segment < numMeridianSegments)
+    {
+        uint meridian = segment / counts.y;
+        uint step = segment % counts.y + vertex;
+        return vec2(meridians.x + float(meridian) * meridians.y, meridians.z + float(step) * meridians.w);
+    }
+
+    segment -= numMeridianSegments;
+    uint parallel = segment / counts.w;
+    uint step = segment % counts.w + vertex;
+    return vec2(parallels.z + float(step) * parallels.w, parallels.x + float(parallel) * parallels.y);
+}
+
+vec2 geographicalToRotatedCoords(vec2 position)
+{
+    float lon = position.x;
+    float lat = position.y;
+
+    if (lon > 180.0)
+    {
+        lon -= 360.0;
+    }
+
+    float lonRad = DEG2RAD * lon;
+    float latRad = DEG2RAD * lat;
+    float poleLonRad = DEG2RAD * rotatedPole.x;
+    float sinPoleLat = sin(DEG2RAD * rotatedPole.y);
+    float cosPoleLat = cos(DEG2RAD * rotatedPole.y);
+
+    float x = ((-sinPoleLat) * cos(latRad) * cos(lonRad - poleLonRad)) + (cosPoleLat * sin(latRad));
+    float y = (-sin(lonRad - poleLonRad)) * cos(latRad);
+    float z = (cosPoleLat * cos(latRad) * cos(lonRad - poleLonRad)) + (sinPoleLat * sin(latRad));
+
+    // Avoid invalid values for z (Might occure due to inaccuracies in
+    // computations).
+    z = clamp(z, -1.0, 1.0);
+
+    // Too small values can lead to numerical problems in method atan.
+    if (abs(x) < 1.0e-20)
+    {
+        x = 1.0e-20;
+    }
+
+    return vec2(RAD2DEG * atan(y, x), RAD2DEG * asin(z));
+}
+
+/*****************************************************************************
+ ***                          FRAGMENT SHADER
+ *****************************************************************************/
+// shader::fragment
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_EXT_nonuniform_qualifier : enable
+
+layout(location = 0) out vec4 outColor;
+
+vec4 color = GET_DATA(colors, COLOR_INDEX).color;
+
+void main()
+{
+    outColor = vec4(color);
+}
\ No newline at end of file
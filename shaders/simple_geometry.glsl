@@ -6,12 +6,15 @@
 #define CAMERA_INDEX 0
 #define COLOR_INDEX 1
 #define MODEL_INDEX 2
+#define REPETITION_INDEX 3
 
 #define UNIFORM_BINDING 0
 #define STORAGE_BINDING 1
 #define TEXTURE_BINDING 2
 
 #define MAX_PUSH_CONSTANTS 32
+// The last push constant is the uniform handle of versioned uniform 0 of the frame, see BindlessManager.
+#define FRAME_BASE_INDEX 31
 
 #define INIT_PUSH_CONSTANTS                                                                                            \
     layout(push_constant) uniform PushConstants                                                                        \
@@ -30,6 +33,8 @@
 
 #define GET_DATA(name, index) name[pushConstants.indices[index]]
 
+#define GET_VERSIONED_DATA(name, index) name[pushConstants.indices[FRAME_BASE_INDEX] + pushConstants.indices[index]]
+
 INIT_PUSH_CONSTANTS;
 
 NEW_UNIFORM_BUFFER(model, { mat4 modelMatrix; });
@@ -38,6 +43,13 @@ NEW_UNIFORM_BUFFER(camera, { mat4 viewMatrix; });
 
 NEW_UNIFORM_BUFFER(colors, { vec4 color; });
 
+NEW_UNIFORM_BUFFER(repetition, {
+    vec4 clipRect;    // left, lower, right and upper limit of the bbox
+    float firstShift; // x offset of the first instance
+    float shift;      // x offset between two instances, 360 for cylindrical projections
+    vec2 padding;
+});
+
 /*****************************************************************************
  ***                           VERTEX SHADER
  *****************************************************************************/
@@ -48,12 +60,26 @@ NEW_UNIFORM_BUFFER(colors, { vec4 color; });
 
 layout(location = 0) in vec2 positions;
 
+out float gl_ClipDistance[4];
+
 mat4 modelMatrix = GET_DATA(model, MODEL_INDEX).modelMatrix;
 mat4 viewMatrix = GET_DATA(camera, CAMERA_INDEX).viewMatrix;
+vec4 clipRect = GET_VERSIONED_DATA(repetition, REPETITION_INDEX).clipRect;
+float firstShift = GET_VERSIONED_DATA(repetition, REPETITION_INDEX).firstShift;
+float shift = GET_VERSIONED_DATA(repetition, REPETITION_INDEX).shift;
 
 void main()
 {
-    gl_Position = viewMatrix * modelMatrix * vec4(positions.x, 0.3, -positions.y, 1.0);
+    // Each instance draws one repetition of the globe, shifted in x.
+    vec2 position = vec2(positions.x + firstShift + float(gl_InstanceIndex) * shift, positions.y);
+
+    // Clip the repetitions to the bbox.
+    gl_ClipDistance[0] = position.x - clipRect.x;
+    gl_ClipDistance[1] = clipRect.z - position.x;
+    gl_ClipDistance[2] = position.y - clipRect.y;
+    gl_ClipDistance[3] = clipRect.w - position.y;
+
+    gl_Position = viewMatrix * modelMatrix * vec4(position.x, 0.3, -position.y, 1.0);
 }
 
 /*****************************************************************************
@@ -0,0 +1,399 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file ClipPolygonsTest.cpp
+/// \brief This file implements vkf_clip_polygons_test, a property test of the batch polyline clipper.
+///
+/// GeometryHandling::clipPolygons skips polylines by their bounding box, accepts polylines that lie inside the clip box
+/// unchanged and computes the region codes of all vertices at once. This test generates random polylines and clip
+/// boxes, including NaN and infinite coordinates, vertices on the boundary of the box, repeated vertices and degenerate
+/// boxes, and checks that all overloads of clipPolygons return exactly the polylines of the per-segment
+/// Cohen-Sutherland clipper they replaced.
+///
+/// Usage: vkf_clip_polygons_test [--iterations=<n>] [--seed=<n>]
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../vkf/common/GeometryHandling.h"
+#include "../vkf/common/PolylineIndex.h"
+#include "../vkf/common/PolylineSet.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using Met3D::PointF;
+using Met3D::RectF;
+using Polygons = std::vector<std::vector<PointF>>;
+
+// Reference implementation
+// ========================
+// Per-segment clipper as it was implemented before the batch clipper: every
+// segment of every polyline is passed to the Cohen-Sutherland clipper.
+
+enum RegionCode
+{
+    INSIDE = 0,
+    LEFT = 1,
+    RIGHT = 2,
+    BOTTOM = 4,
+    TOP = 8
+};
+
+int referenceCode(const PointF &point, const RectF &bbox)
+{
+    int code = INSIDE;
+
+    if (point.x < bbox.left)
+    {
+        code |= LEFT;
+    }
+    else if (point.x > bbox.right)
+    {
+        code |= RIGHT;
+    }
+    if (point.y < bbox.top)
+    {
+        code |= BOTTOM;
+    }
+    else if (point.y > bbox.bottom)
+    {
+        code |= TOP;
+    }
+
+    return code;
+}
+
+bool referenceClipSegment(PointF *p1, PointF *p2, const RectF &bbox)
+{
+    int code1 = referenceCode(*p1, bbox);
+    int code2 = referenceCode(*p2, bbox);
+
+    while (true)
+    {
+        if ((code1 == 0) && (code2 == 0))
+        {
+            return true;
+        }
+        if (code1 & code2)
+        {
+            return false;
+        }
+
+        int codeOut = code1 != 0 ? code1 : code2;
+        double x = 0.0;
+        double y = 0.0;
+
+        // NOTE: RectF has reversed y-axis, hence the upper limit is
+        // bbox.bottom and the lower limit bbox.top.
+        if (codeOut & TOP)
+        {
+            x = p1->x + (p2->x - p1->x) * (bbox.bottom - p1->y) / (p2->y - p1->y);
+            y = bbox.bottom;
+        }
+        else if (codeOut & BOTTOM)
+        {
+            x = p1->x + (p2->x - p1->x) * (bbox.top - p1->y) / (p2->y - p1->y);
+            y = bbox.top;
+        }
+        else if (codeOut & RIGHT)
+        {
+            y = p1->y + (p2->y - p1->y) * (bbox.right - p1->x) / (p2->x - p1->x);
+            x = bbox.right;
+        }
+        else if (codeOut & LEFT)
+        {
+            y = p1->y + (p2->y - p1->y) * (bbox.left - p1->x) / (p2->x - p1->x);
+            x = bbox.left;
+        }
+
+        if (codeOut == code1)
+        {
+            p1->x = static_cast<float>(x);
+            p1->y = static_cast<float>(y);
+            code1 = referenceCode(*p1, bbox);
+        }
+        else
+        {
+            p2->x = static_cast<float>(x);
+            p2->y = static_cast<float>(y);
+            code2 = referenceCode(*p2, bbox);
+        }
+    }
+}
+
+Polygons referenceClipPolygons(const Polygons &polygons, const RectF &bbox)
+{
+    Polygons clippedPolygons;
+
+    for (const std::vector<PointF> &polygon : polygons)
+    {
+        std::vector<PointF> clippedPolygon;
+
+        for (size_t i = 0; i + 1 < polygon.size(); i++)
+        {
+            PointF p1 = polygon[i];
+            PointF p2 = polygon[i + 1];
+
+            if (!referenceClipSegment(&p1, &p2, bbox))
+            {
+                continue;
+            }
+
+            if (clippedPolygon.empty())
+            {
+                if (!(p1 == p2))
+                {
+                    clippedPolygon.emplace_back(p1);
+                }
+                clippedPolygon.emplace_back(p2);
+            }
+            else if (p1 == clippedPolygon.back())
+            {
+                if (!(p2 == clippedPolygon.back()))
+                {
+                    clippedPolygon.emplace_back(p2);
+                }
+            }
+            else
+            {
+                clippedPolygons.emplace_back(clippedPolygon);
+                clippedPolygon = {p1, p2};
+            }
+        }
+
+        if (!clippedPolygon.empty())
+        {
+            clippedPolygons.emplace_back(clippedPolygon);
+        }
+    }
+
+    return clippedPolygons;
+}
+
+// Random input
+// ============
+
+class InputGenerator
+{
+  public:
+    explicit InputGenerator(uint32_t seed) : random(seed)
+    {
+    }
+
+    RectF generateBBox()
+    {
+        float left = uniform(-180.0f, 180.0f);
+        float top = uniform(-90.0f, 90.0f);
+
+        // One in eight boxes has no width or no height.
+        float width = chance(16) ? 0.0f : uniform(0.0f, 90.0f);
+        float height = chance(16) ? 0.0f : uniform(0.0f, 45.0f);
+        return RectF{left, top, left + width, top + height};
+    }
+
+    Polygons generatePolygons(const RectF &bbox)
+    {
+        Polygons polygons(std::uniform_int_distribution<int>(0, 32)(random));
+        for (std::vector<PointF> &polygon : polygons)
+        {
+            polygon.resize(std::uniform_int_distribution<int>(0, 24)(random));
+
+            // Polylines are generated around a random centre with a random
+            // extent, so that they lie inside, outside or across the box.
+            float extentX = std::max(bbox.width(), 1.0f) * uniform(0.1f, 2.0f);
+            float extentY = std::max(bbox.bottom - bbox.top, 1.0f) * uniform(0.1f, 2.0f);
+            float centreX = uniform(bbox.left - extentX, bbox.right + extentX);
+            float centreY = uniform(bbox.top - extentY, bbox.bottom + extentY);
+
+            for (size_t i = 0; i < polygon.size(); i++)
+            {
+                polygon[i] = generateVertex(bbox, centreX, centreY, extentX, extentY);
+                if (i > 0 && chance(10))
+                {
+                    polygon[i] = polygon[i - 1];
+                }
+            }
+        }
+        return polygons;
+    }
+
+  private:
+    PointF generateVertex(const RectF &bbox, float centreX, float centreY, float extentX, float extentY)
+    {
+        PointF vertex{uniform(centreX - extentX, centreX + extentX), uniform(centreY - extentY, centreY + extentY)};
+        vertex.x = specialCoordinate(vertex.x, bbox.left, bbox.right);
+        vertex.y = specialCoordinate(vertex.y, bbox.top, bbox.bottom);
+        return vertex;
+    }
+
+    // Replaces some coordinates by a limit of the box or a non-finite value.
+    float specialCoordinate(float value, float lowerLimit, float upperLimit)
+    {
+        switch (std::uniform_int_distribution<int>(0, 49)(random))
+        {
+        case 0:
+            return lowerLimit;
+        case 1:
+            return upperLimit;
+        case 2:
+            return std::numeric_limits<float>::quiet_NaN();
+        case 3:
+            return std::numeric_limits<float>::infinity();
+        case 4:
+            return -std::numeric_limits<float>::infinity();
+        default:
+            return value;
+        }
+    }
+
+    float uniform(float min, float max)
+    {
+        return std::uniform_real_distribution<float>(min, max)(random);
+    }
+
+    bool chance(int oneIn)
+    {
+        return std::uniform_int_distribution<int>(0, oneIn - 1)(random) == 0;
+    }
+
+    std::mt19937 random;
+};
+
+// Comparison
+// ==========
+
+// Vertices are compared by their bits, so that NaN coordinates that are
+// passed through unchanged compare equal.
+bool equalBits(const PointF &a, const PointF &b)
+{
+    return std::memcmp(&a.x, &b.x, sizeof(float)) == 0 && std::memcmp(&a.y, &b.y, sizeof(float)) == 0;
+}
+
+bool equalPolygons(const Polygons &expected, const Polygons &actual, std::string *mismatch)
+{
+    if (expected.size() != actual.size())
+    {
+        *mismatch = "expected " + std::to_string(expected.size()) + " polylines, got " +
+                    std::to_string(actual.size());
+        return false;
+    }
+
+    for (size_t polygon = 0; polygon < expected.size(); polygon++)
+    {
+        if (expected[polygon].size() != actual[polygon].size())
+        {
+            *mismatch = "polyline " + std::to_string(polygon) + ": expected " +
+                        std::to_string(expected[polygon].size()) + " vertices, got " +
+                        std::to_string(actual[polygon].size());
+            return false;
+        }
+        for (size_t vertex = 0; vertex < expected[polygon].size(); vertex++)
+        {
+            const PointF &a = expected[polygon][vertex];
+            const PointF &b = actual[polygon][vertex];
+            if (!equalBits(a, b))
+            {
+                *mismatch = "polyline " + std::to_string(polygon) + ", vertex " + std::to_string(vertex) +
+                            ": expected (" + std::to_string(a.x) + ", " + std::to_string(a.y) + "), got (" +
+                            std::to_string(b.x) + ", " + std::to_string(b.y) + ")";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+struct TestOptions
+{
+    int iterations = 2000;
+    uint32_t seed = 20261017;
+};
+
+TestOptions parseOptions(int argc, char **argv)
+{
+    TestOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        if (argument.rfind("--iterations=", 0) == 0)
+        {
+            options.iterations = std::stoi(argument.substr(13));
+        }
+        else if (argument.rfind("--seed=", 0) == 0)
+        {
+            options.seed = static_cast<uint32_t>(std::stoul(argument.substr(7)));
+        }
+        else
+        {
+            std::cerr << "Unknown argument: " << argument << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    TestOptions options = parseOptions(argc, argv);
+    InputGenerator generator(options.seed);
+    Met3D::GeometryHandling geo;
+
+    int failures = 0;
+    for (int iteration = 0; iteration < options.iterations; iteration++)
+    {
+        RectF bbox = generator.generateBBox();
+        Polygons polygons = generator.generatePolygons(bbox);
+        Polygons expected = referenceClipPolygons(polygons, bbox);
+
+        // Batch clipper with a prebuilt index, as used by the graticule cache,
+        // with an index built on the fly and through the vector overload.
+        Met3D::PolylineSet polylines = Met3D::PolylineSet::fromPolygons(polygons);
+        Met3D::PolylineIndex index(polylines);
+        Met3D::PolylineSet clippedWithIndex;
+        geo.clipPolygons(polylines, index, bbox, &clippedWithIndex);
+        Met3D::PolylineSet clippedWithoutIndex;
+        geo.clipPolygons(polylines, bbox, &clippedWithoutIndex);
+
+        const std::pair<const char *, Polygons> results[] = {
+            {"clipPolygons(PolylineSet, PolylineIndex)", clippedWithIndex.toPolygons()},
+            {"clipPolygons(PolylineSet)", clippedWithoutIndex.toPolygons()},
+            {"clipPolygons(std::vector)", geo.clipPolygons(polygons, bbox)}};
+
+        for (const auto &[overload, actual] : results)
+        {
+            std::string mismatch;
+            if (!equalPolygons(expected, actual, &mismatch))
+            {
+                std::cerr << "Iteration " << iteration << ", " << overload << ", bbox (" << bbox.left << ", "
+                          << bbox.top << ", " << bbox.right << ", " << bbox.bottom << "): " << mismatch << std::endl;
+                failures++;
+            }
+        }
+    }
+
+    if (failures > 0)
+    {
+        std::cerr << failures << " mismatches in " << options.iterations << " iterations (seed " << options.seed
+                  << ")" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Batch clipper matches the per-segment clipper in " << options.iterations << " iterations (seed "
+              << options.seed << ")" << std::endl;
+    return EXIT_SUCCESS;
+}
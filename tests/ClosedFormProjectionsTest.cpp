@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file ClosedFormProjectionsTest.cpp
+/// \brief This file implements vkf_closed_form_projections_test, which compares the closed-form projections to proj.
+///
+/// Polar stereographic and Lambert conformal conic projections can be evaluated by the closed-form kernels of
+/// ConformalConicKernels.h instead of proj (see GeometryHandling::setClosedFormProjectionsEnabled()). For a set of
+/// projections supported by the kernels, a global grid is transformed forward and inverse with both and the test fails
+/// if the results differ by more than a millimetre. Points that proj cannot transform have to be rejected by the
+/// kernels as well.
+///
+/// Usage: vkf_closed_form_projections_test
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../vkf/common/GeometryHandling.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Projections that are evaluated by the conformal conic kernels instead of proj.
+const std::vector<std::string> closedFormProjStrings = {
+    "+proj=stere +lat_0=90 +lon_0=0 +x_0=0 +y_0=0 +datum=WGS84 +units=m +no_defs",
+    "+proj=stere +lat_0=90 +lat_ts=70 +lon_0=-45 +x_0=0 +y_0=0 +datum=WGS84 +units=m +no_defs",
+    "+proj=stere +lat_0=-90 +lon_0=0 +k=0.994 +x_0=2000000 +y_0=2000000 +datum=WGS84 +units=m +no_defs",
+    "+proj=lcc +lat_0=40 +lon_0=-97 +lat_1=33 +lat_2=45 +x_0=0 +y_0=0 +datum=WGS84 +units=m +no_defs",
+    "+proj=lcc +lat_1=50 +lon_0=10 +R=6371229 +units=m +no_defs",
+    "+proj=lcc +lat_0=45 +lon_0=0 +lat_1=30 +lat_2=60 +ellps=sphere +units=m +no_defs"};
+// Largest accepted distance between the results of the kernels and proj.
+constexpr double closedFormMaxError_m = 1.e-3;
+
+constexpr double metresPerDegree = 111320.0;
+constexpr double degreesToRadians = 3.14159265358979323846 / 180.0;
+
+struct ProjectionErrors
+{
+    double forward_m = 0.0;
+    double inverse_m = 0.0;
+    // Points that only one of both could transform.
+    size_t numMismatchedFailures = 0;
+};
+
+// Keeps the larger error, a NaN error of a point that both transformed is
+// reported as infinite.
+void updateMaxError(double error, double *maxError)
+{
+    if (!(error <= *maxError))
+    {
+        *maxError = std::isnan(error) ? INFINITY : error;
+    }
+}
+
+ProjectionErrors compareToProj(const std::string &definition, const std::vector<double> &lon,
+                               const std::vector<double> &lat)
+{
+    const double scale = Met3D::MetConstants::scaleFactorToFitProjectedCoordsTo360Range;
+    ProjectionErrors errors;
+
+    Met3D::GeometryHandling geo;
+    geo.initProjProjection(definition);
+
+    // Forward, the results are scaled down by the magic scaling constant.
+    std::vector<double> kernelX = lon, kernelY = lat, projX = lon, projY = lat;
+    geo.setClosedFormProjectionsEnabled(true);
+    geo.geographicalToProjectedCoordinates(kernelX.data(), kernelY.data(), lon.size());
+    geo.setClosedFormProjectionsEnabled(false);
+    geo.geographicalToProjectedCoordinates(projX.data(), projY.data(), lon.size());
+
+    for (size_t i = 0; i < lon.size(); i++)
+    {
+        bool isProjFinite = std::isfinite(projX[i]) && std::isfinite(projY[i]);
+        bool isKernelFinite = std::isfinite(kernelX[i]) && std::isfinite(kernelY[i]);
+        if (isProjFinite != isKernelFinite)
+        {
+            errors.numMismatchedFailures++;
+        }
+        else if (isProjFinite)
+        {
+            updateMaxError(std::hypot((kernelX[i] - projX[i]) * scale, (kernelY[i] - projY[i]) * scale),
+                           &errors.forward_m);
+        }
+    }
+
+    // Inverse of the grid projected by proj, so that both start from the
+    // same projected coordinates.
+    std::vector<double> kernelLon = projX, kernelLat = projY, projLon = projX, projLat = projY;
+    geo.setClosedFormProjectionsEnabled(true);
+    geo.geographicalToProjectedCoordinates(kernelLon.data(), kernelLat.data(), lon.size(), true);
+    geo.setClosedFormProjectionsEnabled(false);
+    geo.geographicalToProjectedCoordinates(projLon.data(), projLat.data(), lon.size(), true);
+
+    for (size_t i = 0; i < lon.size(); i++)
+    {
+        if (!std::isfinite(projX[i]) || !std::isfinite(projY[i]))
+        {
+            continue;
+        }
+        bool isProjFinite = std::isfinite(projLon[i]) && std::isfinite(projLat[i]);
+        bool isKernelFinite = std::isfinite(kernelLon[i]) && std::isfinite(kernelLat[i]);
+        if (isProjFinite != isKernelFinite)
+        {
+            errors.numMismatchedFailures++;
+        }
+        else if (isProjFinite)
+        {
+            double deltaLon = std::remainder(kernelLon[i] - projLon[i], 360.0);
+            updateMaxError(metresPerDegree * std::hypot(deltaLon * std::cos(projLat[i] * degreesToRadians),
+                                                        kernelLat[i] - projLat[i]),
+                           &errors.inverse_m);
+        }
+    }
+
+    return errors;
+}
+
+} // namespace
+
+int main()
+{
+    // Global grid including the antimeridian. The poles are left out, the
+    // antipodal pole of a stereographic projection has no finite image.
+    std::vector<double> lon;
+    std::vector<double> lat;
+    for (double y = -89.5; y <= 89.5; y += 0.5)
+    {
+        for (double x = -180.0; x <= 180.0; x += 0.75)
+        {
+            lon.push_back(x);
+            lat.push_back(y);
+        }
+    }
+
+    std::printf("%-96s %12s %12s %9s\n", "Closed-form projection", "Forward m", "Inverse m", "Failures");
+    bool passed = true;
+    for (const std::string &definition : closedFormProjStrings)
+    {
+        ProjectionErrors errors = compareToProj(definition, lon, lat);
+        std::printf("%-96s %12.3g %12.3g %9zu\n", definition.c_str(), errors.forward_m, errors.inverse_m,
+                    errors.numMismatchedFailures);
+        passed = passed && errors.forward_m <= closedFormMaxError_m && errors.inverse_m <= closedFormMaxError_m &&
+                 errors.numMismatchedFailures == 0;
+    }
+
+    if (!passed)
+    {
+        std::fprintf(stderr, "The closed-form projections differ from proj by more than %g m or fail at other points\n",
+                     closedFormMaxError_m);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
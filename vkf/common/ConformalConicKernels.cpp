@@ -0,0 +1,358 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file ConformalConicKernels.cpp
+/// \brief This file implements the parsing of the conformal conic parameters, the scalar kernels and the runtime
+/// selection of the SIMD kernels.
+///
+/// The parameters follow the setup of the stere and lcc projections of the proj library, the kernels follow Snyder
+/// (1987), equations 15-1 to 15-11 and 21-1 to 21-4. The SIMD kernels are implemented in ConformalConicKernelsSse4.cpp
+/// and ConformalConicKernelsAvx2.cpp.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ConformalConicKernels.h"
+#include "CpuFeatures.h"
+#include "Log.h"
+#include "SimdMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+
+namespace Met3D
+{
+
+static const double DEG2RAD = SimdMath::PI / 180.0;
+static const double RAD2DEG = 180.0 / SimdMath::PI;
+static const double TWO_PI = 2.0 * SimdMath::PI;
+
+// Tolerance of proj for parameters that are compared to the poles.
+static const double EPS10 = 1.e-10;
+
+///
+/// \brief Isometric colatitude t(phi) of Snyder, equation 15-9 (pj_tsfn in proj).
+///
+static double tsfn(double phi, double e)
+{
+    double eSinPhi = e * std::sin(phi);
+    return std::tan(0.5 * (SimdMath::PIO2 - phi)) / std::pow((1.0 - eSinPhi) / (1.0 + eSinPhi), 0.5 * e);
+}
+
+///
+/// \brief Radius of the parallel phi on the unit ellipsoid, Snyder equation 14-15 (pj_msfn in proj).
+///
+static double msfn(double phi, double e)
+{
+    double eSinPhi = e * std::sin(phi);
+    return std::cos(phi) / std::sqrt(1.0 - eSinPhi * eSinPhi);
+}
+
+std::optional<ConformalConicParameters> ConformalConicParameters::fromProjString(const std::string &projString)
+{
+    // Collect the parameters. Flags without a value are stored with an empty
+    // value.
+    std::map<std::string, std::string> parameters;
+    std::istringstream tokens(projString);
+    std::string token;
+    while (tokens >> token)
+    {
+        if (token.front() == '+')
+        {
+            token.erase(0, 1);
+        }
+        size_t separator = token.find('=');
+        std::string key = token.substr(0, separator);
+        std::string value = separator == std::string::npos ? "" : token.substr(separator + 1);
+        parameters[key] = value;
+    }
+
+    // Any parameter that is not handled here could change the projection, so
+    // such definitions are left to proj.
+    static const char *knownKeys[] = {"proj", "lat_0", "lon_0", "lat_1", "lat_2", "lat_ts",  "k",    "k_0",   "x_0",
+                                      "y_0",  "ellps", "datum", "R",     "units", "no_defs", "type", "wktext"};
+    for (const auto &[key, value] : parameters)
+    {
+        if (std::find(std::begin(knownKeys), std::end(knownKeys), key) == std::end(knownKeys))
+        {
+            return std::nullopt;
+        }
+    }
+
+    auto has = [&parameters](const char *key) { return parameters.contains(key); };
+
+    // Returns false if the parameter is present but not a plain number, e.g.
+    // an angle in degrees, minutes and seconds.
+    auto getNumber = [&parameters](const char *key, double defaultValue, double *result) {
+        auto it = parameters.find(key);
+        if (it == parameters.end())
+        {
+            *result = defaultValue;
+            return true;
+        }
+        const char *begin = it->second.c_str();
+        char *end = nullptr;
+        *result = std::strtod(begin, &end);
+        return end != begin && *end == '\0' && std::isfinite(*result);
+    };
+
+    if ((has("units") && parameters["units"] != "m") || (has("type") && parameters["type"] != "crs"))
+    {
+        return std::nullopt;
+    }
+
+    // Ellipsoid, proj defaults to GRS80.
+    double a = 6378137.0;
+    double inverseFlattening = 298.257222101;
+    if (has("R"))
+    {
+        if (!getNumber("R", 0.0, &a) || a <= 0.0)
+        {
+            return std::nullopt;
+        }
+        inverseFlattening = 0.0;
+    }
+    else
+    {
+        std::string ellps = has("ellps") ? parameters["ellps"] : "";
+        if (ellps.empty() && has("datum"))
+        {
+            if (parameters["datum"] != "WGS84")
+            {
+                return std::nullopt;
+            }
+            ellps = "WGS84";
+        }
+
+        if (ellps == "WGS84")
+        {
+            inverseFlattening = 298.257223563;
+        }
+        else if (ellps == "sphere")
+        {
+            a = 6370997.0;
+            inverseFlattening = 0.0;
+        }
+        else if (!ellps.empty() && ellps != "GRS80")
+        {
+            return std::nullopt;
+        }
+    }
+    double flattening = inverseFlattening > 0.0 ? 1.0 / inverseFlattening : 0.0;
+
+    ConformalConicParameters params;
+    params.e = std::sqrt(flattening * (2.0 - flattening));
+
+    double lat0 = 0.0, lon0 = 0.0, k0 = 1.0;
+    if (!getNumber("lat_0", 0.0, &lat0) || !getNumber("lon_0", 0.0, &lon0) || !getNumber("x_0", 0.0, &params.x0) ||
+        !getNumber("y_0", 0.0, &params.y0) || !getNumber(has("k_0") ? "k_0" : "k", 1.0, &k0) || k0 <= 0.0)
+    {
+        return std::nullopt;
+    }
+    double phi0 = DEG2RAD * lat0;
+    params.lon0 = DEG2RAD * lon0;
+    double e = params.e;
+
+    std::string proj = has("proj") ? parameters["proj"] : "";
+    if (proj == "stere")
+    {
+        // Only the polar aspects are conformal conic projections, the oblique
+        // and equatorial aspects are left to proj.
+        if (std::abs(std::abs(phi0) - SimdMath::PIO2) >= EPS10)
+        {
+            return std::nullopt;
+        }
+
+        double phits = SimdMath::PIO2;
+        if (!getNumber("lat_ts", 90.0, &phits))
+        {
+            return std::nullopt;
+        }
+        phits *= DEG2RAD;
+
+        // Scale of rho on the unit ellipsoid (akm1 in proj), Snyder equations
+        // 21-33 and 21-34.
+        double akm1;
+        if (std::abs(phits - SimdMath::PIO2) < EPS10)
+        {
+            akm1 = 2.0 * k0 / std::sqrt(std::pow(1.0 + e, 1.0 + e) * std::pow(1.0 - e, 1.0 - e));
+        }
+        else if (phi0 > 0.0 && std::abs(phits) < SimdMath::PIO2)
+        {
+            akm1 = msfn(phits, e) / tsfn(phits, e);
+        }
+        else
+        {
+            // The handling of lat_ts for the south pole differs between the
+            // versions of proj.
+            return std::nullopt;
+        }
+
+        // The south polar aspect is the north polar aspect with a cone constant
+        // of -1, which mirrors latitudes and longitudes.
+        params.n = phi0 > 0.0 ? 1.0 : -1.0;
+        params.c = params.n * a * akm1;
+        params.rho0 = 0.0;
+        return params;
+    }
+    else if (proj == "lcc")
+    {
+        double lat1 = 0.0, lat2 = 0.0;
+        if (!has("lat_1") || !getNumber("lat_1", 0.0, &lat1))
+        {
+            return std::nullopt;
+        }
+        if (has("lat_2"))
+        {
+            if (!getNumber("lat_2", 0.0, &lat2))
+            {
+                return std::nullopt;
+            }
+        }
+        else
+        {
+            // A tangent cone, proj uses its standard parallel as the origin if
+            // no other origin is given.
+            lat2 = lat1;
+            if (!has("lat_0"))
+            {
+                phi0 = DEG2RAD * lat1;
+            }
+        }
+
+        double phi1 = DEG2RAD * lat1;
+        double phi2 = DEG2RAD * lat2;
+        if (std::abs(phi1) > SimdMath::PIO2 || std::abs(phi2) > SimdMath::PIO2 || std::abs(phi1 + phi2) < EPS10)
+        {
+            return std::nullopt;
+        }
+
+        // Snyder equations 15-8 to 15-10.
+        double m1 = msfn(phi1, e);
+        double t1 = tsfn(phi1, e);
+        if (std::abs(phi1 - phi2) >= EPS10)
+        {
+            params.n = std::log(m1 / msfn(phi2, e)) / std::log(t1 / tsfn(phi2, e));
+        }
+        else
+        {
+            params.n = std::sin(phi1);
+        }
+        if (params.n == 0.0 || !std::isfinite(params.n))
+        {
+            return std::nullopt;
+        }
+
+        params.c = a * k0 * m1 * std::pow(t1, -params.n) / params.n;
+        params.rho0 =
+            std::abs(std::abs(phi0) - SimdMath::PIO2) < EPS10 ? 0.0 : params.c * std::pow(tsfn(phi0, e), params.n);
+        return params;
+    }
+
+    return std::nullopt;
+}
+
+static void forwardScalar(const ConformalConicParameters &params, double *x, double *y, size_t numPoints)
+{
+    for (size_t i = 0; i < numPoints; i++)
+    {
+        double lam = DEG2RAD * x[i] - params.lon0;
+        lam -= TWO_PI * std::nearbyint(lam / TWO_PI);
+        double phi = DEG2RAD * y[i];
+        double sinPhi = std::sin(phi);
+        double cosPhi = std::cos(phi);
+
+        // log t(phi), tan(pi/4 - phi/2) is evaluated without cancellation on
+        // both hemispheres.
+        double logT = sinPhi > 0.0 ? std::log(cosPhi / (1.0 + sinPhi)) : std::log((1.0 - sinPhi) / cosPhi);
+        double eSinPhi = params.e * sinPhi;
+        logT += 0.5 * params.e * std::log((1.0 + eSinPhi) / (1.0 - eSinPhi));
+
+        double rho = params.c * std::exp(params.n * logT);
+        // The apex of the cone is a point, the opposite pole is at infinity.
+        if (std::abs(std::abs(phi) - SimdMath::PIO2) < EPS10)
+        {
+            rho = phi * params.n > 0.0 ? 0.0 : NAN;
+        }
+
+        double theta = params.n * lam;
+        x[i] = params.x0 + rho * std::sin(theta);
+        y[i] = params.y0 + params.rho0 - rho * std::cos(theta);
+    }
+}
+
+static void inverseScalar(const ConformalConicParameters &params, double *x, double *y, size_t numPoints)
+{
+    for (size_t i = 0; i < numPoints; i++)
+    {
+        double xp = x[i] - params.x0;
+        double yp = params.rho0 - (y[i] - params.y0);
+        double rho = std::sqrt(xp * xp + yp * yp);
+        if (params.n < 0.0)
+        {
+            rho = -rho;
+            xp = -xp;
+            yp = -yp;
+        }
+
+        // Snyder equation 7-9, iterated until the latitude does not change.
+        double t = std::exp(std::log(rho / params.c) / params.n);
+        double phi = SimdMath::PIO2 - 2.0 * std::atan(t);
+        for (int iteration = 0; params.e > 0.0 && iteration < 15; iteration++)
+        {
+            double eSinPhi = params.e * std::sin(phi);
+            double conformalFactor = std::exp(-0.5 * params.e * std::log((1.0 + eSinPhi) / (1.0 - eSinPhi)));
+            double nextPhi = SimdMath::PIO2 - 2.0 * std::atan(t * conformalFactor);
+            bool converged = std::abs(nextPhi - phi) < 1.e-14;
+            phi = nextPhi;
+            if (converged)
+            {
+                break;
+            }
+        }
+        double lam = std::atan2(xp, yp) / params.n;
+
+        if (rho == 0.0)
+        {
+            lam = 0.0;
+            phi = params.n > 0.0 ? SimdMath::PIO2 : -SimdMath::PIO2;
+        }
+
+        lam += params.lon0;
+        lam -= TWO_PI * std::nearbyint(lam / TWO_PI);
+        x[i] = RAD2DEG * lam;
+        y[i] = RAD2DEG * phi;
+    }
+}
+
+const ConformalConicKernels &getScalarConformalConicKernels()
+{
+    static const ConformalConicKernels kernels{"scalar", forwardScalar, inverseScalar};
+    return kernels;
+}
+
+const ConformalConicKernels &getConformalConicKernels()
+{
+    static const ConformalConicKernels *kernels = []() {
+        const ConformalConicKernels *selected = &getScalarConformalConicKernels();
+#ifdef MET3D_CONFORMAL_CONIC_KERNELS_X86
+        if (cpuSupportsAvx2())
+        {
+            selected = &getAvx2ConformalConicKernels();
+        }
+        else if (cpuSupportsSse4())
+        {
+            selected = &getSse4ConformalConicKernels();
+        }
+#endif
+        LOG_DEBUG("Using {} kernels for conformal conic projections", selected->name)
+        return selected;
+    }();
+    return *kernels;
+}
+
+} // namespace Met3D
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file ConformalConicKernels.h
+/// \brief This file declares closed-form batch kernels for the polar stereographic and Lambert conformal conic
+/// projections used by GeometryHandling.
+///
+/// Both projections are conformal conic projections in the sense of Snyder (1987), "Map Projections - A Working
+/// Manual", USGS Professional Paper 1395: the polar stereographic projection is the limiting case of the Lambert
+/// conformal conic projection with a cone constant of 1. They are therefore implemented by a single pair of forward and
+/// inverse kernels that only differ in their parameters. The parameters are derived from a proj string in the same way
+/// as the proj library does, so that the kernels can replace proj for the supported definitions.
+///
+/// A scalar reference implementation is always available, SSE4.1 and AVX2 implementations are selected at runtime if
+/// the CPU supports them.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CpuFeatures.h"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace Met3D
+{
+
+///
+/// \struct ConformalConicParameters
+/// \brief Constants of a polar stereographic or Lambert conformal conic projection.
+///
+/// With the isometric colatitude function t(phi) = tan(pi/4 - phi/2) * ((1 + e sin phi) / (1 - e sin phi))^(e/2), a
+/// point (lon, lat) is mapped to rho = c * t(lat)^n, theta = n * (lon - lon0) and
+/// (x, y) = (x0 + rho sin theta, y0 + rho0 - rho cos theta).
+///
+struct ConformalConicParameters
+{
+    ///
+    /// \brief Derives the parameters from a proj string.
+    ///
+    /// Supported are +proj=stere with lat_0 = 90 (optionally with lat_ts) or lat_0 = -90, and +proj=lcc with one or
+    /// two standard parallels, on the WGS84 and GRS80 ellipsoids or a sphere, in metres. Returns std::nullopt for all
+    /// other definitions, including parameters that are not known to the parser, so that these are handled by proj.
+    ///
+    static std::optional<ConformalConicParameters> fromProjString(const std::string &projString);
+
+    // First eccentricity of the ellipsoid, 0 for a sphere.
+    double e{0.0};
+    // Central meridian in radians.
+    double lon0{0.0};
+    // Cone constant, 1 for the north polar and -1 for the south polar stereographic projection.
+    double n{1.0};
+    // Scale of rho in metres, includes the semi-major axis and the scale factor.
+    double c{0.0};
+    // Radius of the parallel through the origin in metres.
+    double rho0{0.0};
+    // False easting and northing in metres.
+    double x0{0.0};
+    double y0{0.0};
+};
+
+///
+/// \brief Signature of a conformal conic kernel.
+///
+/// Transforms numPoints points given by (x[i], y[i]) in place. Geographical coordinates are longitudes and latitudes in
+/// degrees, projected coordinates are in metres. Points that cannot be transformed, i.e. the pole opposite to the apex
+/// of the cone, are set to NaN.
+///
+using ConformalConicKernel = void (*)(const ConformalConicParameters &params, double *x, double *y, size_t numPoints);
+
+///
+/// \struct ConformalConicKernels
+/// \brief Set of kernels for one instruction set.
+///
+struct ConformalConicKernels
+{
+    const char *name;
+    ConformalConicKernel forward;
+    ConformalConicKernel inverse;
+};
+
+///
+/// \brief Returns the scalar reference kernels, which use the C library functions.
+///
+const ConformalConicKernels &getScalarConformalConicKernels();
+
+///
+/// \brief Returns the fastest kernels supported by the CPU.
+///
+/// The CPU features are queried once on the first call. The SIMD kernels use the approximations in SimdMath.h and agree
+/// with the scalar reference to a few units in the last place, i.e. far below a millimetre.
+///
+const ConformalConicKernels &getConformalConicKernels();
+
+#ifdef MET3D_CPU_X86
+#define MET3D_CONFORMAL_CONIC_KERNELS_X86 1
+const ConformalConicKernels &getSse4ConformalConicKernels();
+const ConformalConicKernels &getAvx2ConformalConicKernels();
+#endif
+
+} // namespace Met3D
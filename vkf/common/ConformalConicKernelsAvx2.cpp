@@ -0,0 +1,34 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file ConformalConicKernelsAvx2.cpp
+/// \brief This file implements the AVX2 conformal conic kernels.
+///
+/// The file is compiled with AVX2 and FMA enabled (see vkf/CMakeLists.txt) and must not include headers with inline
+/// functions that are also used by other translation units, otherwise the linker might pick an AVX2 version of them.
+/// Four points are processed per iteration in double precision.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ConformalConicKernels.h"
+
+#ifdef MET3D_CONFORMAL_CONIC_KERNELS_X86
+
+#include "ConformalConicKernelsSimd.h"
+#include "SimdVectorAvx2.h"
+
+namespace Met3D
+{
+
+const ConformalConicKernels &getAvx2ConformalConicKernels()
+{
+    static const ConformalConicKernels kernels{"AVX2", forwardConformalConicSimd<VecD>,
+                                               inverseConformalConicSimd<VecD>};
+    return kernels;
+}
+
+} // namespace Met3D
+
+#endif
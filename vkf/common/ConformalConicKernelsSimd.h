@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file ConformalConicKernelsSimd.h
+/// \brief This file implements the conformal conic kernels as templates over a SIMD vector wrapper type.
+///
+/// The templates are only meant to be included by the ISA specific translation units (ConformalConicKernelsSse4.cpp
+/// and ConformalConicKernelsAvx2.cpp). Besides the functions required by SimdMath.h, the vector type V has to provide
+/// the lane count V::width and V::load and V::store for double arrays. The computations mirror the scalar reference
+/// kernels in ConformalConicKernels.cpp, except that the latitude iteration of the inverse runs a fixed number of
+/// times.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ConformalConicKernels.h"
+#include "SimdMath.h"
+
+namespace Met3D
+{
+
+namespace ConformalConicSimd
+{
+
+constexpr double DEG2RAD = SimdMath::PI / 180.0;
+constexpr double RAD2DEG = 180.0 / SimdMath::PI;
+constexpr double TWO_PI = 2.0 * SimdMath::PI;
+constexpr double EPS10 = 1.e-10;
+
+// The error of the latitude shrinks by a factor of about e^2 per iteration,
+// starting from less than 0.2 degrees. Seven iterations reach double precision
+// for all ellipsoids of the earth.
+constexpr int numLatitudeIterations = 7;
+
+template <class V> inline V wrapAngle(V angle)
+{
+    return angle - V{TWO_PI} * roundNearest(angle * V{1.0 / TWO_PI});
+}
+
+template <class V> inline void forwardBlock(const ConformalConicParameters &params, double *x, double *y)
+{
+    V lam = wrapAngle(V{DEG2RAD} * V::load(x) - V{params.lon0});
+    V phi = V{DEG2RAD} * V::load(y);
+
+    V sinPhi{0.0}, cosPhi{0.0};
+    SimdMath::sinCos(phi, &sinPhi, &cosPhi);
+
+    V northern = cmpGt(sinPhi, V{0.0});
+    V numerator = select(northern, cosPhi, V{1.0} - sinPhi);
+    V denominator = select(northern, V{1.0} + sinPhi, cosPhi);
+    V logT = SimdMath::log(numerator / denominator);
+    V eSinPhi = V{params.e} * sinPhi;
+    logT = fmadd(V{0.5 * params.e}, SimdMath::log((V{1.0} + eSinPhi) / (V{1.0} - eSinPhi)), logT);
+
+    V rho = V{params.c} * SimdMath::exp(V{params.n} * logT);
+    V atPole = cmpLt(abs(abs(phi) - V{SimdMath::PIO2}), V{EPS10});
+    V poleRho = select(cmpGt(phi * V{params.n}, V{0.0}), V{0.0}, V{std::numeric_limits<double>::quiet_NaN()});
+    rho = select(atPole, poleRho, rho);
+
+    V sinTheta{0.0}, cosTheta{0.0};
+    SimdMath::sinCos(V{params.n} * lam, &sinTheta, &cosTheta);
+    fmadd(rho, sinTheta, V{params.x0}).store(x);
+    (V{params.y0 + params.rho0} - rho * cosTheta).store(y);
+}
+
+template <class V> inline void inverseBlock(const ConformalConicParameters &params, double *x, double *y)
+{
+    V sign{params.n < 0.0 ? -1.0 : 1.0};
+    V xp = sign * (V::load(x) - V{params.x0});
+    V yp = sign * (V{params.rho0} - (V::load(y) - V{params.y0}));
+    V rho = sign * sqrt(xp * xp + yp * yp);
+
+    V t = SimdMath::exp(SimdMath::log(rho / V{params.c}) * V{1.0 / params.n});
+    V phi = V{SimdMath::PIO2} - V{2.0} * SimdMath::atan(t);
+    if (params.e > 0.0)
+    {
+        for (int iteration = 0; iteration < numLatitudeIterations; iteration++)
+        {
+            V sinPhi{0.0}, cosPhi{0.0};
+            SimdMath::sinCos(phi, &sinPhi, &cosPhi);
+            V eSinPhi = V{params.e} * sinPhi;
+            V conformalFactor =
+                SimdMath::exp(V{-0.5 * params.e} * SimdMath::log((V{1.0} + eSinPhi) / (V{1.0} - eSinPhi)));
+            phi = V{SimdMath::PIO2} - V{2.0} * SimdMath::atan(t * conformalFactor);
+        }
+    }
+    V lam = SimdMath::atan2(xp, yp) * V{1.0 / params.n};
+
+    // The logarithm of rho = 0 is NaN in SimdMath, so the apex of the cone is
+    // handled separately.
+    V atApex = cmpEq(rho, V{0.0});
+    lam = select(atApex, V{0.0}, lam);
+    phi = select(atApex, V{params.n > 0.0 ? SimdMath::PIO2 : -SimdMath::PIO2}, phi);
+
+    (V{RAD2DEG} * wrapAngle(lam + V{params.lon0})).store(x);
+    (V{RAD2DEG} * phi).store(y);
+}
+
+///
+/// \brief Runs a block kernel over all points, the remainder is processed in a zero padded block.
+///
+template <class V, void (*Block)(const ConformalConicParameters &, double *, double *)>
+inline void runBlocks(const ConformalConicParameters &params, double *x, double *y, size_t numPoints)
+{
+    size_t i = 0;
+    for (; i + V::width <= numPoints; i += V::width)
+    {
+        Block(params, x + i, y + i);
+    }
+
+    if (i < numPoints)
+    {
+        double blockX[V::width] = {};
+        double blockY[V::width] = {};
+        size_t remaining = numPoints - i;
+        for (size_t j = 0; j < remaining; j++)
+        {
+            blockX[j] = x[i + j];
+            blockY[j] = y[i + j];
+        }
+        Block(params, blockX, blockY);
+        for (size_t j = 0; j < remaining; j++)
+        {
+            x[i + j] = blockX[j];
+            y[i + j] = blockY[j];
+        }
+    }
+}
+
+} // namespace ConformalConicSimd
+
+template <class V>
+void forwardConformalConicSimd(const ConformalConicParameters &params, double *x, double *y, size_t numPoints)
+{
+    ConformalConicSimd::runBlocks<V, ConformalConicSimd::forwardBlock<V>>(params, x, y, numPoints);
+}
+
+template <class V>
+void inverseConformalConicSimd(const ConformalConicParameters &params, double *x, double *y, size_t numPoints)
+{
+    ConformalConicSimd::runBlocks<V, ConformalConicSimd::inverseBlock<V>>(params, x, y, numPoints);
+}
+
+} // namespace Met3D
@@ -0,0 +1,34 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file ConformalConicKernelsSse4.cpp
+/// \brief This file implements the SSE4.1 conformal conic kernels.
+///
+/// The file is compiled with SSE4.1 enabled (see vkf/CMakeLists.txt) and must not include headers with inline
+/// functions that are also used by other translation units, otherwise the linker might pick an SSE4.1 version of them.
+/// Two points are processed per iteration in double precision.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ConformalConicKernels.h"
+
+#ifdef MET3D_CONFORMAL_CONIC_KERNELS_X86
+
+#include "ConformalConicKernelsSimd.h"
+#include "SimdVectorSse4.h"
+
+namespace Met3D
+{
+
+const ConformalConicKernels &getSse4ConformalConicKernels()
+{
+    static const ConformalConicKernels kernels{"SSE4.1", forwardConformalConicSimd<VecD>,
+                                               inverseConformalConicSimd<VecD>};
+    return kernels;
+}
+
+} // namespace Met3D
+
+#endif
@@ -0,0 +1,31 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file CpuFeatures.h
+/// \brief This file declares the queries of the instruction sets used by the SIMD geometry kernels.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MET3D_CPU_X86 1
+
+namespace Met3D
+{
+
+///
+/// \brief Returns whether the CPU supports SSE4.1.
+///
+bool cpuSupportsSse4();
+
+///
+/// \brief Returns whether the CPU and the OS support AVX2 and FMA.
+///
+bool cpuSupportsAvx2();
+
+} // namespace Met3D
+
+#endif
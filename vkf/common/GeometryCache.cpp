@@ -0,0 +1,502 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file GeometryCache.cpp
+/// \brief This file implements the GeometryCache class, a binary on-disk cache for the polylines of shapefiles.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GeometryCache.h"
+#include "GeometryHandling.h"
+#include "Log.h"
+#include "PolygonTriangulation.h"
+#include "PolylineSet.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+
+namespace Met3D
+{
+
+namespace
+{
+
+// Layout of a cache file: the header is followed by the x coordinates, the y coordinates, the polyline offsets and
+// the polyline bounding boxes. All arrays have 4 byte elements, so they are naturally aligned in the mapping.
+constexpr char cacheFileMagic[8] = {'V', 'K', 'F', 'G', 'E', 'O', 'M', '\0'};
+constexpr uint32_t cacheFileVersion = 2;
+
+struct CacheFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t sourcePathHash;
+    uint64_t sourceSize;
+    int64_t sourceModificationTime;
+    uint64_t numPolylines;
+    uint64_t numVertices;
+};
+
+static_assert(std::is_trivially_copyable_v<CacheFileHeader>);
+static_assert(sizeof(CacheFileHeader) % 4 == 0);
+
+size_t getCacheFileSize(uint64_t numPolylines, uint64_t numVertices)
+{
+    return sizeof(CacheFileHeader) + 2 * numVertices * sizeof(float) + (numPolylines + 1) * sizeof(uint32_t) +
+           numPolylines * sizeof(PolylineBounds);
+}
+
+// Layout of a triangulation cache file: the header is followed by the x coordinates, the y coordinates and the
+// triangle indices.
+constexpr char triangulationFileMagic[8] = {'V', 'K', 'F', 'T', 'R', 'I', 'S', '\0'};
+constexpr uint32_t triangulationFileVersion = 2;
+
+struct TriangulationFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t sourcePathHash;
+    uint64_t sourceSize;
+    int64_t sourceModificationTime;
+    uint64_t numVertices;
+    uint64_t numIndices;
+};
+
+static_assert(std::is_trivially_copyable_v<TriangulationFileHeader>);
+static_assert(sizeof(TriangulationFileHeader) % 4 == 0);
+
+size_t getTriangulationFileSize(uint64_t numVertices, uint64_t numIndices)
+{
+    return sizeof(TriangulationFileHeader) + 2 * numVertices * sizeof(float) + numIndices * sizeof(uint32_t);
+}
+
+// FNV-1a, used instead of std::hash because the cache file names have to be stable across builds.
+uint64_t hashString(const std::string &string)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : string)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Writes a file through a temporary file, so that a concurrent or interrupted run never maps a partial file.
+bool writeFileAtomically(const std::filesystem::path &path, const std::function<void(std::ofstream &stream)> &write)
+{
+    std::error_code error;
+    std::filesystem::path temporaryPath = path;
+    temporaryPath += ".tmp";
+    {
+        std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!stream)
+        {
+            return false;
+        }
+        write(stream);
+        if (!stream)
+        {
+            stream.close();
+            std::filesystem::remove(temporaryPath, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error)
+    {
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    return true;
+}
+
+// Maps path if it exists. Returns nullptr if the file cannot be mapped or is smaller than a header of headerSize.
+std::unique_ptr<vkf::MappedFile> mapFile(const std::filesystem::path &path, size_t headerSize)
+{
+    std::error_code error;
+    if (!std::filesystem::exists(path, error))
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<vkf::MappedFile> file;
+    try
+    {
+        file = std::make_unique<vkf::MappedFile>(path);
+    }
+    catch (const std::runtime_error &e)
+    {
+        LOG_WARN("Cannot map geometry cache file: {}", e.what())
+        return nullptr;
+    }
+
+    if (file->getSize() < headerSize)
+    {
+        return nullptr;
+    }
+    return file;
+}
+
+} // namespace
+
+CachedGeometry::CachedGeometry(std::unique_ptr<vkf::MappedFile> file, size_t numPolylines, size_t numVertices)
+    : file{std::move(file)}, numPolylines{numPolylines}, numVertices{numVertices}
+{
+    const std::byte *data = this->file->getData() + sizeof(CacheFileHeader);
+    x = reinterpret_cast<const float *>(data);
+    y = x + numVertices;
+    offsets = reinterpret_cast<const uint32_t *>(y + numVertices);
+    bounds = reinterpret_cast<const PolylineBounds *>(offsets + numPolylines + 1);
+    index = PolylineIndex(bounds, numPolylines);
+}
+
+void CachedGeometry::appendPolylinesIntersecting(const RectF &bbox, PolylineSet *polylines) const
+{
+    std::vector<uint32_t> candidates;
+    index.query(bbox, &candidates);
+    for (uint32_t i : candidates)
+    {
+        polylines->appendPolyline(x + offsets[i], y + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+}
+
+size_t CachedGeometry::getNumPolylines() const
+{
+    return numPolylines;
+}
+
+size_t CachedGeometry::getNumVertices() const
+{
+    return numVertices;
+}
+
+const float *CachedGeometry::getX() const
+{
+    return x;
+}
+
+const float *CachedGeometry::getY() const
+{
+    return y;
+}
+
+const uint32_t *CachedGeometry::getOffsets() const
+{
+    return offsets;
+}
+
+const PolylineBounds *CachedGeometry::getBounds() const
+{
+    return bounds;
+}
+
+const PolylineIndex &CachedGeometry::getIndex() const
+{
+    return index;
+}
+
+CachedTriangulation::CachedTriangulation(std::unique_ptr<vkf::MappedFile> file, size_t numVertices, size_t numIndices)
+    : file{std::move(file)}, numVertices{numVertices}, numIndices{numIndices}
+{
+    const std::byte *data = this->file->getData() + sizeof(TriangulationFileHeader);
+    x = reinterpret_cast<const float *>(data);
+    y = x + numVertices;
+    indices = reinterpret_cast<const uint32_t *>(y + numVertices);
+}
+
+size_t CachedTriangulation::getNumVertices() const
+{
+    return numVertices;
+}
+
+size_t CachedTriangulation::getNumIndices() const
+{
+    return numIndices;
+}
+
+const float *CachedTriangulation::getX() const
+{
+    return x;
+}
+
+const float *CachedTriangulation::getY() const
+{
+    return y;
+}
+
+const uint32_t *CachedTriangulation::getIndices() const
+{
+    return indices;
+}
+
+GeometryCache::GeometryCache(std::filesystem::path cacheDirectory) : cacheDirectory{std::move(cacheDirectory)}
+{
+}
+
+std::shared_ptr<const CachedGeometry> GeometryCache::getGeometry(const std::string &sourcePath,
+                                                                 const SourceLoader &loadSource)
+{
+    std::string normalizedSourcePath;
+    SourceKey key;
+    if (!getSourceKey(sourcePath, &normalizedSourcePath, &key))
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Warm path: the file is already mapped and the source has not changed.
+    auto it = entries.find(normalizedSourcePath);
+    if (it != entries.end() && it->second.key == key)
+    {
+        return it->second.geometry;
+    }
+
+    // Map an existing cache file, e.g. one written by a previous run.
+    std::filesystem::path cacheFilePath = getCacheFilePath(normalizedSourcePath, key, ".geocache");
+    std::shared_ptr<const CachedGeometry> geometry = mapCacheFile(cacheFilePath, key);
+
+    if (!geometry)
+    {
+        // Outdated mappings are released before their file is replaced. Views that are still in use keep theirs.
+        entries.erase(normalizedSourcePath);
+
+        LOG_DEBUG("Building geometry cache file {} for {}...", cacheFilePath.string(), normalizedSourcePath)
+
+        PolylineSet polylines;
+        if (!loadSource(&polylines))
+        {
+            return nullptr;
+        }
+        if (!writeCacheFile(cacheFilePath, key, polylines))
+        {
+            LOG_WARN("Cannot write geometry cache file {}.", cacheFilePath.string())
+            return nullptr;
+        }
+        geometry = mapCacheFile(cacheFilePath, key);
+    }
+
+    if (geometry)
+    {
+        entries[normalizedSourcePath] = Entry{key, geometry};
+    }
+    return geometry;
+}
+
+std::shared_ptr<const CachedTriangulation> GeometryCache::getTriangulation(const std::string &sourcePath,
+                                                                         const TriangulationLoader &loadSource)
+{
+    std::string normalizedSourcePath;
+    SourceKey key;
+    if (!getSourceKey(sourcePath, &normalizedSourcePath, &key))
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = triangulationEntries.find(normalizedSourcePath);
+    if (it != triangulationEntries.end() && it->second.key == key)
+    {
+        return it->second.triangulation;
+    }
+
+    std::filesystem::path cacheFilePath = getCacheFilePath(normalizedSourcePath, key, ".tricache");
+    std::shared_ptr<const CachedTriangulation> triangulation = mapTriangulationFile(cacheFilePath, key);
+
+    if (!triangulation)
+    {
+        triangulationEntries.erase(normalizedSourcePath);
+
+        LOG_DEBUG("Building triangulation cache file {} for {}...", cacheFilePath.string(), normalizedSourcePath)
+
+        TriangleMesh mesh;
+        if (!loadSource(&mesh))
+        {
+            return nullptr;
+        }
+        if (!writeTriangulationFile(cacheFilePath, key, mesh))
+        {
+            LOG_WARN("Cannot write triangulation cache file {}.", cacheFilePath.string())
+            return nullptr;
+        }
+        triangulation = mapTriangulationFile(cacheFilePath, key);
+    }
+
+    if (triangulation)
+    {
+        triangulationEntries[normalizedSourcePath] = TriangulationEntry{key, triangulation};
+    }
+    return triangulation;
+}
+
+GeometryCache &GeometryCache::getShared()
+{
+    static GeometryCache cache{std::filesystem::path(PROJECT_BUILD_DIR) / "geometry_cache"};
+    return cache;
+}
+
+bool GeometryCache::getSourceKey(const std::string &sourcePath, std::string *normalizedSourcePath, SourceKey *key)
+{
+    std::error_code error;
+    std::filesystem::path absoluteSourcePath = std::filesystem::absolute(sourcePath, error).lexically_normal();
+    *normalizedSourcePath = absoluteSourcePath.generic_string();
+
+    key->pathHash = hashString(*normalizedSourcePath);
+    key->size = std::filesystem::file_size(absoluteSourcePath, error);
+    if (error)
+    {
+        return false;
+    }
+    key->modificationTime = std::filesystem::last_write_time(absoluteSourcePath, error).time_since_epoch().count();
+    return !error;
+}
+
+std::filesystem::path GeometryCache::getCacheFilePath(const std::string &sourcePath, const SourceKey &key,
+                                                      const std::string &extension) const
+{
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(key.pathHash));
+    return cacheDirectory /
+           (std::filesystem::path(sourcePath).stem().string() + "_" + std::string(hash) + extension);
+}
+
+std::shared_ptr<const CachedGeometry> GeometryCache::mapCacheFile(const std::filesystem::path &cacheFilePath,
+                                                                  const SourceKey &key) const
+{
+    std::unique_ptr<vkf::MappedFile> file = mapFile(cacheFilePath, sizeof(CacheFileHeader));
+    if (!file)
+    {
+        return nullptr;
+    }
+
+    // Files of another version or of an outdated source are rebuilt.
+    CacheFileHeader header;
+    std::memcpy(&header, file->getData(), sizeof(header));
+    if (std::memcmp(header.magic, cacheFileMagic, sizeof(cacheFileMagic)) != 0 ||
+        header.version != cacheFileVersion || header.headerSize != sizeof(CacheFileHeader) ||
+        header.sourcePathHash != key.pathHash || header.sourceSize != key.size ||
+        header.sourceModificationTime != key.modificationTime ||
+        file->getSize() != getCacheFileSize(header.numPolylines, header.numVertices))
+    {
+        return nullptr;
+    }
+
+    return std::make_shared<const CachedGeometry>(std::move(file), header.numPolylines, header.numVertices);
+}
+
+bool GeometryCache::writeCacheFile(const std::filesystem::path &cacheFilePath, const SourceKey &key,
+                                   const PolylineSet &polylines) const
+{
+    if (polylines.getNumVertices() > std::numeric_limits<uint32_t>::max())
+    {
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(cacheDirectory, error);
+    if (error)
+    {
+        return false;
+    }
+
+    CacheFileHeader header{};
+    std::memcpy(header.magic, cacheFileMagic, sizeof(cacheFileMagic));
+    header.version = cacheFileVersion;
+    header.headerSize = sizeof(CacheFileHeader);
+    header.sourcePathHash = key.pathHash;
+    header.sourceSize = key.size;
+    header.sourceModificationTime = key.modificationTime;
+    header.numPolylines = polylines.getNumPolylines();
+    header.numVertices = polylines.getNumVertices();
+
+    std::vector<PolylineBounds> bounds(polylines.getNumPolylines());
+    for (size_t i = 0; i < polylines.getNumPolylines(); i++)
+    {
+        uint32_t begin = polylines.getPolylineBegin(i);
+        bounds[i] = PolylineIndex::computeBounds(polylines.getX() + begin, polylines.getY() + begin,
+                                                 polylines.getPolylineSize(i));
+    }
+
+    return writeFileAtomically(cacheFilePath, [&](std::ofstream &stream) {
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char *>(polylines.getX()),
+                     static_cast<std::streamsize>(polylines.getNumVertices() * sizeof(float)));
+        stream.write(reinterpret_cast<const char *>(polylines.getY()),
+                     static_cast<std::streamsize>(polylines.getNumVertices() * sizeof(float)));
+        stream.write(reinterpret_cast<const char *>(polylines.getOffsets().data()),
+                     static_cast<std::streamsize>(polylines.getOffsets().size() * sizeof(uint32_t)));
+        stream.write(reinterpret_cast<const char *>(bounds.data()),
+                     static_cast<std::streamsize>(bounds.size() * sizeof(PolylineBounds)));
+    });
+}
+
+std::shared_ptr<const CachedTriangulation> GeometryCache::mapTriangulationFile(
+    const std::filesystem::path &cacheFilePath, const SourceKey &key) const
+{
+    std::unique_ptr<vkf::MappedFile> file = mapFile(cacheFilePath, sizeof(TriangulationFileHeader));
+    if (!file)
+    {
+        return nullptr;
+    }
+
+    TriangulationFileHeader header;
+    std::memcpy(&header, file->getData(), sizeof(header));
+    if (std::memcmp(header.magic, triangulationFileMagic, sizeof(triangulationFileMagic)) != 0 ||
+        header.version != triangulationFileVersion || header.headerSize != sizeof(TriangulationFileHeader) ||
+        header.sourcePathHash != key.pathHash || header.sourceSize != key.size ||
+        header.sourceModificationTime != key.modificationTime ||
+        file->getSize() != getTriangulationFileSize(header.numVertices, header.numIndices))
+    {
+        return nullptr;
+    }
+
+    return std::make_shared<const CachedTriangulation>(std::move(file), header.numVertices, header.numIndices);
+}
+
+bool GeometryCache::writeTriangulationFile(const std::filesystem::path &cacheFilePath, const SourceKey &key,
+                                           const TriangleMesh &mesh) const
+{
+    if (mesh.getNumVertices() > std::numeric_limits<uint32_t>::max())
+    {
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(cacheDirectory, error);
+    if (error)
+    {
+        return false;
+    }
+
+    TriangulationFileHeader header{};
+    std::memcpy(header.magic, triangulationFileMagic, sizeof(triangulationFileMagic));
+    header.version = triangulationFileVersion;
+    header.headerSize = sizeof(TriangulationFileHeader);
+    header.sourcePathHash = key.pathHash;
+    header.sourceSize = key.size;
+    header.sourceModificationTime = key.modificationTime;
+    header.numVertices = mesh.getNumVertices();
+    header.numIndices = mesh.indices.size();
+
+    return writeFileAtomically(cacheFilePath, [&](std::ofstream &stream) {
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char *>(mesh.x.data()),
+                     static_cast<std::streamsize>(mesh.x.size() * sizeof(float)));
+        stream.write(reinterpret_cast<const char *>(mesh.y.data()),
+                     static_cast<std::streamsize>(mesh.y.size() * sizeof(float)));
+        stream.write(reinterpret_cast<const char *>(mesh.indices.data()),
+                     static_cast<std::streamsize>(mesh.indices.size() * sizeof(uint32_t)));
+    });
+}
+
+} // namespace Met3D
@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file GeometryCache.h
+/// \brief This file declares the GeometryCache class, a binary on-disk cache for the polylines of shapefiles.
+///
+/// Parsing a shapefile with OGR visits every feature and line string object. The geometry cache stores the polylines
+/// of a shapefile once in a flat binary file next to the build, which is memory-mapped on later loads. Cache files are
+/// keyed by the path, size and modification time of their source file and are rebuilt when the source changes.
+///
+/// Triangulations of the polygons of a shapefile are cached in the same way, in separate files, so that filled
+/// polygons are only triangulated once.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "MappedFile.h"
+#include "PolylineIndex.h"
+
+namespace Met3D
+{
+
+class PolylineSet;
+struct RectF;
+struct TriangleMesh;
+
+///
+/// \class CachedGeometry
+/// \brief Read-only view of the polylines stored in a mapped cache file.
+///
+/// The arrays have the same layout as the arrays of a PolylineSet. They point into the mapping and stay valid for the
+/// lifetime of the object, also if the cache entry is rebuilt in the meantime. A spatial index over the stored bounding
+/// boxes is built once when the file is mapped.
+///
+class CachedGeometry
+{
+  public:
+    CachedGeometry(std::unique_ptr<vkf::MappedFile> file, size_t numPolylines, size_t numVertices);
+
+    ///
+    /// \brief Appends all polylines whose bounding box intersects bbox to polylines. The order of the polylines is
+    /// preserved. As in GeometryHandling, bbox.top is the lower and bbox.bottom the upper y limit.
+    ///
+    void appendPolylinesIntersecting(const RectF &bbox, PolylineSet *polylines) const;
+
+    [[nodiscard]] size_t getNumPolylines() const;
+    [[nodiscard]] size_t getNumVertices() const;
+    [[nodiscard]] const float *getX() const;
+    [[nodiscard]] const float *getY() const;
+    [[nodiscard]] const uint32_t *getOffsets() const;
+    [[nodiscard]] const PolylineBounds *getBounds() const;
+    [[nodiscard]] const PolylineIndex &getIndex() const;
+
+  private:
+    std::unique_ptr<vkf::MappedFile> file;
+    size_t numPolylines;
+    size_t numVertices;
+    const float *x;
+    const float *y;
+    const uint32_t *offsets;
+    const PolylineBounds *bounds;
+    PolylineIndex index;
+};
+
+///
+/// \class CachedTriangulation
+/// \brief Read-only view of the triangle mesh stored in a mapped cache file.
+///
+/// The arrays have the same layout as the arrays of a TriangleMesh and stay valid for the lifetime of the object.
+///
+class CachedTriangulation
+{
+  public:
+    CachedTriangulation(std::unique_ptr<vkf::MappedFile> file, size_t numVertices, size_t numIndices);
+
+    [[nodiscard]] size_t getNumVertices() const;
+    [[nodiscard]] size_t getNumIndices() const;
+    [[nodiscard]] const float *getX() const;
+    [[nodiscard]] const float *getY() const;
+    [[nodiscard]] const uint32_t *getIndices() const;
+
+  private:
+    std::unique_ptr<vkf::MappedFile> file;
+    size_t numVertices;
+    size_t numIndices;
+    const float *x;
+    const float *y;
+    const uint32_t *indices;
+};
+
+///
+/// \class GeometryCache
+/// \brief Builds, validates and maps the cache files of a cache directory.
+///
+/// Mapped entries are kept for the lifetime of the cache, so that repeated loads of the same file only check the size
+/// and modification time of the source. All methods may be called from several threads.
+///
+class GeometryCache
+{
+  public:
+    ///
+    /// \brief Callback that reads all polylines of the source file. Returns false if the source cannot be read.
+    ///
+    using SourceLoader = std::function<bool(PolylineSet *polylines)>;
+
+    ///
+    /// \brief Callback that reads and triangulates all polygons of the source file. Returns false if the source cannot
+    /// be read.
+    ///
+    using TriangulationLoader = std::function<bool(TriangleMesh *mesh)>;
+
+    explicit GeometryCache(std::filesystem::path cacheDirectory);
+
+    ///
+    /// \brief Returns the cached geometry of sourcePath.
+    ///
+    /// If there is no valid cache file, the geometry is read with loadSource, written to the cache directory and
+    /// mapped. Returns nullptr if the source cannot be read or the cache file cannot be written, the caller then has
+    /// to read the source itself.
+    ///
+    std::shared_ptr<const CachedGeometry> getGeometry(const std::string &sourcePath, const SourceLoader &loadSource);
+
+    ///
+    /// \brief Returns the cached triangulation of the polygons of sourcePath.
+    ///
+    /// Behaves like getGeometry(), the triangulation is built with loadSource if there is no valid cache file.
+    ///
+    std::shared_ptr<const CachedTriangulation> getTriangulation(const std::string &sourcePath,
+                                                                const TriangulationLoader &loadSource);
+
+    ///
+    /// \brief Returns the cache shared by the whole application, which stores its files in the build directory.
+    ///
+    static GeometryCache &getShared();
+
+  private:
+    // Identifies the version of a source file a cache file was built from.
+    struct SourceKey
+    {
+        uint64_t pathHash{0};
+        uint64_t size{0};
+        int64_t modificationTime{0};
+
+        bool operator==(const SourceKey &other) const = default;
+    };
+
+    struct Entry
+    {
+        SourceKey key;
+        std::shared_ptr<const CachedGeometry> geometry;
+    };
+
+    struct TriangulationEntry
+    {
+        SourceKey key;
+        std::shared_ptr<const CachedTriangulation> triangulation;
+    };
+
+    static bool getSourceKey(const std::string &sourcePath, std::string *normalizedSourcePath, SourceKey *key);
+    std::filesystem::path getCacheFilePath(const std::string &sourcePath, const SourceKey &key,
+                                           const std::string &extension) const;
+    std::shared_ptr<const CachedGeometry> mapCacheFile(const std::filesystem::path &cacheFilePath,
+                                                       const SourceKey &key) const;
+    bool writeCacheFile(const std::filesystem::path &cacheFilePath, const SourceKey &key,
+                        const PolylineSet &polylines) const;
+    std::shared_ptr<const CachedTriangulation> mapTriangulationFile(const std::filesystem::path &cacheFilePath,
+                                                                    const SourceKey &key) const;
+    bool writeTriangulationFile(const std::filesystem::path &cacheFilePath, const SourceKey &key,
+                                const TriangleMesh &mesh) const;
+
+    std::filesystem::path cacheDirectory;
+    std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+    std::unordered_map<std::string, TriangulationEntry> triangulationEntries;
+};
+
+} // namespace Met3D
@@ -25,12 +25,16 @@
 **
 *******************************************************************************/
 #include "GeometryHandling.h"
+#include "GeometryCache.h"
 #include "Log.h"
+#include "RotatedPoleKernels.h"
 #include "Utility.h"
 
 // standard library imports
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <regex>
 
 using namespace std;
@@ -38,14 +42,22 @@ using namespace std;
 namespace Met3D
 {
 
+// The closed-form kernels replace proj only if vkf is built with the CMake
+// option VKF_CLOSED_FORM_PROJECTIONS, proj stays the reference.
+#ifdef MET3D_CLOSED_FORM_PROJECTIONS
+constexpr bool closedFormProjectionsEnabledByDefault = true;
+#else
+constexpr bool closedFormProjectionsEnabledByDefault = false;
+#endif
+
 /******************************************************************************
 ***                     CONSTRUCTOR / DESTRUCTOR                            ***
 *******************************************************************************/
 
-GeometryHandling::GeometryHandling()
-    : pjSrcDstTransformation(nullptr), pjDstSrcTransformation(nullptr), srcUseScaleFactorForProjection(true),
-      dstUseScaleFactorForProjection(true), srcConnectionFunc(nullptr), dstConnectionFunc(nullptr),
-      rotatedPole(PointF(0., 90.))
+GeometryHandling::GeometryHandling(PJ_CONTEXT *projContext)
+    : projContext(projContext), pjSrcDstTransformation(nullptr), pjDstSrcTransformation(nullptr),
+      srcUseScaleFactorForProjection(true), dstUseScaleFactorForProjection(true),
+      closedFormProjectionsEnabled(closedFormProjectionsEnabledByDefault), rotatedPole(PointF(0., 90.))
 {
 }
 
@@ -62,12 +74,18 @@ std::vector<std::vector<PointF>> GeometryHandling::generate2DGraticuleGeometry(s
                                                                                std::vector<float> &latitudes,
                                                                                Vector2D lonLatVertexSpacing)
 {
-    std::vector<std::vector<PointF>> graticuleGeometry;
+    PolylineSet graticuleGeometry{&polylineMemory};
+    generate2DGraticuleGeometry(longitudes, latitudes, lonLatVertexSpacing, &graticuleGeometry);
+    return graticuleGeometry.toPolygons();
+}
 
+void GeometryHandling::generate2DGraticuleGeometry(std::vector<float> &longitudes, std::vector<float> &latitudes,
+                                                   Vector2D lonLatVertexSpacing, PolylineSet *graticuleGeometry)
+{
     // Non-empty lists of lons and lats are required.
     if (longitudes.empty() || latitudes.empty())
     {
-        return graticuleGeometry;
+        return;
     }
     // Positive vertex spacing is required.
     if (lonLatVertexSpacing.x <= 0.)
@@ -84,12 +102,11 @@ std::vector<std::vector<PointF>> GeometryHandling::generate2DGraticuleGeometry(s
     {
         for (float lon : longitudes)
         {
-            std::vector<PointF> meridian;
+            graticuleGeometry->beginPolyline();
             for (float lat = latitudes.front(); lat <= latitudes.back(); lat += lonLatVertexSpacing.y)
             {
-                meridian.emplace_back(PointF(lon, lat));
+                graticuleGeometry->appendVertex(lon, lat);
             }
-            graticuleGeometry.emplace_back(meridian);
         }
     }
 
@@ -98,23 +115,124 @@ std::vector<std::vector<PointF>> GeometryHandling::generate2DGraticuleGeometry(s
     {
         for (float lat : latitudes)
         {
-            std::vector<PointF> parallel;
+            graticuleGeometry->beginPolyline();
             for (float lon = longitudes.front(); lon <= longitudes.back(); lon += lonLatVertexSpacing.x)
             {
-                parallel.emplace_back(PointF(lon, lat));
+                graticuleGeometry->appendVertex(lon, lat);
             }
-            graticuleGeometry.emplace_back(parallel);
         }
     }
-
-    return graticuleGeometry;
 }
 
 std::vector<std::vector<PointF>> GeometryHandling::read2DGeometryFromShapefile(std::string fname, RectF bbox)
 {
-    LOG_DEBUG("Loading shapefile geometry from file {}...", fname);
+    PolylineSet polylines{&polylineMemory};
+    read2DGeometryFromShapefile(fname, bbox, &polylines);
+    return polylines.toPolygons();
+}
+
+bool GeometryHandling::read2DGeometryFromShapefile(const std::string &fname, RectF bbox, PolylineSet *polylines)
+{
+    // The cache stores all line strings of the shapefile, the bounding box is
+    // applied when the polylines are copied out of the mapped cache file.
+    std::shared_ptr<const CachedGeometry> cachedGeometry = GeometryCache::getShared().getGeometry(
+        fname, [&](PolylineSet *allPolylines) { return readShapefileWithOGR(fname, nullptr, allPolylines); });
+
+    if (cachedGeometry)
+    {
+        cachedGeometry->appendPolylinesIntersecting(bbox, polylines);
+        LOG_DEBUG("Geometry from shapefile {} has been loaded from the geometry cache", fname);
+        return true;
+    }
+
+    // Fall back to reading the shapefile directly, e.g. if the cache
+    // directory is not writable.
+    return readShapefileWithOGR(fname, &bbox, polylines);
+}
+
+bool GeometryHandling::cacheShapefile(const std::string &fname)
+{
+    std::shared_ptr<const CachedGeometry> cachedGeometry = GeometryCache::getShared().getGeometry(
+        fname, [&](PolylineSet *allPolylines) { return readShapefileWithOGR(fname, nullptr, allPolylines); });
+    return cachedGeometry != nullptr;
+}
+
+bool GeometryHandling::read2DPolygonsFromShapefile(const std::string &fname, TriangleMesh *mesh)
+{
+    mesh->clear();
+
+    std::shared_ptr<const CachedTriangulation> triangulation = GeometryCache::getShared().getTriangulation(
+        fname, [&](TriangleMesh *allPolygons) { return triangulateShapefileWithOGR(fname, allPolygons); });
+
+    if (triangulation)
+    {
+        mesh->x.assign(triangulation->getX(), triangulation->getX() + triangulation->getNumVertices());
+        mesh->y.assign(triangulation->getY(), triangulation->getY() + triangulation->getNumVertices());
+        mesh->indices.assign(triangulation->getIndices(),
+                             triangulation->getIndices() + triangulation->getNumIndices());
+        LOG_DEBUG("Polygons from shapefile {} have been loaded from the geometry cache", fname);
+        return true;
+    }
+
+    // Fall back to triangulating the shapefile directly, e.g. if the cache
+    // directory is not writable.
+    return triangulateShapefileWithOGR(fname, mesh);
+}
 
-    std::vector<std::vector<PointF>> polygons;
+bool GeometryHandling::read2DGeometryFromShapefileInChunks(const std::string &fname, RectF bbox,
+                                                           size_t maxVerticesPerChunk,
+                                                           const std::function<void(PolylineSet *chunk)> &processChunk)
+{
+    PolylineSet chunk{&polylineMemory};
+    auto appendToChunk = [&](const float *x, const float *y, size_t numPoints) {
+        if (!chunk.empty() && chunk.getNumVertices() + numPoints > maxVerticesPerChunk)
+        {
+            processChunk(&chunk);
+            chunk.clear();
+        }
+        chunk.appendPolyline(x, y, numPoints);
+    };
+
+    std::shared_ptr<const CachedGeometry> cachedGeometry = GeometryCache::getShared().getGeometry(
+        fname, [&](PolylineSet *allPolylines) { return readShapefileWithOGR(fname, nullptr, allPolylines); });
+
+    if (cachedGeometry)
+    {
+        // Copy the line strings chunk by chunk out of the mapped cache file.
+        const uint32_t *offsets = cachedGeometry->getOffsets();
+        std::vector<uint32_t> candidates;
+        cachedGeometry->getIndex().query(bbox, &candidates);
+        for (uint32_t i : candidates)
+        {
+            appendToChunk(cachedGeometry->getX() + offsets[i], cachedGeometry->getY() + offsets[i],
+                          offsets[i + 1] - offsets[i]);
+        }
+    }
+    else
+    {
+        // Without the cache, OGR has to read the entire shapefile first.
+        PolylineSet polylines{&polylineMemory};
+        if (!readShapefileWithOGR(fname, &bbox, &polylines))
+        {
+            return false;
+        }
+        for (size_t i = 0; i < polylines.getNumPolylines(); i++)
+        {
+            uint32_t begin = polylines.getPolylineBegin(i);
+            appendToChunk(polylines.getX() + begin, polylines.getY() + begin, polylines.getPolylineSize(i));
+        }
+    }
+
+    if (!chunk.empty())
+    {
+        processChunk(&chunk);
+    }
+    return true;
+}
+
+bool GeometryHandling::readShapefileWithOGR(const std::string &fname, RectF *bbox, PolylineSet *polylines)
+{
+    LOG_DEBUG("Loading shapefile geometry from file {}...", fname);
 
     // Open Shapefile.
     auto *gdalDataSet = (GDALDataset *)GDALOpenEx(fname.c_str(), GDAL_OF_VECTOR, NULL, NULL, NULL);
@@ -122,7 +240,7 @@ std::vector<std::vector<PointF>> GeometryHandling::read2DGeometryFromShapefile(s
     if (gdalDataSet == NULL)
     {
         LOG_ERROR("ERROR: cannot open shapefile {}.", fname);
-        return polygons;
+        return false;
     }
 
     // NaturalEarth shapefiles only contain one layer. (Do shapefiles in
@@ -132,11 +250,15 @@ std::vector<std::vector<PointF>> GeometryHandling::read2DGeometryFromShapefile(s
 
     // Filter the layer on-load: Only load those geometries that intersect
     // with the bounding box.
-    OGRPolygon *bboxPolygon = convertQRectToOGRPolygon(bbox);
-    layer->SetSpatialFilter(bboxPolygon);
+    OGRPolygon *bboxPolygon = nullptr;
+    if (bbox != nullptr)
+    {
+        bboxPolygon = convertQRectToOGRPolygon(*bbox);
+        layer->SetSpatialFilter(bboxPolygon);
+    }
 
     // Loop over all features contained in the layer, add all OGRLineStrings
-    // to our list of polygons.
+    // to our set of polylines.
     layer->ResetReading();
     OGRFeature *feature;
     while ((feature = layer->GetNextFeature()) != NULL)
@@ -145,22 +267,107 @@ std::vector<std::vector<PointF>> GeometryHandling::read2DGeometryFromShapefile(s
         // Get the geometry associated with the current feature.
         appendOGRLineStringsFromOGRGeometry(&lineStrings, feature->GetGeometryRef());
 
-        // Create QPolygons from the OGRLineStrings.
+        // Append the vertices of the OGRLineStrings.
         for (OGRLineString *lineString : lineStrings)
         {
-            polygons.emplace_back(convertOGRLineStringToQPolygon(lineString));
+            appendOGRLineStringToPolylineSet(lineString, polylines);
         }
 
         OGRFeature::DestroyFeature(feature);
     }
 
     // Clean up.
-    OGRGeometryFactory::destroyGeometry(bboxPolygon);
+    if (bboxPolygon != nullptr)
+    {
+        OGRGeometryFactory::destroyGeometry(bboxPolygon);
+    }
     GDALClose(gdalDataSet);
 
     LOG_DEBUG("Geometry from shapefile {} has been loaded", fname);
 
-    return polygons;
+    return true;
+}
+
+bool GeometryHandling::triangulateShapefileWithOGR(const std::string &fname, TriangleMesh *mesh)
+{
+    LOG_DEBUG("Triangulating shapefile polygons from file {}...", fname);
+
+    auto *gdalDataSet = (GDALDataset *)GDALOpenEx(fname.c_str(), GDAL_OF_VECTOR, NULL, NULL, NULL);
+
+    if (gdalDataSet == NULL)
+    {
+        LOG_ERROR("ERROR: cannot open shapefile {}.", fname);
+        return false;
+    }
+
+    OGRLayer *layer;
+    layer = gdalDataSet->GetLayer(0);
+
+    PolygonTriangulator triangulator;
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<uint32_t> ringOffsets;
+    auto triangulatePolygon = [&](OGRPolygon *polygon) {
+        x.clear();
+        y.clear();
+        ringOffsets.assign(1, 0);
+        // The exterior ring is followed by the holes.
+        for (int ring = -1; ring < polygon->getNumInteriorRings(); ring++)
+        {
+            OGRLinearRing *linearRing = ring < 0 ? polygon->getExteriorRing() : polygon->getInteriorRing(ring);
+            if (linearRing == NULL)
+            {
+                continue;
+            }
+            for (int i = 0; i < linearRing->getNumPoints(); i++)
+            {
+                x.push_back(linearRing->getX(i));
+                y.push_back(linearRing->getY(i));
+            }
+            ringOffsets.push_back(static_cast<uint32_t>(x.size()));
+        }
+        if (ringOffsets.size() > 1)
+        {
+            triangulator.triangulate(x.data(), y.data(), ringOffsets.data(), ringOffsets.size() - 1, mesh);
+        }
+    };
+
+    layer->ResetReading();
+    OGRFeature *feature;
+    while ((feature = layer->GetNextFeature()) != NULL)
+    {
+        OGRGeometry *geometry = feature->GetGeometryRef();
+        if (geometry != NULL)
+        {
+            OGRwkbGeometryType gType = wkbFlatten(geometry->getGeometryType());
+
+            if (gType == wkbPolygon)
+            {
+                triangulatePolygon((OGRPolygon *)geometry);
+            }
+            else if (gType == wkbMultiPolygon)
+            {
+                OGRGeometryCollection *gc = (OGRGeometryCollection *)geometry;
+                for (int g = 0; g < gc->getNumGeometries(); g++)
+                {
+                    triangulatePolygon((OGRPolygon *)gc->getGeometryRef(g));
+                }
+            }
+        }
+
+        OGRFeature::DestroyFeature(feature);
+    }
+
+    GDALClose(gdalDataSet);
+
+    // The triangles are reused in all projections, so they are refined before
+    // they are cached.
+    PolygonTriangulator::refineTriangles(mesh, maxTriangleEdgeLength_deg);
+    PolygonTriangulator::optimizeVertexCache(mesh);
+
+    LOG_DEBUG("Polygons from shapefile {} have been triangulated ({} triangles)", fname, mesh->getNumTriangles());
+
+    return true;
 }
 
 void GeometryHandling::initProjProjection(std::string projString)
@@ -180,20 +387,29 @@ void GeometryHandling::initProjProjection(std::string projString)
     destroyProjProjection();
 
     std::string srcProjString = "+proj=latlong +ellps=WGS84";
-    pjSrcDstTransformation = proj_create_crs_to_crs(PJ_DEFAULT_CTX, srcProjString.c_str(), projString.c_str(), NULL);
+    pjSrcDstTransformation = proj_create_crs_to_crs(projContext, srcProjString.c_str(), projString.c_str(), NULL);
 
     if (proj_errno(pjSrcDstTransformation))
     {
         LOG_ERROR("ERROR: cannot initialize proj with definition {} (dst); error is {}.", projString,
-                  proj_context_errno_string(PJ_DEFAULT_CTX, proj_errno(pjSrcDstTransformation)));
+                  proj_context_errno_string(projContext, proj_errno(pjSrcDstTransformation)));
     }
 
-    pjDstSrcTransformation = proj_create_crs_to_crs(PJ_DEFAULT_CTX, projString.c_str(), srcProjString.c_str(), NULL);
+    pjDstSrcTransformation = proj_create_crs_to_crs(projContext, projString.c_str(), srcProjString.c_str(), NULL);
 
     if (proj_errno(pjDstSrcTransformation)) // Check for non-zero error code
     {
         LOG_ERROR("ERROR: cannot initialize proj with definition {} (dst); error is {}.", projString,
-                  proj_context_errno_string(PJ_DEFAULT_CTX, proj_errno(pjDstSrcTransformation)))
+                  proj_context_errno_string(projContext, proj_errno(pjDstSrcTransformation)))
+    }
+
+    // Polar stereographic and Lambert conformal conic projections are
+    // evaluated in closed form instead of by proj if their parameters are
+    // supported and the closed-form projections are enabled.
+    dstConformalConic = ConformalConicParameters::fromProjString(projString);
+    if (useClosedFormProjection())
+    {
+        LOG_DEBUG("Using closed-form {} kernels for projection {}", getConformalConicKernels().name, projString)
     }
 
     for (int i = 0; i < 2; i++)
@@ -202,7 +418,7 @@ void GeometryHandling::initProjProjection(std::string projString)
         // (whether a line string's projection crosses the the domain boundaries)
         // do this for source and destination projections
         std::string curProjString = i ? projString : srcProjString;
-        auto &connectionCheckFunc = i ? dstConnectionFunc : srcConnectionFunc;
+        auto &connectionCheck = i ? dstConnectionCheck : srcConnectionCheck;
         auto &useScaleFactorForProjection = i ? dstUseScaleFactorForProjection : srcUseScaleFactorForProjection;
 
         if (curProjString.find("+proj=lcc") != std::string::npos)
@@ -224,29 +440,24 @@ void GeometryHandling::initProjProjection(std::string projString)
                 lon_0 = 0.0; // default
             }
 
-            // callback function for checking this projection given a line between two points
-            connectionCheckFunc = [this, lon_0](PointF f1, PointF f2) {
-                return this->canConnectPointPairInProjectionLcc(f1, f2, lon_0);
-            };
+            // check for this projection given a line between two points
+            connectionCheck = {ConnectionCheckType::Lcc, lon_0};
             useScaleFactorForProjection = true;
         }
         else if (curProjString.find("+proj=latlong") != std::string::npos ||
                  curProjString.find("+proj=longlat") != std::string::npos)
         {
-            connectionCheckFunc = [this](PointF f1, PointF f2) {
-                return this->canConnectPointPairInProjectionLatlong(f1, f2);
-            };
+            connectionCheck = {ConnectionCheckType::Latlong};
             useScaleFactorForProjection = false; // is inherently in degrees, don't need scaling
         }
         else if (curProjString.find("+proj=stere") != std::string::npos)
         {
-            connectionCheckFunc = [this](PointF f1, PointF f2) {
-                return this->canConnectPointPairInProjectionStereographic(f1, f2);
-            };
+            connectionCheck = {ConnectionCheckType::Stereographic};
             useScaleFactorForProjection = true;
         }
         else
         {
+            connectionCheck = {ConnectionCheckType::None};
             useScaleFactorForProjection = true;
             LOG_ERROR("Unsupported projection type provided. Quality of graticules might suffer.")
         }
@@ -259,6 +470,17 @@ void GeometryHandling::destroyProjProjection()
         proj_destroy(pjSrcDstTransformation);
     if (pjDstSrcTransformation)
         proj_destroy(pjDstSrcTransformation);
+    dstConformalConic.reset();
+}
+
+void GeometryHandling::setClosedFormProjectionsEnabled(bool enabled)
+{
+    closedFormProjectionsEnabled = enabled;
+}
+
+bool GeometryHandling::useClosedFormProjection() const
+{
+    return closedFormProjectionsEnabled && dstConformalConic.has_value();
 }
 
 PointF GeometryHandling::geographicalToProjectedCoordinates(PointF point, bool inverse)
@@ -288,14 +510,22 @@ PointF GeometryHandling::geographicalToProjectedCoordinates(PointF point, bool i
             lat_y *= MetConstants::scaleFactorToFitProjectedCoordsTo360Range;
         }
         // See https://proj.org/development/migration.html
-        c.lpzt.z = 0.0;
-        c.lpzt.t = HUGE_VAL;
-        c.lpzt.lam = lon_x;
-        c.lpzt.phi = lat_y;
-        c_out = proj_trans(pjDstSrcTransformation, PJ_FWD, c);
-        errorCode = proj_errno(pjDstSrcTransformation);
-        lon_x = c_out.xy.x;
-        lat_y = c_out.xy.y;
+        if (useClosedFormProjection())
+        {
+            getScalarConformalConicKernels().inverse(*dstConformalConic, &lon_x, &lat_y, 1);
+            errorCode = std::isfinite(lon_x) && std::isfinite(lat_y) ? 0 : PROJ_ERR_COORD_TRANSFM;
+        }
+        else
+        {
+            c.lpzt.z = 0.0;
+            c.lpzt.t = HUGE_VAL;
+            c.lpzt.lam = lon_x;
+            c.lpzt.phi = lat_y;
+            c_out = proj_trans(pjDstSrcTransformation, PJ_FWD, c);
+            errorCode = proj_errno(pjDstSrcTransformation);
+            lon_x = c_out.xy.x;
+            lat_y = c_out.xy.y;
+        }
     }
     else
     {
@@ -306,14 +536,22 @@ PointF GeometryHandling::geographicalToProjectedCoordinates(PointF point, bool i
         lon_x = clamp(lon_x, -180.0, 180.0);
         lat_y = clamp(lat_y, -90.0, 90.0);
 
-        c.lpzt.z = 0.0;
-        c.lpzt.t = HUGE_VAL;
-        c.lpzt.lam = lon_x;
-        c.lpzt.phi = lat_y;
-        c_out = proj_trans(pjSrcDstTransformation, PJ_FWD, c);
-        errorCode = proj_errno(pjSrcDstTransformation);
-        lon_x = c_out.xy.x;
-        lat_y = c_out.xy.y;
+        if (useClosedFormProjection())
+        {
+            getScalarConformalConicKernels().forward(*dstConformalConic, &lon_x, &lat_y, 1);
+            errorCode = std::isfinite(lon_x) && std::isfinite(lat_y) ? 0 : PROJ_ERR_COORD_TRANSFM;
+        }
+        else
+        {
+            c.lpzt.z = 0.0;
+            c.lpzt.t = HUGE_VAL;
+            c.lpzt.lam = lon_x;
+            c.lpzt.phi = lat_y;
+            c_out = proj_trans(pjSrcDstTransformation, PJ_FWD, c);
+            errorCode = proj_errno(pjSrcDstTransformation);
+            lon_x = c_out.xy.x;
+            lat_y = c_out.xy.y;
+        }
         if (dstUseScaleFactorForProjection)
         {
             lon_x /= MetConstants::scaleFactorToFitProjectedCoordsTo360Range;
@@ -324,7 +562,7 @@ PointF GeometryHandling::geographicalToProjectedCoordinates(PointF point, bool i
     if (errorCode)
     {
         LOG_ERROR("ERROR: proj transformation of point ({}, {}) failed with error '{}'. Returning (NaN., NaN.).",
-                  point.x, point.y, proj_context_errno_string(PJ_DEFAULT_CTX, errorCode))
+                  point.x, point.y, proj_context_errno_string(projContext, errorCode))
         if (inverse) // Reset error in object
         {
             proj_errno_reset(pjDstSrcTransformation);
@@ -376,47 +614,431 @@ bool GeometryHandling::canConnectPointPairInProjectionStereographic(PointF p1, P
     return true;
 }
 
+bool GeometryHandling::canConnectPointPairInDstProjection(PointF p1, PointF p2)
+{
+    return canConnectPointPair(dstConnectionCheck, p1, p2);
+}
+
 std::vector<std::vector<PointF>> GeometryHandling::geographicalToProjectedCoordinates(
     const std::vector<std::vector<PointF>> &polygons, bool inverse)
 {
-    std::vector<std::vector<PointF>> projectedPolygons;
+    PolylineSet polylines = PolylineSet::fromPolygons(polygons, &polylineMemory);
+    geographicalToProjectedCoordinates(&polylines, inverse);
+    return polylines.toPolygons();
+}
+
+void GeometryHandling::geographicalToProjectedCoordinates(PolylineSet *polylines, bool inverse)
+{
+    if (!pjSrcDstTransformation || !pjDstSrcTransformation)
+    {
+        LOG_ERROR("ERROR: proj library not initialized, cannot project geographical coordinates.")
+        polylines->clear();
+        return;
+    }
 
-    auto lineStringConnectionValidFunc = inverse ? srcConnectionFunc : dstConnectionFunc;
+    // Proj works in double precision, so the coordinates of the entire
+    // polyline set are converted once and transformed with a single proj call.
+    size_t numVertices = polylines->getNumVertices();
+    float *polylineX = polylines->getX();
+    float *polylineY = polylines->getY();
 
-    // for each polygon, for each pair of points check if they should be connected
-    for (const std::vector<PointF> &polygon : polygons)
+    std::pmr::vector<double> x(polylineX, polylineX + numVertices, &polylineMemory);
+    std::pmr::vector<double> y(polylineY, polylineY + numVertices, &polylineMemory);
+
+    // For each pair of (unprojected) points check if they should be connected.
+    // Pairs that span two input polylines are ignored by splitPolylines().
+    std::pmr::vector<uint8_t> canConnect(numVertices, &polylineMemory);
+    checkPointPairConnections(inverse ? srcConnectionCheck : dstConnectionCheck, x.data(), y.data(), numVertices,
+                              canConnect.data());
+
+    // Failed points are set to NaN by the transformation.
+    geographicalToProjectedCoordinates(x.data(), y.data(), numVertices, inverse);
+
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        polylineX[i] = static_cast<float>(x[i]);
+        polylineY[i] = static_cast<float>(y[i]);
+    }
+
+    // Line segments that interfere with the projection bounds are removed by
+    // splitting the polyline at the second point of the segment.
+    for (uint8_t &connect : canConnect)
     {
-        std::vector<PointF> projectedPolygon;
+        connect = !connect;
+    }
+    polylines->splitPolylines(canConnect.data());
+}
+
+size_t GeometryHandling::geographicalToProjectedCoordinates(double *x, double *y, size_t numPoints, bool inverse)
+{
+    if (!pjSrcDstTransformation || !pjDstSrcTransformation)
+    {
+        LOG_ERROR("ERROR: proj library not initialized, cannot project geographical coordinates.")
+        return numPoints;
+    }
+
+    if (numPoints == 0)
+    {
+        return 0;
+    }
+
+    PJ *transformation = inverse ? pjDstSrcTransformation : pjSrcDstTransformation;
 
-        PointF lastLLVertex(NAN, NAN); // remember last latlon vertex
-        for (PointF vertex : polygon)
+    if (inverse)
+    {
+        // Inverse projection: projected to geographical coordinates.
+        if (srcUseScaleFactorForProjection)
         {
-            PointF currentVertex = geographicalToProjectedCoordinates(vertex, inverse);
+            for (size_t i = 0; i < numPoints; i++)
+            {
+                x[i] *= MetConstants::scaleFactorToFitProjectedCoordsTo360Range;
+                y[i] *= MetConstants::scaleFactorToFitProjectedCoordsTo360Range;
+            }
+        }
+    }
+    else
+    {
+        // Geographical to projected coordinates: clamp to -180..180 / -90..90
+        for (size_t i = 0; i < numPoints; i++)
+        {
+            x[i] = clamp(x[i], -180.0, 180.0);
+            y[i] = clamp(y[i], -90.0, 90.0);
+        }
+    }
 
-            if (isnan(lastLLVertex.x)) // first vertex of input polygon, keep
+    int errorCode = 0;
+    if (useClosedFormProjection())
+    {
+        // Points that cannot be transformed are set to NaN by the kernels.
+        const ConformalConicKernels &kernels = getConformalConicKernels();
+        (inverse ? kernels.inverse : kernels.forward)(*dstConformalConic, x, y, numPoints);
+    }
+    else
+    {
+        // Transform all points with a single call. z and t are not provided
+        // and are broadcast by proj. Points that cannot be transformed are set
+        // to HUGE_VAL. See https://proj.org/development/reference/functions.html
+        proj_trans_generic(transformation, PJ_FWD, x, sizeof(double), numPoints, y, sizeof(double), numPoints,
+                           nullptr, 0, 0, nullptr, 0, 0);
+        errorCode = proj_errno(transformation);
+    }
+
+    // Replace failed points by NaN, so that the result matches the
+    // single-point transformation.
+    size_t numFailed = 0;
+    for (size_t i = 0; i < numPoints; i++)
+    {
+        if (!std::isfinite(x[i]) || !std::isfinite(y[i]))
+        {
+            x[i] = NAN;
+            y[i] = NAN;
+            numFailed++;
+        }
+    }
+
+    if (!inverse && dstUseScaleFactorForProjection)
+    {
+        for (size_t i = 0; i < numPoints; i++)
+        {
+            x[i] /= MetConstants::scaleFactorToFitProjectedCoordsTo360Range;
+            y[i] /= MetConstants::scaleFactorToFitProjectedCoordsTo360Range;
+        }
+    }
+
+    if (numFailed > 0 || errorCode)
+    {
+        LOG_ERROR("ERROR: proj transformation of {} out of {} points failed with error '{}'. Setting them to "
+                  "(NaN., NaN.).",
+                  numFailed, numPoints, proj_context_errno_string(projContext, errorCode))
+        proj_errno_reset(transformation);
+    }
+
+    return numFailed;
+}
+
+void GeometryHandling::checkPointPairConnections(const ConnectionCheck &check, const double *x, const double *y,
+                                                 size_t numPoints, uint8_t *canConnect)
+{
+    if (numPoints == 0)
+    {
+        return;
+    }
+    canConnect[0] = 1;
+
+    // The switch is evaluated once per point set; the loops only contain the
+    // (inlined) per-pair tests.
+    switch (check.type)
+    {
+    case ConnectionCheckType::Lcc:
+        for (size_t i = 1; i < numPoints; i++)
+        {
+            PointF p1 = {static_cast<float>(x[i - 1]), static_cast<float>(y[i - 1])};
+            PointF p2 = {static_cast<float>(x[i]), static_cast<float>(y[i])};
+            canConnect[i] = canConnectPointPairInProjectionLcc(p1, p2, check.lon_0);
+        }
+        break;
+    case ConnectionCheckType::Latlong:
+        for (size_t i = 1; i < numPoints; i++)
+        {
+            PointF p1 = {static_cast<float>(x[i - 1]), static_cast<float>(y[i - 1])};
+            PointF p2 = {static_cast<float>(x[i]), static_cast<float>(y[i])};
+            canConnect[i] = canConnectPointPairInProjectionLatlong(p1, p2);
+        }
+        break;
+    case ConnectionCheckType::Stereographic:
+        for (size_t i = 1; i < numPoints; i++)
+        {
+            PointF p1 = {static_cast<float>(x[i - 1]), static_cast<float>(y[i - 1])};
+            PointF p2 = {static_cast<float>(x[i]), static_cast<float>(y[i])};
+            canConnect[i] = canConnectPointPairInProjectionStereographic(p1, p2);
+        }
+        break;
+    case ConnectionCheckType::None:
+        std::fill(canConnect + 1, canConnect + numPoints, 1);
+        break;
+    }
+}
+
+bool GeometryHandling::canConnectPointPair(const ConnectionCheck &check, PointF p1, PointF p2)
+{
+    switch (check.type)
+    {
+    case ConnectionCheckType::Lcc:
+        return canConnectPointPairInProjectionLcc(p1, p2, check.lon_0);
+    case ConnectionCheckType::Latlong:
+        return canConnectPointPairInProjectionLatlong(p1, p2);
+    case ConnectionCheckType::Stereographic:
+        return canConnectPointPairInProjectionStereographic(p1, p2);
+    case ConnectionCheckType::None:
+        break;
+    }
+    return true;
+}
+
+void GeometryHandling::densifyAndTransform(PolylineSet *polylines, double tolerance, AdaptiveTransformTarget target)
+{
+    // Segments shorter than this (in degrees) are not refined any further,
+    // which bounds the number of vertices inserted near singularities of the
+    // projection.
+    const double minRefinedSegmentLength = 0.01;
+    // Domain boundaries are located up to this precision (in degrees).
+    const double boundaryPrecision = 1.e-5;
+    // Each level halves the segments, 32 levels are below boundaryPrecision
+    // for all segments on the globe.
+    const int maxRefinementLevels = 32;
+
+    enum SegmentState : uint8_t
+    {
+        Done,     // segment is drawn as it is
+        Refine,   // segment may deviate from its transformed curve
+        Boundary, // segment crosses the domain boundary
+        Break     // polyline is split between the vertices
+    };
+
+    // Geographical and transformed coordinates of all vertices. state[i]
+    // describes the segment from vertex i to vertex i + 1, the last vertex of
+    // each input polyline is followed by a break.
+    size_t numVertices = polylines->getNumVertices();
+    std::pmr::vector<double> lon(polylines->getX(), polylines->getX() + numVertices, &polylineMemory);
+    std::pmr::vector<double> lat(polylines->getY(), polylines->getY() + numVertices, &polylineMemory);
+    std::pmr::vector<double> x(&polylineMemory);
+    std::pmr::vector<double> y(&polylineMemory);
+    std::pmr::vector<uint8_t> state(numVertices, Break, &polylineMemory);
+
+    auto transform = [&](const double *srcLon, const double *srcLat, double *dstX, double *dstY, size_t numPoints) {
+        if (target == AdaptiveTransformTarget::Projected)
+        {
+            std::copy(srcLon, srcLon + numPoints, dstX);
+            std::copy(srcLat, srcLat + numPoints, dstY);
+            geographicalToProjectedCoordinates(dstX, dstY, numPoints);
+        }
+        else
+        {
+            std::pmr::vector<float> rotLon(srcLon, srcLon + numPoints, &polylineMemory);
+            std::pmr::vector<float> rotLat(srcLat, srcLat + numPoints, &polylineMemory);
+            geographicalToRotatedCoordinates(rotLon.data(), rotLat.data(), rotLon.data(), rotLat.data(), numPoints);
+            std::copy(rotLon.begin(), rotLon.end(), dstX);
+            std::copy(rotLat.begin(), rotLat.end(), dstY);
+        }
+    };
+
+    // Proj projections are tested in geographical, rotated lon-lat
+    // projections in rotated coordinates.
+    auto canConnect = [&](double lon1, double lat1, double x1, double y1, double lon2, double lat2, double x2,
+                          double y2) {
+        if (target == AdaptiveTransformTarget::Projected)
+        {
+            return canConnectPointPair(dstConnectionCheck, PointF(static_cast<float>(lon1), static_cast<float>(lat1)),
+                                       PointF(static_cast<float>(lon2), static_cast<float>(lat2)));
+        }
+        return canConnectPointPairInProjectionLatlong(PointF(static_cast<float>(x1), static_cast<float>(y1)),
+                                                      PointF(static_cast<float>(x2), static_cast<float>(y2)));
+    };
+
+    x.resize(numVertices);
+    y.resize(numVertices);
+    transform(lon.data(), lat.data(), x.data(), y.data(), numVertices);
+
+    for (size_t polyline = 0; polyline < polylines->getNumPolylines(); polyline++)
+    {
+        uint32_t begin = polylines->getPolylineBegin(polyline);
+        uint32_t end = begin + polylines->getPolylineSize(polyline);
+        for (uint32_t i = begin; i + 1 < end; i++)
+        {
+            // Segments with failed points are kept as they are, like in
+            // geographicalToProjectedCoordinates().
+            if (!std::isfinite(x[i]) || !std::isfinite(x[i + 1]))
+            {
+                state[i] = Done;
+            }
+            else
+            {
+                state[i] = canConnect(lon[i], lat[i], x[i], y[i], lon[i + 1], lat[i + 1], x[i + 1], y[i + 1])
+                               ? Refine
+                               : Boundary;
+            }
+        }
+    }
+
+    std::pmr::vector<size_t> activeSegments(&polylineMemory);
+    std::pmr::vector<double> midLon(&polylineMemory);
+    std::pmr::vector<double> midLat(&polylineMemory);
+    std::pmr::vector<double> midX(&polylineMemory);
+    std::pmr::vector<double> midY(&polylineMemory);
+    std::pmr::vector<uint8_t> insertMidpoint(&polylineMemory);
+    std::pmr::vector<uint8_t> midpointStates(&polylineMemory);
+
+    for (int level = 0; level < maxRefinementLevels; level++)
+    {
+        activeSegments.clear();
+        for (size_t i = 0; i < state.size(); i++)
+        {
+            if (state[i] == Refine || state[i] == Boundary)
             {
-                projectedPolygon.emplace_back(currentVertex);
-                lastLLVertex = vertex;
+                activeSegments.push_back(i);
             }
-            else if (!lineStringConnectionValidFunc || lineStringConnectionValidFunc(lastLLVertex, vertex))
+        }
+        if (activeSegments.empty())
+        {
+            break;
+        }
+
+        // Transform the midpoints of all active segments at once.
+        size_t numActive = activeSegments.size();
+        midLon.resize(numActive);
+        midLat.resize(numActive);
+        midX.resize(numActive);
+        midY.resize(numActive);
+        for (size_t k = 0; k < numActive; k++)
+        {
+            size_t i = activeSegments[k];
+            midLon[k] = 0.5 * (lon[i] + lon[i + 1]);
+            midLat[k] = 0.5 * (lat[i] + lat[i + 1]);
+        }
+        transform(midLon.data(), midLat.data(), midX.data(), midY.data(), numActive);
+
+        // Decide which segments are split and the states of their halves.
+        insertMidpoint.assign(numActive, 0);
+        midpointStates.assign(numActive, Done);
+        size_t numInserted = 0;
+        for (size_t k = 0; k < numActive; k++)
+        {
+            size_t i = activeSegments[k];
+            double segmentLength = std::hypot(lon[i + 1] - lon[i], lat[i + 1] - lat[i]);
+            if (!std::isfinite(midX[k]) || !std::isfinite(midY[k]))
+            {
+                state[i] = state[i] == Boundary ? Break : Done;
+                continue;
+            }
+
+            if (state[i] == Refine)
             {
-                // last line segment does not interfere with projection bounds
-                projectedPolygon.emplace_back(currentVertex);
-                lastLLVertex = vertex;
+                double deviation = std::hypot(midX[k] - 0.5 * (x[i] + x[i + 1]), midY[k] - 0.5 * (y[i] + y[i + 1]));
+                if (deviation <= tolerance || segmentLength < minRefinedSegmentLength)
+                {
+                    state[i] = Done;
+                    continue;
+                }
+                insertMidpoint[k] = 1;
+                midpointStates[k] = Refine;
             }
             else
             {
-                // interferes, split polygon at this point and create new one
-                projectedPolygons.emplace_back(projectedPolygon);
-                projectedPolygon = std::vector<PointF>();
-                projectedPolygon.emplace_back(currentVertex);
-                lastLLVertex = vertex;
+                if (segmentLength < boundaryPrecision)
+                {
+                    state[i] = Break;
+                    continue;
+                }
+                // Continue the search in the half that crosses the boundary.
+                bool canConnectFirstHalf =
+                    canConnect(lon[i], lat[i], x[i], y[i], midLon[k], midLat[k], midX[k], midY[k]);
+                bool canConnectSecondHalf =
+                    canConnect(midLon[k], midLat[k], midX[k], midY[k], lon[i + 1], lat[i + 1], x[i + 1], y[i + 1]);
+                insertMidpoint[k] = 1;
+                state[i] = canConnectFirstHalf ? Refine : Boundary;
+                midpointStates[k] = canConnectSecondHalf ? Refine : Boundary;
             }
+            numInserted++;
+        }
+
+        if (numInserted == 0)
+        {
+            continue;
         }
-        projectedPolygons.emplace_back(projectedPolygon);
+
+        // Insert the midpoints after the first vertex of their segments.
+        size_t newNumVertices = lon.size() + numInserted;
+        std::pmr::vector<double> newLon(&polylineMemory);
+        std::pmr::vector<double> newLat(&polylineMemory);
+        std::pmr::vector<double> newX(&polylineMemory);
+        std::pmr::vector<double> newY(&polylineMemory);
+        std::pmr::vector<uint8_t> newState(&polylineMemory);
+        newLon.reserve(newNumVertices);
+        newLat.reserve(newNumVertices);
+        newX.reserve(newNumVertices);
+        newY.reserve(newNumVertices);
+        newState.reserve(newNumVertices);
+
+        size_t k = 0;
+        for (size_t i = 0; i < lon.size(); i++)
+        {
+            newLon.push_back(lon[i]);
+            newLat.push_back(lat[i]);
+            newX.push_back(x[i]);
+            newY.push_back(y[i]);
+            newState.push_back(state[i]);
+            if (k < numActive && activeSegments[k] == i)
+            {
+                if (insertMidpoint[k])
+                {
+                    newLon.push_back(midLon[k]);
+                    newLat.push_back(midLat[k]);
+                    newX.push_back(midX[k]);
+                    newY.push_back(midY[k]);
+                    newState.push_back(midpointStates[k]);
+                }
+                k++;
+            }
+        }
+
+        lon.swap(newLon);
+        lat.swap(newLat);
+        x.swap(newX);
+        y.swap(newY);
+        state.swap(newState);
     }
 
-    return projectedPolygons;
+    // Rebuild the polylines, boundary segments that could not be located
+    // precisely enough are removed as well.
+    polylines->clear();
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        if (i == 0 || state[i - 1] == Break || state[i - 1] == Boundary)
+        {
+            polylines->beginPolyline();
+        }
+        polylines->appendVertex(static_cast<float>(x[i]), static_cast<float>(y[i]));
+    }
 }
 
 void GeometryHandling::initRotatedLonLatProjection(PointF rotatedPoleLonLat)
@@ -424,9 +1046,6 @@ void GeometryHandling::initRotatedLonLatProjection(PointF rotatedPoleLonLat)
     rotatedPole = rotatedPoleLonLat;
 }
 
-static const double DEG2RAD = M_PI / 180.0;
-static const double RAD2DEG = 180.0 / M_PI;
-
 // Parts of the following method have been ported from the C implementation of
 // the methods 'lam_to_lamrot' and 'phi_to_phirot'. The original code has been
 // published under GNU GENERAL PUBLIC LICENSE Version 2, June 1991.
@@ -493,71 +1112,45 @@ static const double RAD2DEG = 180.0 / M_PI;
 PointF GeometryHandling::geographicalToRotatedCoordinates(PointF point)
 {
     // Early break for rotation values with no effect.
-    double poleLon = rotatedPole.x;
-    double poleLat = rotatedPole.y;
-    if ((poleLon == -180. || poleLon == 180.) && poleLat == 90.)
+    if (!rotatedPoleHasEffect())
     {
         return {};
     }
 
-    // Get longitude and latitude from point.
-    double lon = point.x;
-    double lat = point.y;
-
-    if (lon > 180.0)
-    {
-        lon -= 360.0;
-    }
-
-    // Convert degrees to radians.
-    double poleLatRad = DEG2RAD * poleLat;
-    double poleLonRad = DEG2RAD * poleLon;
-    double lonRad = DEG2RAD * lon;
-    double latRad = DEG2RAD * lat;
-
-    // Compute sinus and cosinus of some coordinates since they are needed more
-    // often later on.
-    double sinPoleLat = sin(poleLatRad);
-    double cosPoleLat = cos(poleLatRad);
-
-    // Apply the transformation (conversation to Cartesian coordinates and  two
-    // rotations; difference to original code: no use of pollam).
-
-    double x = ((-sinPoleLat) * cos(latRad) * cos(lonRad - poleLonRad)) + (cosPoleLat * sin(latRad));
-    double y = (-sin(lonRad - poleLonRad)) * cos(latRad);
-    double z = (cosPoleLat * cos(latRad) * cos(lonRad - poleLonRad)) + (sinPoleLat * sin(latRad));
-
-    // Avoid invalid values for z (Might occure due to inaccuracies in
-    // computations).
-    z = max(-1., min(1., z));
+    PointF result{};
+    RotatedPoleParameters pole(rotatedPole.x, rotatedPole.y);
+    getScalarRotatedPoleKernels().geographicalToRotated(pole, &point.x, &point.y, &result.x, &result.y, 1);
+    return result;
+}
 
-    // Too small values can lead to numerical problems in method atans2.
-    if (std::abs(x) < 1.0e-20)
+void GeometryHandling::geographicalToRotatedCoordinates(const float *lon, const float *lat, float *rotLon,
+                                                        float *rotLat, size_t numPoints)
+{
+    // Early break for rotation values with no effect.
+    if (!rotatedPoleHasEffect())
     {
-        x = 1.0e-20;
+        std::fill(rotLon, rotLon + numPoints, 0.f);
+        std::fill(rotLat, rotLat + numPoints, 0.f);
+        return;
     }
 
-    // Compute spherical coordinates from Cartesian coordinates and convert
-    // radians to degrees.
-    return {static_cast<float>(RAD2DEG * (atan2(y, x))), static_cast<float>(RAD2DEG * (asin(z)))};
+    RotatedPoleParameters pole(rotatedPole.x, rotatedPole.y);
+    getRotatedPoleKernels().geographicalToRotated(pole, lon, lat, rotLon, rotLat, numPoints);
 }
 
 std::vector<std::vector<PointF>> GeometryHandling::geographicalToRotatedCoordinates(
     const std::vector<std::vector<PointF>> &polygons)
 {
-    std::vector<std::vector<PointF>> projectedPolygons;
-
-    for (const std::vector<PointF> &polygon : polygons)
-    {
-        std::vector<PointF> projectedPolygon;
-        for (PointF vertex : polygon)
-        {
-            projectedPolygon.emplace_back(geographicalToRotatedCoordinates(vertex));
-        }
-        projectedPolygons.emplace_back(projectedPolygon);
-    }
+    PolylineSet polylines = PolylineSet::fromPolygons(polygons, &polylineMemory);
+    geographicalToRotatedCoordinates(&polylines);
+    return polylines.toPolygons();
+}
 
-    return projectedPolygons;
+void GeometryHandling::geographicalToRotatedCoordinates(PolylineSet *polylines)
+{
+    // Transform all vertices in place with a single kernel call.
+    geographicalToRotatedCoordinates(polylines->getX(), polylines->getY(), polylines->getX(), polylines->getY(),
+                                     polylines->getNumVertices());
 }
 
 // Parts of the following method have been ported from the C implementation of
@@ -666,106 +1259,92 @@ std::vector<std::vector<PointF>> GeometryHandling::geographicalToRotatedCoordina
 PointF GeometryHandling::rotatedToGeographicalCoordinates(PointF point)
 {
     // Early break for rotation values with no effect.
-    double poleLon = rotatedPole.x;
-    double poleLat = rotatedPole.y;
-    if ((poleLon == -180. || poleLon == 180.) && poleLat == 90.)
+    if (!rotatedPoleHasEffect())
     {
         return {};
     }
 
-    double resultLon = 0.;
-
-    // Get longitude and latitude from point.
-    double rotLon = point.x;
-    double rotLat = point.y;
+    PointF result{};
+    RotatedPoleParameters pole(rotatedPole.x, rotatedPole.y);
+    getScalarRotatedPoleKernels().rotatedToGeographical(pole, &point.x, &point.y, &result.x, &result.y, 1);
+    return result;
+}
 
-    if (rotLon > 180.0)
+void GeometryHandling::rotatedToGeographicalCoordinates(const float *rotLon, const float *rotLat, float *lon,
+                                                        float *lat, size_t numPoints)
+{
+    // Early break for rotation values with no effect.
+    if (!rotatedPoleHasEffect())
     {
-        rotLon -= 360.0;
+        std::fill(lon, lon + numPoints, 0.f);
+        std::fill(lat, lat + numPoints, 0.f);
+        return;
     }
 
-    // Convert degrees to radians.
-    double poleLatRad = DEG2RAD * poleLat;
-    double poleLonRad = DEG2RAD * poleLon;
-    double rotLonRad = DEG2RAD * rotLon;
-
-    // Compute sinus and cosinus of some coordinates since they are needed more
-    // often later on.
-    double sinPoleLat = sin(poleLatRad);
-    double cosPoleLat = cos(poleLatRad);
-    double sinRotLatRad = sin(DEG2RAD * rotLat);
-    double cosRotLatRad = cos(DEG2RAD * rotLat);
-    double cosRotLonRad = cos(DEG2RAD * rotLon);
-
-    // Apply the transformation (conversation to Cartesian coordinates and  two
-    // rotations; difference to original code: no use of polgam).
-
-    double x = (cos(poleLonRad) * (((-sinPoleLat) * cosRotLonRad * cosRotLatRad) + (cosPoleLat * sinRotLatRad))) +
-               (sin(poleLonRad) * sin(rotLonRad) * cosRotLatRad);
-    double y = (sin(poleLonRad) * (((-sinPoleLat) * cosRotLonRad * cosRotLatRad) + (cosPoleLat * sinRotLatRad))) -
-               (cos(poleLonRad) * sin(rotLonRad) * cosRotLatRad);
-    double z = cosPoleLat * cosRotLatRad * cosRotLonRad + sinPoleLat * sinRotLatRad;
+    RotatedPoleParameters pole(rotatedPole.x, rotatedPole.y);
+    getRotatedPoleKernels().rotatedToGeographical(pole, rotLon, rotLat, lon, lat, numPoints);
+}
 
-    // Avoid invalid values for z (Might occure due to inaccuracies in
-    // computations).
-    z = max(-1., min(1., z));
+bool GeometryHandling::rotatedPoleHasEffect() const
+{
+    double poleLon = rotatedPole.x;
+    double poleLat = rotatedPole.y;
+    return !((poleLon == -180. || poleLon == 180.) && poleLat == 90.);
+}
 
-    // Compute spherical coordinates from Cartesian coordinates and convert
-    // radians to degrees.
+std::vector<std::vector<PointF>> GeometryHandling::splitLineSegmentsLongerThanThreshold(
+    const std::vector<std::vector<PointF>> &polygons, double thresholdDistance)
+{
+    PolylineSet polylines = PolylineSet::fromPolygons(polygons, &polylineMemory);
+    splitLineSegmentsLongerThanThreshold(&polylines, thresholdDistance);
+    return polylines.toPolygons();
+}
 
-    if (std::abs(x) > 0)
-    {
-        resultLon = RAD2DEG * atan2(y, x);
-    }
-    if (std::abs(resultLon) < 9.e-14)
+void GeometryHandling::splitLineSegmentsLongerThanThreshold(PolylineSet *polylines, double thresholdDistance)
+{
+    // Check for each vertex if the distance to the previous one is smaller
+    // than the threshold. If not, split into two polylines at this vertex.
+    // The first vertex of each polyline is ignored by splitPolylines().
+    size_t numVertices = polylines->getNumVertices();
+    std::pmr::vector<uint8_t> splitBefore(numVertices, &polylineMemory);
+    for (size_t i = 1; i < numVertices; i++)
     {
-        resultLon = 0.;
+        PointF previousVertex = polylines->getVertex(i - 1);
+        PointF vertex = polylines->getVertex(i);
+        splitBefore[i] = !(Vector2D(previousVertex - vertex).length() < thresholdDistance);
     }
 
-    return {static_cast<float>(resultLon), static_cast<float>(RAD2DEG * (asin(z)))};
+    polylines->splitPolylines(splitBefore.data());
 }
 
-std::vector<std::vector<PointF>> GeometryHandling::splitLineSegmentsLongerThanThreshold(
-    const std::vector<std::vector<PointF>> &polygons, double thresholdDistance)
+void GeometryHandling::geographicalToProjectedCoordinatesAdaptive(PolylineSet *polylines, double tolerance)
 {
-    std::vector<std::vector<PointF>> revisedPolygons;
-
-    for (const std::vector<PointF> &polygon : polygons)
+    if (!pjSrcDstTransformation || !pjDstSrcTransformation)
     {
-        std::vector<PointF> revisedPolygon;
-        for (PointF vertex : polygon)
-        {
-            // The revised polygon is empty? Add this vertex.
-            if (revisedPolygon.empty())
-            {
-                revisedPolygon.emplace_back(vertex);
-            }
-            // Otherwise, check if the distance between this vertex and the
-            // previous one is smaller than the threshold. If yes, add this
-            // vertex.
-            else if (Vector2D(revisedPolygon.back() - vertex).length() < thresholdDistance)
-            {
-                revisedPolygon.emplace_back(vertex);
-            }
-            // If the distance is larger than the threshold split into two
-            // polygons.
-            else
-            {
-                revisedPolygons.emplace_back(revisedPolygon);
-                revisedPolygon = std::vector<PointF>();
-                revisedPolygon.emplace_back(vertex);
-            }
-        }
-        revisedPolygons.emplace_back(revisedPolygon);
+        LOG_ERROR("ERROR: proj library not initialized, cannot project geographical coordinates.")
+        polylines->clear();
+        return;
     }
 
-    return revisedPolygons;
+    densifyAndTransform(polylines, tolerance, AdaptiveTransformTarget::Projected);
+}
+
+void GeometryHandling::geographicalToRotatedCoordinatesAdaptive(PolylineSet *polylines, double tolerance)
+{
+    densifyAndTransform(polylines, tolerance, AdaptiveTransformTarget::Rotated);
 }
 
 std::vector<std::vector<PointF>> GeometryHandling::enlargeGeometryToBBoxIfNecessary(
     std::vector<std::vector<PointF>> polygons, RectF bbox)
 {
-    // The geometry in "polygons" is assumed to be located in the range
+    PolylineSet polylines = PolylineSet::fromPolygons(polygons, &polylineMemory);
+    enlargeGeometryToBBoxIfNecessary(&polylines, bbox);
+    return polylines.toPolygons();
+}
+
+void GeometryHandling::enlargeGeometryToBBoxIfNecessary(PolylineSet *polylines, RectF bbox)
+{
+    // The geometry in "polylines" is assumed to be located in the range
     // -180..180 degrees.
     // First, determine how many times the geometry needs to be repeated to
     // fill the provdied bounding box "bbox".
@@ -790,94 +1369,232 @@ std::vector<std::vector<PointF>> GeometryHandling::enlargeGeometryToBBoxIfNecess
 
     if (globeRepetitionsWestward == 0 && globeRepetitionsEastward == 0)
     {
-        // Bounding box is in range -180..180 degrees, polygons can remain
+        // Bounding box is in range -180..180 degrees, polylines can remain
         // as they are.
-        return polygons;
+        return;
     }
 
-    std::vector<std::vector<PointF>> enlargedPolygonGeometry;
+    // Each repetition is a copy of the original geometry that is translated
+    // by a multiple of 360 degrees.
+    PolylineSet globe{&polylineMemory};
+    globe.appendPolylines(*polylines);
+    polylines->clear();
+    polylines->reserve(globe.getNumPolylines() * (globeRepetitionsEastward - globeRepetitionsWestward + 1),
+                       globe.getNumVertices() * (globeRepetitionsEastward - globeRepetitionsWestward + 1));
 
     for (int globeOffset = globeRepetitionsWestward; globeOffset <= globeRepetitionsEastward; globeOffset++)
     {
-        double lonOffset = globeOffset * 360.;
-        for (std::vector<PointF> &polygon : polygons)
+        auto lonOffset = static_cast<float>(globeOffset * 360.);
+        size_t firstVertex = polylines->getNumVertices();
+        polylines->appendPolylines(globe);
+
+        float *x = polylines->getX();
+        for (size_t i = firstVertex; i < polylines->getNumVertices(); i++)
         {
-            if (globeOffset == 0)
-            {
-                enlargedPolygonGeometry.emplace_back(polygon);
-            }
-            else
-            {
-                translate(polygon, lonOffset, 0.);
-                enlargedPolygonGeometry.emplace_back(polygon);
-            }
+            x[i] += lonOffset;
         }
     }
-
-    return enlargedPolygonGeometry;
 }
 
 std::vector<std::vector<PointF>> GeometryHandling::clipPolygons(const std::vector<std::vector<PointF>> &polygons,
                                                                 RectF bbox)
 {
-    std::vector<std::vector<PointF>> clippedPolygons;
+    PolylineSet polylines = PolylineSet::fromPolygons(polygons, &polylineMemory);
+    PolylineSet clippedPolylines{&polylineMemory};
+    clipPolygons(polylines, bbox, &clippedPolylines);
+    return clippedPolylines.toPolygons();
+}
 
-    for (const std::vector<PointF> &polygon : polygons)
+void GeometryHandling::clipPolygons(const PolylineSet &polylines, RectF bbox, PolylineSet *clippedPolylines)
+{
+    clipPolygons(polylines, PolylineIndex(polylines), bbox, clippedPolylines);
+}
+
+void GeometryHandling::clipPolygons(const PolylineSet &polylines, const PolylineIndex &index, RectF bbox,
+                                    PolylineSet *clippedPolylines)
+{
+    // Polylines whose bounding box does not intersect bbox have all their
+    // vertices on the same outer side of bbox, so all of their segments would
+    // be rejected by the clipper. Only the remaining candidates are visited.
+    std::vector<uint32_t> candidates;
+    index.query(bbox, &candidates);
+
+    // Region codes of the vertices of the current polyline.
+    std::pmr::vector<uint8_t> codes{&polylineMemory};
+
+    for (uint32_t polyline : candidates)
     {
-        std::vector<PointF> clippedPolygon;
+        uint32_t begin = polylines.getPolylineBegin(polyline);
+        uint32_t end = begin + polylines.getPolylineSize(polyline);
+
+        // Segments of polylines that lie entirely inside bbox would be
+        // accepted unchanged by the clipper. For all other polylines, the
+        // region codes are computed for all vertices at once, so that only
+        // the segments that cross the boundary of bbox need to be clipped.
+        bool inside = PolylineIndex::isInside(index.getBounds(polyline), bbox);
+        if (!inside)
+        {
+            codes.resize(end - begin);
+            computeCohenSutherlandCodes(polylines.getX() + begin, polylines.getY() + begin, end - begin, bbox,
+                                        codes.data());
+        }
+
+        // Whether a clipped polyline has been started for the current polyline
+        // and the last vertex that has been appended to it.
+        bool clippedPolylineEmpty = true;
+        PointF lastVertex{};
 
-        // Loop over each line segment in current polygon.
-        for (int i = 0; i < polygon.size() - 1; i++)
+        // Loop over each line segment in current polyline.
+        for (uint32_t i = begin; i + 1 < end; i++)
         {
+            // Segments with both points on the same outer side of bbox are
+            // rejected without loading their points, as by the clipper.
+            uint8_t code1 = inside ? 0 : codes[i - begin];
+            uint8_t code2 = inside ? 0 : codes[i + 1 - begin];
+            if (code1 & code2)
+            {
+                continue;
+            }
+
             // Obtain the two points that make up the segment.
-            PointF p1 = polygon.at(i);
-            PointF p2 = polygon.at(i + 1);
+            PointF p1 = polylines.getVertex(i);
+            PointF p2 = polylines.getVertex(i + 1);
 
-            // Clip segment against bbox. If (at least a part of the) segment
-            // is maintained, add to the clipped polygon.
-            if (cohenSutherlandClip(&p1, &p2, bbox))
+            // Clip segment against bbox. Segments with both points inside
+            // bbox are accepted unchanged. If (at least a part of the) segment
+            // is maintained, add to the clipped polyline.
+            if ((code1 | code2) == 0 || cohenSutherlandClip(&p1, &p2, bbox))
             {
-                if (clippedPolygon.empty())
+                if (clippedPolylineEmpty)
                 {
-                    // If this is the first segment in the clipped polygon,
+                    // If this is the first segment in the clipped polyline,
                     // add both points, unless they're equal.
-                    if (p1 == p2)
+                    clippedPolylines->beginPolyline();
+                    if (!(p1 == p2))
                     {
-                        clippedPolygon.emplace_back(p2);
-                    }
-                    else
-                    {
-                        clippedPolygon.emplace_back(p1);
-                        clippedPolygon.emplace_back(p2);
+                        clippedPolylines->appendVertex(p1);
                     }
+                    clippedPolylines->appendVertex(p2);
+                    clippedPolylineEmpty = false;
                 }
-                else if (p1 == clippedPolygon.back())
+                else if (p1 == lastVertex)
                 {
-                    // Last point in clippedPolygon equal to first point in
+                    // Last point in clipped polyline equal to first point in
                     // current line segment? If yes append only last point
-                    // current segment. If not, start a new polygon.
-                    if (p2 != clippedPolygon.back())
+                    // current segment. If not, start a new polyline.
+                    if (!(p2 == lastVertex))
                     {
-                        clippedPolygon.emplace_back(p2);
+                        clippedPolylines->appendVertex(p2);
                     }
                 }
                 else
                 {
-                    clippedPolygons.emplace_back(clippedPolygon);
-                    clippedPolygon = std::vector<PointF>();
-                    clippedPolygon.emplace_back(p1);
-                    clippedPolygon.emplace_back(p2);
+                    clippedPolylines->beginPolyline();
+                    clippedPolylines->appendVertex(p1);
+                    clippedPolylines->appendVertex(p2);
                 }
+                lastVertex = p2;
             }
         }
+    }
+}
+
+void GeometryHandling::computeSimplificationTolerances(const PolylineSet &polylines, float *tolerances)
+{
+    // Range of vertices that is still to be simplified, and the tolerance of
+    // the vertex at which the enclosing range has been split.
+    struct Range
+    {
+        uint32_t first;
+        uint32_t last;
+        float parentTolerance;
+    };
+    std::pmr::vector<Range> stack{&polylineMemory};
 
-        if (!clippedPolygon.empty())
+    const float *x = polylines.getX();
+    const float *y = polylines.getY();
+
+    for (size_t polyline = 0; polyline < polylines.getNumPolylines(); polyline++)
+    {
+        uint32_t begin = polylines.getPolylineBegin(polyline);
+        uint32_t end = begin + polylines.getPolylineSize(polyline);
+        if (begin == end)
         {
-            clippedPolygons.emplace_back(clippedPolygon);
+            continue;
+        }
+
+        tolerances[begin] = std::numeric_limits<float>::infinity();
+        tolerances[end - 1] = std::numeric_limits<float>::infinity();
+        if (end - begin > 2)
+        {
+            stack.push_back({begin, end - 1, std::numeric_limits<float>::infinity()});
+        }
+
+        while (!stack.empty())
+        {
+            Range range = stack.back();
+            stack.pop_back();
+
+            // Find the vertex with the largest distance to the segment between
+            // the first and the last vertex of the range.
+            double ax = x[range.first];
+            double ay = y[range.first];
+            double dx = x[range.last] - ax;
+            double dy = y[range.last] - ay;
+            double segmentLengthSquared = dx * dx + dy * dy;
+
+            uint32_t split = range.first + 1;
+            double maxDistanceSquared = -1.;
+            for (uint32_t i = range.first + 1; i < range.last; i++)
+            {
+                double px = x[i] - ax;
+                double py = y[i] - ay;
+                double t = segmentLengthSquared > 0. ? (px * dx + py * dy) / segmentLengthSquared : 0.;
+                t = std::clamp(t, 0., 1.);
+                double ex = px - t * dx;
+                double ey = py - t * dy;
+                double distanceSquared = ex * ex + ey * ey;
+                if (distanceSquared > maxDistanceSquared)
+                {
+                    maxDistanceSquared = distanceSquared;
+                    split = i;
+                }
+            }
+
+            // A vertex is removed as soon as one of the vertices at which its
+            // enclosing ranges have been split is removed.
+            float tolerance = std::min(static_cast<float>(std::sqrt(maxDistanceSquared)), range.parentTolerance);
+            tolerances[split] = tolerance;
+
+            if (split - range.first > 1)
+            {
+                stack.push_back({range.first, split, tolerance});
+            }
+            if (range.last - split > 1)
+            {
+                stack.push_back({split, range.last, tolerance});
+            }
         }
     }
+}
 
-    return clippedPolygons;
+void GeometryHandling::simplifyPolylines(const PolylineSet &polylines, const float *tolerances, float tolerance,
+                                         PolylineSet *simplifiedPolylines)
+{
+    for (size_t polyline = 0; polyline < polylines.getNumPolylines(); polyline++)
+    {
+        uint32_t begin = polylines.getPolylineBegin(polyline);
+        uint32_t end = begin + polylines.getPolylineSize(polyline);
+
+        simplifiedPolylines->beginPolyline();
+        for (uint32_t i = begin; i < end; i++)
+        {
+            if (tolerances[i] > tolerance)
+            {
+                simplifiedPolylines->appendVertex(polylines.getX()[i], polylines.getY()[i]);
+            }
+        }
+    }
 }
 
 void GeometryHandling::flattenPolygonsToVertexList(const std::vector<std::vector<PointF>> &polygons,
@@ -909,6 +1626,27 @@ void GeometryHandling::flattenPolygonsToVertexList(const std::vector<std::vector
     }
 }
 
+void GeometryHandling::flattenPolygonsToVertexList(const PolylineSet &polylines,
+                                                   std::vector<int> *polygonStartIndices,
+                                                   std::vector<int> *polygonVertexCounts)
+{
+    polygonStartIndices->clear();
+    polygonVertexCounts->clear();
+    polygonStartIndices->reserve(polylines.getNumPolylines());
+    polygonVertexCounts->reserve(polylines.getNumPolylines());
+
+    for (size_t polyline = 0; polyline < polylines.getNumPolylines(); polyline++)
+    {
+        polygonStartIndices->emplace_back(polylines.getPolylineBegin(polyline));
+        polygonVertexCounts->emplace_back(polylines.getPolylineSize(polyline));
+    }
+}
+
+std::pmr::memory_resource *GeometryHandling::getPolylineMemoryResource()
+{
+    return &polylineMemory;
+}
+
 /******************************************************************************
 ***                           PRIVATE METHODS                               ***
 *******************************************************************************/
@@ -949,6 +1687,21 @@ int GeometryHandling::cohenSutherlandCode(PointF &point, RectF &bbox) const
     return code;
 }
 
+void GeometryHandling::computeCohenSutherlandCodes(const float *x, const float *y, size_t numPoints,
+                                                   const RectF &bbox, uint8_t *codes) const
+{
+    // Same codes as cohenSutherlandCode, but computed without branches, so
+    // that the compiler can vectorize the loop.
+    for (size_t i = 0; i < numPoints; i++)
+    {
+        int left = x[i] < bbox.left;
+        int right = (x[i] > bbox.right) & !left;
+        int bottom = y[i] < bbox.top;
+        int top = (y[i] > bbox.bottom) & !bottom;
+        codes[i] = static_cast<uint8_t>(left * LEFT | right * RIGHT | bottom * BOTTOM | top * TOP);
+    }
+}
+
 bool GeometryHandling::cohenSutherlandClip(PointF *p1, PointF *p2, RectF &bbox)
 {
     // Compute region codes for P1, P2
@@ -1062,18 +1815,14 @@ OGRPolygon *GeometryHandling::convertQRectToOGRPolygon(RectF &rect)
     return bboxPolygon;
 }
 
-std::vector<PointF> GeometryHandling::convertOGRLineStringToQPolygon(OGRLineString *lineString)
+void GeometryHandling::appendOGRLineStringToPolylineSet(OGRLineString *lineString, PolylineSet *polylines)
 {
     int numLinePoints = lineString->getNumPoints();
-    auto *v = new OGRRawPoint[numLinePoints];
-    lineString->getPoints(v);
-    std::vector<PointF> polygon;
+    polylines->beginPolyline();
     for (int i = 0; i < numLinePoints; i++)
     {
-        polygon.emplace_back(PointF(v[i].x, v[i].y)); // Use push_back() to add PointF to the vector
+        polylines->appendVertex(static_cast<float>(lineString->getX(i)), static_cast<float>(lineString->getY(i)));
     }
-    delete[] v;
-    return polygon;
 }
 
 void GeometryHandling::appendOGRLineStringsFromOGRGeometry(std::vector<OGRLineString *> *lineStrings,
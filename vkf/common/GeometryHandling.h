@@ -27,7 +27,9 @@
 #pragma once
 
 // standard library imports
+#include <cstdint>
 #include <functional>
+#include <memory_resource>
 
 // related third party imports
 #include "cpl_error.h"
@@ -35,6 +37,10 @@
 #include <proj.h>
 
 // local application imports
+#include "ConformalConicKernels.h"
+#include "PolygonTriangulation.h"
+#include "PolylineIndex.h"
+#include "PolylineSet.h"
 
 namespace Met3D
 {
@@ -67,7 +73,7 @@ const double EARTHS_ANGULAR_SPEED_OF_ROTATION = 7.292115E-5; // rad/s
 // (lon and lat). For projection coordinates that are given in e.g. meters,
 // we need to scale to fit into that range. Example: 1.e6 will scale
 // stereographic units in m to 10^3 km.
-const double scaleFactorToFitProjectedCoordsTo360Range = 1.e6;
+constexpr double scaleFactorToFitProjectedCoordsTo360Range = 1.e6;
 } // namespace MetConstants
 
 struct PointF
@@ -120,7 +126,10 @@ struct RectF
 
 /**
   @brief MGeometryHandling provides methods to create, load, and transform 2D
-  geometries. Geometries are generally handled as @ref std::vector<std::vector<PointF>>.
+  geometries. Geometries are generally handled as @ref std::vector<std::vector<PointF>>
+  or, avoiding a heap allocation per polyline, as @ref PolylineSet. The PolylineSet
+  overloads work in place or append to their output and allocate their temporary
+  arrays from a memory pool that is reused for the lifetime of the object.
   Methods include loading geometry from shapefiles, generation of graticule
   geometry, projection methods for rotated lon-lat and proj-supported projections,
   and clipping to bounding boxes.
@@ -128,15 +137,68 @@ struct RectF
 class GeometryHandling
 {
   public:
-    GeometryHandling();
+    /**
+     * @brief GeometryHandling
+     * @param projContext Context for all proj objects of this instance. Proj objects must not be used by several
+     * threads at the same time, so each thread that transforms geometry needs an instance with its own context.
+     */
+    explicit GeometryHandling(PJ_CONTEXT *projContext = PJ_DEFAULT_CTX);
     virtual ~GeometryHandling();
 
     std::vector<std::vector<PointF>> generate2DGraticuleGeometry(std::vector<float> &longitudes,
                                                                  std::vector<float> &latitudes,
                                                                  Vector2D lonLatVertexSpacing);
 
+    /**
+     * @brief generate2DGraticuleGeometry
+     * Appends the meridians and parallels to @p graticuleGeometry, see the vector based overload.
+     */
+    void generate2DGraticuleGeometry(std::vector<float> &longitudes, std::vector<float> &latitudes,
+                                     Vector2D lonLatVertexSpacing, PolylineSet *graticuleGeometry);
+
     std::vector<std::vector<PointF>> read2DGeometryFromShapefile(std::string fname, RectF bbox);
 
+    /**
+     * @brief read2DGeometryFromShapefile
+     * Appends the line strings of the shapefile @p fname that intersect @p bbox to @p polylines.
+     * The line strings are taken from the shared GeometryCache, so that OGR only parses the shapefile
+     * when it is loaded for the first time or has changed. Line strings are selected by their bounding
+     * boxes, which may include some more line strings than OGR's spatial filter; these are removed by
+     * clipping.
+     * @return false if the shapefile could not be opened
+     */
+    bool read2DGeometryFromShapefile(const std::string &fname, RectF bbox, PolylineSet *polylines);
+
+    /**
+     * @brief read2DGeometryFromShapefileInChunks
+     * Reads the same line strings as read2DGeometryFromShapefile(), but passes them to @p processChunk
+     * in chunks of consecutive line strings with at most @p maxVerticesPerChunk vertices (a single
+     * longer line string forms a chunk of its own). The chunk is reused and may be modified by
+     * @p processChunk. If the geometry cache is available, the memory required is bounded by the
+     * chunk size instead of the size of the dataset.
+     * @return false if the shapefile could not be opened
+     */
+    bool read2DGeometryFromShapefileInChunks(const std::string &fname, RectF bbox, size_t maxVerticesPerChunk,
+                                            const std::function<void(PolylineSet *chunk)> &processChunk);
+
+    /**
+     * @brief cacheShapefile
+     * Builds and maps the GeometryCache entry of the shapefile @p fname without reading its
+     * line strings, e.g. to prefetch a dataset that is likely needed soon.
+     * @return false if the shapefile could not be opened or the cache is unavailable
+     */
+    bool cacheShapefile(const std::string &fname);
+
+    /**
+     * @brief read2DPolygonsFromShapefile
+     * Replaces @p mesh by the triangulated polygons and multipolygons of the shapefile @p fname, in
+     * geographical coordinates. The polygons are triangulated once and stored in the shared
+     * GeometryCache, later calls only copy the mapped triangle mesh. The triangles do not depend on
+     * the projection, so that re-projecting the mesh only has to transform its vertices.
+     * @return false if the shapefile could not be opened
+     */
+    bool read2DPolygonsFromShapefile(const std::string &fname, TriangleMesh *mesh);
+
     void initProjProjection(std::string projString);
 
     void destroyProjProjection();
@@ -146,25 +208,154 @@ class GeometryHandling
     std::vector<std::vector<PointF>> geographicalToProjectedCoordinates(
         const std::vector<std::vector<PointF>> &polygons, bool inverse = false);
 
+    /**
+     * @brief geographicalToProjectedCoordinates
+     * In-place variant for a PolylineSet. Polylines are split where a segment crosses the domain boundary of the
+     * projection (see canConnectPointPairInProjection_); only the offset table changes for this. If the proj library
+     * has not been initialized, @p polylines is cleared.
+     */
+    void geographicalToProjectedCoordinates(PolylineSet *polylines, bool inverse = false);
+
+    /**
+     * @brief geographicalToProjectedCoordinates
+     * @param x Contiguous array of x (lon) coordinates, transformed in place
+     * @param y Contiguous array of y (lat) coordinates, transformed in place
+     * @param numPoints Number of points in @p x and @p y
+     * @param inverse Whether to transform from projected to geographical coordinates
+     *
+     * Batched variant of the single-point transformation: all points are transformed with a single call to
+     * proj_trans_generic() instead of one proj_trans() call per point, or by the SIMD conformal conic kernels (see
+     * setClosedFormProjectionsEnabled()).
+     * @return the number of points that could not be transformed, these points are set to NaN
+     */
+    size_t geographicalToProjectedCoordinates(double *x, double *y, size_t numPoints, bool inverse = false);
+
+    /**
+     * @brief setClosedFormProjectionsEnabled
+     * Polar stereographic and Lambert conformal conic projections with parameters that are supported by
+     * ConformalConicParameters are evaluated by the closed-form kernels in ConformalConicKernels.h instead of proj.
+     * Disabled by default unless vkf is built with VKF_CLOSED_FORM_PROJECTIONS; vkf_closed_form_projections_test
+     * compares both.
+     */
+    void setClosedFormProjectionsEnabled(bool enabled);
+
     void initRotatedLonLatProjection(PointF rotatedPoleLonLat);
 
     PointF geographicalToRotatedCoordinates(PointF point);
 
+    /**
+     * @brief geographicalToRotatedCoordinates
+     * @param lon Contiguous array of geographical longitudes
+     * @param lat Contiguous array of geographical latitudes
+     * @param rotLon Output array of rotated longitudes, may be identical to @p lon
+     * @param rotLat Output array of rotated latitudes, may be identical to @p lat
+     * @param numPoints Number of points in the arrays
+     *
+     * Batched variant of the single-point transformation using the SIMD kernels of RotatedPoleKernels.h.
+     */
+    void geographicalToRotatedCoordinates(const float *lon, const float *lat, float *rotLon, float *rotLat,
+                                          size_t numPoints);
+
     std::vector<std::vector<PointF>> geographicalToRotatedCoordinates(const std::vector<std::vector<PointF>> &polygons);
 
+    void geographicalToRotatedCoordinates(PolylineSet *polylines);
+
     PointF rotatedToGeographicalCoordinates(PointF point);
 
+    /**
+     * @brief rotatedToGeographicalCoordinates
+     * Batched variant of the single-point transformation, see geographicalToRotatedCoordinates().
+     */
+    void rotatedToGeographicalCoordinates(const float *rotLon, const float *rotLat, float *lon, float *lat,
+                                          size_t numPoints);
+
     std::vector<std::vector<PointF>> splitLineSegmentsLongerThanThreshold(
         const std::vector<std::vector<PointF>> &polygons, double thresholdDistance);
 
+    void splitLineSegmentsLongerThanThreshold(PolylineSet *polylines, double thresholdDistance);
+
+    /**
+     * @brief geographicalToProjectedCoordinatesAdaptive
+     * Transforms @p polylines to the active proj projection like geographicalToProjectedCoordinates(),
+     * but densifies the line segments adaptively, see densifyAndTransform().
+     * @param tolerance Largest distance in projected coordinates between a transformed line segment
+     * and its chord
+     */
+    void geographicalToProjectedCoordinatesAdaptive(PolylineSet *polylines, double tolerance);
+
+    /**
+     * @brief geographicalToRotatedCoordinatesAdaptive
+     * Transforms @p polylines to rotated coordinates like geographicalToRotatedCoordinates(), but
+     * densifies the line segments adaptively and splits them where they cross the boundary of the
+     * rotated domain, see densifyAndTransform(). Replaces splitting segments longer than a fixed
+     * threshold after the rotation.
+     * @param tolerance Largest distance in rotated degrees between a transformed line segment and
+     * its chord
+     */
+    void geographicalToRotatedCoordinatesAdaptive(PolylineSet *polylines, double tolerance);
+
     std::vector<std::vector<PointF>> enlargeGeometryToBBoxIfNecessary(std::vector<std::vector<PointF>> polygons,
                                                                       RectF bbox);
 
+    void enlargeGeometryToBBoxIfNecessary(PolylineSet *polylines, RectF bbox);
+
     std::vector<std::vector<PointF>> clipPolygons(const std::vector<std::vector<PointF>> &polygons, RectF bbox);
 
+    /**
+     * @brief clipPolygons
+     * Appends the parts of @p polylines that lie inside @p bbox to @p clippedPolylines, which must not be the same
+     * object as @p polylines.
+     */
+    void clipPolygons(const PolylineSet &polylines, RectF bbox, PolylineSet *clippedPolylines);
+
+    /**
+     * @brief clipPolygons
+     * As above, but uses the spatial index @p index, which has to be built over @p polylines. Only the
+     * polylines whose bounding boxes intersect @p bbox are visited, and polylines inside @p bbox are
+     * copied without clipping their segments. Use this overload to clip the same geometry repeatedly.
+     */
+    void clipPolygons(const PolylineSet &polylines, const PolylineIndex &index, RectF bbox,
+                      PolylineSet *clippedPolylines);
+
+    /**
+     * @brief computeSimplificationTolerances
+     * Computes for each vertex of @p polylines the largest Douglas-Peucker tolerance at which the
+     * vertex is removed by the simplification. The tolerances decrease monotonically along the
+     * recursion of the algorithm, so simplifying with a tolerance t yields exactly the Douglas-Peucker
+     * result for t, and the simplifications for all tolerances are nested. The first and last vertex
+     * of each polyline are never removed and get an infinite tolerance.
+     * @param tolerances array with one entry per vertex of @p polylines
+     */
+    void computeSimplificationTolerances(const PolylineSet &polylines, float *tolerances);
+
+    /**
+     * @brief simplifyPolylines
+     * Appends @p polylines to @p simplifiedPolylines, keeping only the vertices whose tolerance, as
+     * computed by computeSimplificationTolerances(), is larger than @p tolerance. The tolerance is given
+     * in the units of the coordinates.
+     */
+    void simplifyPolylines(const PolylineSet &polylines, const float *tolerances, float tolerance,
+                           PolylineSet *simplifiedPolylines);
+
     void flattenPolygonsToVertexList(const std::vector<std::vector<PointF>> &polygons, std::vector<float> *vertexList,
                                      std::vector<int> *polygonStartIndices, std::vector<int> *polygonVertexCount);
 
+    /**
+     * @brief flattenPolygonsToVertexList
+     * The vertices of a PolylineSet already are contiguous, so no vertex list is created: the coordinate arrays
+     * (PolylineSet::getX() and PolylineSet::getY()) can be uploaded directly. Only the start index and the vertex
+     * count of each polyline are stored for multi-draw rendering.
+     */
+    void flattenPolygonsToVertexList(const PolylineSet &polylines, std::vector<int> *polygonStartIndices,
+                                     std::vector<int> *polygonVertexCount);
+
+    /**
+     * @brief getPolylineMemoryResource
+     * @return the memory pool used for temporary arrays; PolylineSets that are passed between the stages of the
+     * geometry pipeline can be allocated from it as well
+     */
+    std::pmr::memory_resource *getPolylineMemoryResource();
+
     /**
      * @brief canConnectPointPairInProjection_
      * @param p1 First point
@@ -178,27 +369,118 @@ class GeometryHandling
     bool canConnectPointPairInProjectionLatlong(PointF p1, PointF p2);
     bool canConnectPointPairInProjectionStereographic(PointF p1, PointF p2);
 
+    /**
+     * @brief canConnectPointPairInDstProjection
+     * Whether the line between the geographical points @p p1 and @p p2 does not cross the domain boundary of the
+     * destination projection set by initProjProjection(), see canConnectPointPairInProjection_.
+     */
+    bool canConnectPointPairInDstProjection(PointF p1, PointF p2);
+
   private:
+    // Projection-dependent test whether a line segment between two points
+    // crosses the domain boundary, see canConnectPointPairInProjection_.
+    enum class ConnectionCheckType
+    {
+        None,
+        Lcc,
+        Latlong,
+        Stereographic
+    };
+
+    struct ConnectionCheck
+    {
+        ConnectionCheckType type{ConnectionCheckType::None};
+        float lon_0{0.0f}; // only used by Lcc
+    };
+
+    /**
+     * @brief checkPointPairConnections
+     * Evaluates @p check for all consecutive point pairs of the coordinate arrays. canConnect[i] is set to whether the
+     * segment between points i - 1 and i may be drawn; canConnect[0] is always set. The projection type is dispatched
+     * once outside of the loops so that the per-pair tests can be inlined and vectorized.
+     */
+    void checkPointPairConnections(const ConnectionCheck &check, const double *x, const double *y, size_t numPoints,
+                                   uint8_t *canConnect);
+
+    bool canConnectPointPair(const ConnectionCheck &check, PointF p1, PointF p2);
+
+    // Whether the active proj transformations are replaced by the conformal conic kernels.
+    bool useClosedFormProjection() const;
+
+    // Target coordinate system of densifyAndTransform().
+    enum class AdaptiveTransformTarget
+    {
+        Projected,
+        Rotated
+    };
+
+    /**
+     * @brief densifyAndTransform
+     * Transforms @p polylines from geographical coordinates to @p target and refines each line segment
+     * by bisection in geographical coordinates: a segment is split at its midpoint as long as the
+     * transformed midpoint deviates by more than @p tolerance from the midpoint of the transformed
+     * chord. Segments that fail the canConnectPointPairInProjection_ test of the target are bisected
+     * until the domain boundary is located and the polyline is split there. All midpoints of one
+     * refinement level are transformed with a single batched call.
+     */
+    void densifyAndTransform(PolylineSet *polylines, double tolerance, AdaptiveTransformTarget target);
+
+    // Rotations with the pole at (+-180, 90) have no effect, the rotated pole methods then return zero coordinates.
+    bool rotatedPoleHasEffect() const;
+
     int cohenSutherlandCode(PointF &point, RectF &bbox) const;
 
+    /**
+     * @brief computeCohenSutherlandCodes
+     * Computes the region codes of cohenSutherlandCode for @p numPoints points given by @p x and @p y.
+     */
+    void computeCohenSutherlandCodes(const float *x, const float *y, size_t numPoints, const RectF &bbox,
+                                     uint8_t *codes) const;
+
     bool cohenSutherlandClip(PointF *p1, PointF *p2, RectF &bbox);
 
+    /**
+     * @brief readShapefileWithOGR
+     * Appends the line strings of the shapefile @p fname to @p polylines. If @p bbox is not null, only
+     * the features that intersect it are read.
+     */
+    bool readShapefileWithOGR(const std::string &fname, RectF *bbox, PolylineSet *polylines);
+
+    /**
+     * @brief triangulateShapefileWithOGR
+     * Triangulates all polygons of the shapefile @p fname and appends them to @p mesh, refined to
+     * edges of at most maxTriangleEdgeLength_deg and optimized for the vertex cache.
+     */
+    bool triangulateShapefileWithOGR(const std::string &fname, TriangleMesh *mesh);
+
     OGRPolygon *convertQRectToOGRPolygon(RectF &rect);
 
-    std::vector<PointF> convertOGRLineStringToQPolygon(OGRLineString *lineString);
+    void appendOGRLineStringToPolylineSet(OGRLineString *lineString, PolylineSet *polylines);
 
     void appendOGRLineStringsFromOGRGeometry(std::vector<OGRLineString *> *lineStrings, OGRGeometry *geometry);
 
+    // context of the active transformations
+    PJ_CONTEXT *projContext;
     // active transformations
     PJ *pjSrcDstTransformation, *pjDstSrcTransformation;
-    // active callbacks to connection checking functions
-    std::function<bool(PointF, PointF)> srcConnectionFunc;
-    std::function<bool(PointF, PointF)> dstConnectionFunc;
+    // active connection checks of the source and destination projections
+    ConnectionCheck srcConnectionCheck;
+    ConnectionCheck dstConnectionCheck;
     // whether the magic scaling constant should be used for projections (typically used when projection units resemble
     // meters instead of degrees)
     bool srcUseScaleFactorForProjection, dstUseScaleFactorForProjection;
+    // closed-form replacement of the active transformations, if the destination projection is supported
+    std::optional<ConformalConicParameters> dstConformalConic;
+    bool closedFormProjectionsEnabled;
 
     PointF rotatedPole;
+
+    // longest edge of the triangulated shapefile polygons in degrees, so that the triangles follow the projected
+    // polygons
+    static constexpr float maxTriangleEdgeLength_deg = 1.0f;
+
+    // pool for the temporary arrays of the PolylineSet methods
+    std::pmr::unsynchronized_pool_resource polylineMemory;
 };
 
 } // namespace Met3D
\ No newline at end of file
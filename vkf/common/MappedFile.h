@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file MappedFile.h
+/// \brief This file declares the MappedFile class, a read-only memory mapping of a file.
+///
+/// The MappedFile class is part of the vkf namespace. It wraps the platform specific file mapping functions, so that
+/// binary files such as geometry caches can be accessed in place without reading them into memory first.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace vkf
+{
+
+///
+/// \class MappedFile
+/// \brief This class maps a whole file read-only into the address space of the process.
+///
+/// The file contents are paged in by the operating system on first access. The mapping stays valid until the object is
+/// destroyed, even if the file is replaced on disk in the meantime.
+///
+class MappedFile
+{
+  public:
+    ///
+    /// \brief Constructor that maps the file.
+    ///
+    /// \param path The file to map.
+    /// \throws std::runtime_error if the file cannot be opened or mapped.
+    ///
+    explicit MappedFile(const std::filesystem::path &path);
+    MappedFile(const MappedFile &) = delete;            ///< Deleted copy constructor
+    MappedFile(MappedFile &&) = delete;                 ///< Deleted move constructor
+    MappedFile &operator=(const MappedFile &) = delete; ///< Deleted copy assignment operator
+    MappedFile &operator=(MappedFile &&) = delete;      ///< Deleted move assignment operator
+    ~MappedFile();                                      ///< Destructor
+
+    [[nodiscard]] const std::byte *getData() const;
+    [[nodiscard]] size_t getSize() const;
+
+  private:
+    const std::byte *data{nullptr};
+    size_t size{0};
+#ifdef _WIN32
+    void *fileHandle{nullptr};
+    void *mappingHandle{nullptr};
+#endif
+};
+
+} // namespace vkf
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file NaturalEarthRegistry.cpp
+/// \brief This file implements the NaturalEarthRegistry class, which selects the resolution of Natural Earth datasets.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "NaturalEarthRegistry.h"
+#include "GeometryCache.h"
+#include "GeometryHandling.h"
+#include "Log.h"
+
+namespace vkf
+{
+
+namespace
+{
+
+const char *getLayerName(NaturalEarthLayer layer)
+{
+    switch (layer)
+    {
+    case NaturalEarthLayer::Coastline:
+        return "coastline";
+    case NaturalEarthLayer::Borderline:
+        return "admin_0_boundary_lines_land";
+    case NaturalEarthLayer::Country:
+        return "admin_0_countries";
+    }
+    return "";
+}
+
+const char *getScaleName(NaturalEarthScale scale)
+{
+    switch (scale)
+    {
+    case NaturalEarthScale::Scale10m:
+        return "10m";
+    case NaturalEarthScale::Scale50m:
+        return "50m";
+    case NaturalEarthScale::Scale110m:
+        return "110m";
+    }
+    return "";
+}
+
+} // namespace
+
+NaturalEarthRegistry::NaturalEarthRegistry(std::filesystem::path assetDirectory)
+    : assetDirectory{std::move(assetDirectory)}
+{
+    // Prefetches use the shared geometry cache, which therefore has to be
+    // destroyed after the registry.
+    Met3D::GeometryCache::getShared();
+
+    for (size_t layer = 0; layer < numLayers; layer++)
+    {
+        for (size_t scale = 0; scale < numScales; scale++)
+        {
+            std::string path = getPath(static_cast<NaturalEarthLayer>(layer), static_cast<NaturalEarthScale>(scale));
+            std::error_code error;
+            available[layer][scale] = std::filesystem::exists(path, error);
+        }
+    }
+}
+
+NaturalEarthRegistry::~NaturalEarthRegistry()
+{
+    for (auto &[path, prefetch] : prefetches)
+    {
+        prefetch.wait();
+    }
+}
+
+std::string NaturalEarthRegistry::getPath(NaturalEarthLayer layer, NaturalEarthScale scale) const
+{
+    std::string name = std::string("ne_") + getScaleName(scale) + "_" + getLayerName(layer);
+    return (assetDirectory / name / (name + ".shp")).string();
+}
+
+bool NaturalEarthRegistry::isAvailable(NaturalEarthLayer layer, NaturalEarthScale scale) const
+{
+    return available[static_cast<size_t>(layer)][static_cast<size_t>(scale)];
+}
+
+NaturalEarthScale NaturalEarthRegistry::selectScale(NaturalEarthLayer layer, float maxError_deg) const
+{
+    // Walk from the coarsest to the finest scale.
+    bool hasFallback = false;
+    auto fallback = NaturalEarthScale::Scale50m;
+    for (size_t i = numScales; i-- > 0;)
+    {
+        auto scale = static_cast<NaturalEarthScale>(i);
+        if (!isAvailable(layer, scale))
+        {
+            continue;
+        }
+        if (getNominalError(scale) <= maxError_deg)
+        {
+            return scale;
+        }
+        fallback = scale;
+        hasFallback = true;
+    }
+    return hasFallback ? fallback : NaturalEarthScale::Scale50m;
+}
+
+void NaturalEarthRegistry::prefetchNeighbours(NaturalEarthLayer layer, NaturalEarthScale scale)
+{
+    auto index = static_cast<size_t>(scale);
+    if (index > 0 && isAvailable(layer, static_cast<NaturalEarthScale>(index - 1)))
+    {
+        prefetch(getPath(layer, static_cast<NaturalEarthScale>(index - 1)));
+    }
+    if (index + 1 < numScales && isAvailable(layer, static_cast<NaturalEarthScale>(index + 1)))
+    {
+        prefetch(getPath(layer, static_cast<NaturalEarthScale>(index + 1)));
+    }
+}
+
+float NaturalEarthRegistry::getNominalError(NaturalEarthScale scale)
+{
+    // 0.5 mm at 1:10m, 1:50m and 1:110m are 5 km, 25 km and 55 km.
+    switch (scale)
+    {
+    case NaturalEarthScale::Scale10m:
+        return 0.045f;
+    case NaturalEarthScale::Scale50m:
+        return 0.225f;
+    case NaturalEarthScale::Scale110m:
+        return 0.5f;
+    }
+    return 0.0f;
+}
+
+NaturalEarthRegistry &NaturalEarthRegistry::getShared()
+{
+    static NaturalEarthRegistry registry{std::filesystem::path(PROJECT_ROOT_DIR) / "assets"};
+    return registry;
+}
+
+void NaturalEarthRegistry::prefetch(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (prefetches.contains(path))
+    {
+        return;
+    }
+
+    LOG_DEBUG("Prefetching {}", path)
+    prefetches.emplace(path, std::async(std::launch::async, [path]() {
+                           Met3D::GeometryHandling geo;
+                           if (!geo.cacheShapefile(path))
+                           {
+                               LOG_WARN("Could not prefetch {}", path)
+                           }
+                       }));
+}
+
+} // namespace vkf
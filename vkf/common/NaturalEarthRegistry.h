@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file NaturalEarthRegistry.h
+/// \brief This file declares the NaturalEarthRegistry class, which selects the resolution of Natural Earth datasets.
+///
+/// Natural Earth provides its layers at the scales 1:10m, 1:50m and 1:110m. The registry knows the shapefiles of all
+/// scales of a layer and which of them are installed in the asset directory. It selects the coarsest scale whose
+/// accuracy is sufficient for the current view and loads the neighbouring scales into the geometry cache in the
+/// background, so that zooming in or out does not wait for OGR.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace vkf
+{
+
+enum class NaturalEarthLayer
+{
+    Coastline,
+    Borderline,
+    Country
+};
+
+///
+/// \brief Scales of the Natural Earth datasets, ordered from fine to coarse.
+///
+enum class NaturalEarthScale
+{
+    Scale10m,
+    Scale50m,
+    Scale110m
+};
+
+///
+/// \class NaturalEarthRegistry
+/// \brief Registry of the Natural Earth shapefiles of all layers and scales.
+///
+/// All methods may be called from several threads. Prefetches that are still running are awaited on destruction.
+///
+class NaturalEarthRegistry
+{
+  public:
+    explicit NaturalEarthRegistry(std::filesystem::path assetDirectory);
+    NaturalEarthRegistry(const NaturalEarthRegistry &) = delete;            ///< Deleted copy constructor
+    NaturalEarthRegistry(NaturalEarthRegistry &&) = delete;                 ///< Deleted move constructor
+    NaturalEarthRegistry &operator=(const NaturalEarthRegistry &) = delete; ///< Deleted copy assignment operator
+    NaturalEarthRegistry &operator=(NaturalEarthRegistry &&) = delete;      ///< Deleted move assignment operator
+    ~NaturalEarthRegistry();                                                ///< Destructor
+
+    ///
+    /// \brief Returns the path of the shapefile of layer at scale, e.g. ne_50m_coastline/ne_50m_coastline.shp.
+    ///
+    [[nodiscard]] std::string getPath(NaturalEarthLayer layer, NaturalEarthScale scale) const;
+
+    ///
+    /// \brief Returns whether the shapefile of layer at scale is installed.
+    ///
+    [[nodiscard]] bool isAvailable(NaturalEarthLayer layer, NaturalEarthScale scale) const;
+
+    ///
+    /// \brief Selects the coarsest installed scale of layer whose nominal error does not exceed maxError_deg.
+    ///
+    /// If no installed scale is accurate enough, the finest installed scale is returned. If no scale of the layer is
+    /// installed, 1:50m is returned, so that the caller reports the missing file.
+    ///
+    [[nodiscard]] NaturalEarthScale selectScale(NaturalEarthLayer layer, float maxError_deg) const;
+
+    ///
+    /// \brief Loads the installed scales next to scale into the geometry cache in the background.
+    ///
+    /// Every shapefile is prefetched at most once.
+    ///
+    void prefetchNeighbours(NaturalEarthLayer layer, NaturalEarthScale scale);
+
+    ///
+    /// \brief Returns the nominal positional error of a scale in degrees, about half a millimetre on the printed map.
+    ///
+    static float getNominalError(NaturalEarthScale scale);
+
+    ///
+    /// \brief Returns the registry of the assets shipped with the application.
+    ///
+    static NaturalEarthRegistry &getShared();
+
+  private:
+    void prefetch(const std::string &path);
+
+    static constexpr size_t numLayers = 3;
+    static constexpr size_t numScales = 3;
+
+    std::filesystem::path assetDirectory;
+    std::array<std::array<bool, numScales>, numLayers> available{};
+
+    std::mutex mutex;
+    std::unordered_map<std::string, std::future<void>> prefetches;
+};
+
+} // namespace vkf
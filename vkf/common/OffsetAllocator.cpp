@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file OffsetAllocator.cpp
+/// \brief This file implements the OffsetAllocator class, which suballocates ranges of a fixed size address space.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "OffsetAllocator.h"
+
+#include <bit>
+
+namespace vkf
+{
+
+namespace
+{
+
+constexpr uint32_t mantissaBits = 3;
+constexpr uint32_t mantissaValue = 1 << mantissaBits;
+constexpr uint32_t mantissaMask = mantissaValue - 1;
+
+///
+/// \brief Returns the bin of a range of the given size. Sizes below 8 have a bin each, larger sizes are rounded.
+///
+/// Rounding up yields the first bin whose ranges are all at least size long, which is where allocations start to
+/// search. Free ranges are inserted into the bin rounded down, so that they are never smaller than the bin promises.
+///
+uint32_t sizeToBin(uint32_t size, bool roundUp)
+{
+    if (size < mantissaValue)
+    {
+        return size;
+    }
+
+    uint32_t highestBit = 31 - std::countl_zero(size);
+    uint32_t mantissaStart = highestBit - mantissaBits;
+    uint32_t exponent = mantissaStart + 1;
+    uint32_t mantissa = (size >> mantissaStart) & mantissaMask;
+    if (roundUp && (size & ((1u << mantissaStart) - 1)) != 0)
+    {
+        // An overflow of the mantissa carries into the exponent.
+        mantissa++;
+    }
+    return (exponent << mantissaBits) + mantissa;
+}
+
+///
+/// \brief Returns the smallest size of the ranges in a bin, the inverse of sizeToBin for sizes that are bin sizes.
+///
+uint64_t binToSize(uint32_t bin)
+{
+    if (bin < mantissaValue)
+    {
+        return bin;
+    }
+
+    uint32_t exponent = bin >> mantissaBits;
+    uint64_t mantissa = (bin & mantissaMask) | mantissaValue;
+    return mantissa << (exponent - 1);
+}
+
+///
+/// \brief Returns the index of the lowest set bit of mask that is not below startBit, or invalidIndex.
+///
+uint32_t findLowestSetBitAfter(uint32_t mask, uint32_t startBit)
+{
+    if (startBit >= 32)
+    {
+        return OffsetAllocator::invalidIndex;
+    }
+    uint32_t maskAfter = mask & (0xffffffffu << startBit);
+    return maskAfter == 0 ? OffsetAllocator::invalidIndex : static_cast<uint32_t>(std::countr_zero(maskAfter));
+}
+
+} // namespace
+
+OffsetAllocator::OffsetAllocator(uint32_t size) : size{size}, freeSize{size}
+{
+    binHeads.fill(invalidIndex);
+    if (size > 0)
+    {
+        insertIntoBin(createNode(0, size));
+    }
+}
+
+OffsetAllocator::Allocation OffsetAllocator::allocate(uint32_t size)
+{
+    if (size == 0 || size > freeSize)
+    {
+        return {};
+    }
+
+    // Find the first non-empty bin whose ranges are all large enough, first among the leaf bins of the same top bin
+    // and then in the next non-empty top bin.
+    uint32_t minBin = sizeToBin(size, true);
+    uint32_t topBin = minBin / numLeafBins;
+    uint32_t leafBin = findLowestSetBitAfter(leafBinMasks[topBin], minBin % numLeafBins);
+    if (leafBin == invalidIndex)
+    {
+        topBin = findLowestSetBitAfter(topBinMask, topBin + 1);
+        if (topBin == invalidIndex)
+        {
+            return {};
+        }
+        leafBin = std::countr_zero(static_cast<uint32_t>(leafBinMasks[topBin]));
+    }
+
+    uint32_t nodeIndex = binHeads[topBin * numLeafBins + leafBin];
+    removeFromBin(nodeIndex);
+    nodes[nodeIndex].used = true;
+    freeSize -= size;
+
+    // Return the remainder of the range to the bins.
+    uint32_t remainder = nodes[nodeIndex].size - size;
+    if (remainder > 0)
+    {
+        nodes[nodeIndex].size = size;
+        uint32_t remainderIndex = createNode(nodes[nodeIndex].offset + size, remainder);
+        Node &remainderNode = nodes[remainderIndex];
+        remainderNode.neighborPrevious = nodeIndex;
+        remainderNode.neighborNext = nodes[nodeIndex].neighborNext;
+        if (remainderNode.neighborNext != invalidIndex)
+        {
+            nodes[remainderNode.neighborNext].neighborPrevious = remainderIndex;
+        }
+        nodes[nodeIndex].neighborNext = remainderIndex;
+        insertIntoBin(remainderIndex);
+    }
+
+    return Allocation{.offset = nodes[nodeIndex].offset, .node = nodeIndex};
+}
+
+void OffsetAllocator::free(Allocation allocation)
+{
+    if (!allocation.isValid())
+    {
+        return;
+    }
+
+    uint32_t nodeIndex = allocation.node;
+    nodes[nodeIndex].used = false;
+    freeSize += nodes[nodeIndex].size;
+
+    // Merge the range with its free neighbours, the merged range keeps the node of the range that comes first.
+    uint32_t previous = nodes[nodeIndex].neighborPrevious;
+    if (previous != invalidIndex && !nodes[previous].used)
+    {
+        removeFromBin(previous);
+        nodes[previous].size += nodes[nodeIndex].size;
+        nodes[previous].neighborNext = nodes[nodeIndex].neighborNext;
+        if (nodes[previous].neighborNext != invalidIndex)
+        {
+            nodes[nodes[previous].neighborNext].neighborPrevious = previous;
+        }
+        unusedNodes.push_back(nodeIndex);
+        nodeIndex = previous;
+    }
+
+    uint32_t next = nodes[nodeIndex].neighborNext;
+    if (next != invalidIndex && !nodes[next].used)
+    {
+        removeFromBin(next);
+        nodes[nodeIndex].size += nodes[next].size;
+        nodes[nodeIndex].neighborNext = nodes[next].neighborNext;
+        if (nodes[nodeIndex].neighborNext != invalidIndex)
+        {
+            nodes[nodes[nodeIndex].neighborNext].neighborPrevious = nodeIndex;
+        }
+        unusedNodes.push_back(next);
+    }
+
+    insertIntoBin(nodeIndex);
+}
+
+uint64_t OffsetAllocator::roundUpToBinSize(uint32_t size)
+{
+    return binToSize(sizeToBin(size, true));
+}
+
+uint32_t OffsetAllocator::getSize() const
+{
+    return size;
+}
+
+uint32_t OffsetAllocator::getFreeSize() const
+{
+    return freeSize;
+}
+
+uint32_t OffsetAllocator::createNode(uint32_t offset, uint32_t size)
+{
+    uint32_t nodeIndex;
+    if (!unusedNodes.empty())
+    {
+        nodeIndex = unusedNodes.back();
+        unusedNodes.pop_back();
+        nodes[nodeIndex] = Node{};
+    }
+    else
+    {
+        nodeIndex = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+    }
+    nodes[nodeIndex].offset = offset;
+    nodes[nodeIndex].size = size;
+    return nodeIndex;
+}
+
+void OffsetAllocator::insertIntoBin(uint32_t nodeIndex)
+{
+    uint32_t bin = sizeToBin(nodes[nodeIndex].size, false);
+    Node &node = nodes[nodeIndex];
+    node.binPrevious = invalidIndex;
+    node.binNext = binHeads[bin];
+    if (node.binNext != invalidIndex)
+    {
+        nodes[node.binNext].binPrevious = nodeIndex;
+    }
+    binHeads[bin] = nodeIndex;
+
+    leafBinMasks[bin / numLeafBins] |= static_cast<uint8_t>(1u << (bin % numLeafBins));
+    topBinMask |= 1u << (bin / numLeafBins);
+}
+
+void OffsetAllocator::removeFromBin(uint32_t nodeIndex)
+{
+    Node &node = nodes[nodeIndex];
+    if (node.binPrevious != invalidIndex)
+    {
+        nodes[node.binPrevious].binNext = node.binNext;
+    }
+    else
+    {
+        uint32_t bin = sizeToBin(node.size, false);
+        binHeads[bin] = node.binNext;
+        if (binHeads[bin] == invalidIndex)
+        {
+            leafBinMasks[bin / numLeafBins] &= static_cast<uint8_t>(~(1u << (bin % numLeafBins)));
+            if (leafBinMasks[bin / numLeafBins] == 0)
+            {
+                topBinMask &= ~(1u << (bin / numLeafBins));
+            }
+        }
+    }
+    if (node.binNext != invalidIndex)
+    {
+        nodes[node.binNext].binPrevious = node.binPrevious;
+    }
+}
+
+} // namespace vkf
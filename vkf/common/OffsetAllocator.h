@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file OffsetAllocator.h
+/// \brief This file declares the OffsetAllocator class, which suballocates ranges of a fixed size address space.
+///
+/// The OffsetAllocator class is part of the vkf namespace. It only manages offsets, the memory itself, e.g. a large GPU
+/// buffer, is owned by the user. Allocation and deallocation take constant time, see the class description.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace vkf
+{
+
+///
+/// \class OffsetAllocator
+/// \brief This class implements a two-level segregated fit (TLSF) allocator for offsets.
+///
+/// Free ranges are sorted into 256 bins by their size, which is encoded like a small floating point number with a
+/// 3 bit mantissa, so the sizes of the ranges in a bin differ by at most 12.5%. An allocation takes a range from the
+/// first non-empty bin whose ranges are all large enough, which is found with two bit scans, and returns the remainder
+/// to the bins. Freed ranges are merged with their free neighbours.
+///
+class OffsetAllocator
+{
+  public:
+    static constexpr uint32_t invalidIndex = 0xffffffff;
+
+    ///
+    /// \struct Allocation
+    /// \brief An allocated range, which is identified by its node for freeing.
+    ///
+    struct Allocation
+    {
+        uint32_t offset{invalidIndex};
+        uint32_t node{invalidIndex};
+
+        [[nodiscard]] bool isValid() const
+        {
+            return node != invalidIndex;
+        }
+    };
+
+    ///
+    /// \brief Constructor that creates an allocator for the offsets [0, size).
+    ///
+    explicit OffsetAllocator(uint32_t size);
+
+    ///
+    /// \brief Allocates size units, returns an invalid allocation if there is no free range that is large enough.
+    ///
+    [[nodiscard]] Allocation allocate(uint32_t size);
+
+    ///
+    /// \brief Frees an allocation. Invalid allocations are ignored.
+    ///
+    void free(Allocation allocation);
+
+    ///
+    /// \brief Returns the smallest allocator size whose initial free range satisfies an allocation of size units.
+    ///
+    /// Allocations only search the bins whose ranges are all large enough, so a range that is not exactly a bin size
+    /// cannot be allocated as a whole. The result can exceed 32 bits for sizes close to 4 GiB.
+    ///
+    [[nodiscard]] static uint64_t roundUpToBinSize(uint32_t size);
+
+    [[nodiscard]] uint32_t getSize() const;
+    [[nodiscard]] uint32_t getFreeSize() const;
+
+  private:
+    struct Node
+    {
+        uint32_t offset{0};
+        uint32_t size{0};
+        // Doubly linked list of the free ranges in a bin.
+        uint32_t binPrevious{invalidIndex};
+        uint32_t binNext{invalidIndex};
+        // Doubly linked list of all ranges in the order of their offsets.
+        uint32_t neighborPrevious{invalidIndex};
+        uint32_t neighborNext{invalidIndex};
+        bool used{false};
+    };
+
+    uint32_t createNode(uint32_t offset, uint32_t size);
+    void insertIntoBin(uint32_t nodeIndex);
+    void removeFromBin(uint32_t nodeIndex);
+
+    static constexpr uint32_t numBins = 256;
+    static constexpr uint32_t numLeafBins = 8;
+    static constexpr uint32_t numTopBins = numBins / numLeafBins;
+
+    uint32_t size;
+    uint32_t freeSize;
+
+    // Bit i of topBinMask is set if one of the bins [8 i, 8 i + 8) is not empty, bit j of leafBinMasks[i] is set if
+    // the bin 8 i + j is not empty.
+    uint32_t topBinMask{0};
+    std::array<uint8_t, numTopBins> leafBinMasks{};
+    std::array<uint32_t, numBins> binHeads{};
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> unusedNodes;
+};
+
+} // namespace vkf
@@ -0,0 +1,778 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file PolygonTriangulation.cpp
+/// \brief This file implements the PolygonTriangulator class, which triangulates polygons with holes by ear clipping.
+///
+/// The ear clipper follows the approach of the earcut library: the rings are stored as circular doubly linked lists,
+/// holes are connected to the outer ring by a bridge to the closest visible vertex, and rings the basic ear clipper
+/// cannot process are cured and split in two further passes.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PolygonTriangulation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+namespace Met3D
+{
+
+namespace
+{
+
+bool isPointInTriangle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py)
+{
+    return (cx - px) * (ay - py) >= (ax - px) * (cy - py) && (ax - px) * (by - py) >= (bx - px) * (ay - py) &&
+           (bx - px) * (cy - py) >= (cx - px) * (by - py);
+}
+
+int sign(double value)
+{
+    return (value > 0.0) - (value < 0.0);
+}
+
+} // namespace
+
+void TriangleMesh::clear()
+{
+    x.clear();
+    y.clear();
+    indices.clear();
+}
+
+size_t TriangleMesh::getNumVertices() const
+{
+    return x.size();
+}
+
+size_t TriangleMesh::getNumTriangles() const
+{
+    return indices.size() / 3;
+}
+
+void PolygonTriangulator::triangulate(const double *x, const double *y, const uint32_t *ringOffsets, size_t numRings,
+                                      TriangleMesh *mesh)
+{
+    nodes.clear();
+    holes.clear();
+
+    Node *outerNode = nullptr;
+    for (size_t ring = 0; ring < numRings; ring++)
+    {
+        uint32_t begin = ringOffsets[ring];
+        uint32_t end = ringOffsets[ring + 1];
+        if (end - begin > 1 && x[begin] == x[end - 1] && y[begin] == y[end - 1])
+        {
+            end--;
+        }
+
+        auto firstVertex = static_cast<uint32_t>(mesh->x.size());
+        for (uint32_t i = begin; i < end; i++)
+        {
+            mesh->x.push_back(static_cast<float>(x[i]));
+            mesh->y.push_back(static_cast<float>(y[i]));
+        }
+
+        // The outer ring and the holes have opposite winding orders.
+        Node *node = createRing(x, y, begin, end, firstVertex, ring == 0);
+        if (ring == 0)
+        {
+            outerNode = node;
+            if (!outerNode || outerNode->next == outerNode->prev)
+            {
+                return;
+            }
+        }
+        else if (node)
+        {
+            if (node == node->next)
+            {
+                node->steiner = true;
+            }
+            Node *leftmost = node;
+            Node *p = node;
+            do
+            {
+                if (p->x < leftmost->x || (p->x == leftmost->x && p->y < leftmost->y))
+                {
+                    leftmost = p;
+                }
+                p = p->next;
+            } while (p != node);
+            holes.push_back(leftmost);
+        }
+    }
+
+    if (!holes.empty())
+    {
+        outerNode = eliminateHoles(outerNode);
+    }
+    clipEars(outerNode, &mesh->indices, 0);
+}
+
+void PolygonTriangulator::optimizeVertexCache(TriangleMesh *mesh, uint32_t cacheSize)
+{
+    size_t numVertices = mesh->getNumVertices();
+    size_t numTriangles = mesh->getNumTriangles();
+    if (numTriangles == 0)
+    {
+        mesh->clear();
+        return;
+    }
+
+    // Triangles adjacent to each vertex, in compressed row storage.
+    std::vector<uint32_t> adjacencyOffsets(numVertices + 1, 0);
+    for (uint32_t vertex : mesh->indices)
+    {
+        adjacencyOffsets[vertex + 1]++;
+    }
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+    }
+    std::vector<uint32_t> adjacency(mesh->indices.size());
+    std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (size_t i = 0; i < mesh->indices.size(); i++)
+    {
+        adjacency[fill[mesh->indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+
+    // Number of triangles of each vertex that have not been emitted yet.
+    std::vector<uint32_t> liveTriangles(numVertices);
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        liveTriangles[i] = adjacencyOffsets[i + 1] - adjacencyOffsets[i];
+    }
+
+    std::vector<uint32_t> cacheTimeStamps(numVertices, 0);
+    std::vector<bool> isEmitted(numTriangles, false);
+    std::vector<uint32_t> deadEndStack;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> optimizedIndices;
+    optimizedIndices.reserve(mesh->indices.size());
+
+    uint32_t timeStamp = cacheSize + 1;
+    size_t cursor = 0;
+    int64_t fanningVertex = 0;
+    while (fanningVertex >= 0)
+    {
+        // Emit all remaining triangles around the fanning vertex.
+        candidates.clear();
+        auto vertex = static_cast<uint32_t>(fanningVertex);
+        for (uint32_t i = adjacencyOffsets[vertex]; i < adjacencyOffsets[vertex + 1]; i++)
+        {
+            uint32_t triangle = adjacency[i];
+            if (isEmitted[triangle])
+            {
+                continue;
+            }
+            for (size_t corner = 0; corner < 3; corner++)
+            {
+                uint32_t v = mesh->indices[3 * triangle + corner];
+                optimizedIndices.push_back(v);
+                deadEndStack.push_back(v);
+                candidates.push_back(v);
+                liveTriangles[v]--;
+                if (timeStamp - cacheTimeStamps[v] > cacheSize)
+                {
+                    cacheTimeStamps[v] = timeStamp++;
+                }
+            }
+            isEmitted[triangle] = true;
+        }
+
+        // Continue with the candidate that is still in the cache and stays in it while its triangles are emitted.
+        fanningVertex = -1;
+        int64_t bestPriority = -1;
+        for (uint32_t v : candidates)
+        {
+            if (liveTriangles[v] == 0)
+            {
+                continue;
+            }
+            int64_t priority = 0;
+            if (timeStamp - cacheTimeStamps[v] + 2 * liveTriangles[v] <= cacheSize)
+            {
+                priority = timeStamp - cacheTimeStamps[v];
+            }
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                fanningVertex = v;
+            }
+        }
+
+        // At a dead end, continue with a recently used vertex or with the next vertex in input order.
+        while (fanningVertex < 0 && !deadEndStack.empty())
+        {
+            uint32_t v = deadEndStack.back();
+            deadEndStack.pop_back();
+            if (liveTriangles[v] > 0)
+            {
+                fanningVertex = v;
+            }
+        }
+        while (fanningVertex < 0 && cursor < numVertices)
+        {
+            if (liveTriangles[cursor] > 0)
+            {
+                fanningVertex = static_cast<int64_t>(cursor);
+            }
+            cursor++;
+        }
+    }
+
+    // Renumber the vertices by first use and drop unused vertices.
+    constexpr uint32_t unused = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> remap(numVertices, unused);
+    std::vector<float> x;
+    std::vector<float> y;
+    x.reserve(numVertices);
+    y.reserve(numVertices);
+    for (uint32_t &v : optimizedIndices)
+    {
+        if (remap[v] == unused)
+        {
+            remap[v] = static_cast<uint32_t>(x.size());
+            x.push_back(mesh->x[v]);
+            y.push_back(mesh->y[v]);
+        }
+        v = remap[v];
+    }
+
+    mesh->x = std::move(x);
+    mesh->y = std::move(y);
+    mesh->indices = std::move(optimizedIndices);
+}
+
+void PolygonTriangulator::refineTriangles(TriangleMesh *mesh, float maxEdgeLength)
+{
+    if (!(maxEdgeLength > 0.0f))
+    {
+        return;
+    }
+
+    // Each pass halves all edges that are too long. Edges to the new midpoints
+    // can still be too long and are split in the following passes.
+    constexpr int maxPasses = 32;
+    const double maxSquaredEdgeLength = static_cast<double>(maxEdgeLength) * maxEdgeLength;
+
+    auto getSquaredEdgeLength = [&](uint32_t a, uint32_t b) {
+        double dx = static_cast<double>(mesh->x[b]) - mesh->x[a];
+        double dy = static_cast<double>(mesh->y[b]) - mesh->y[a];
+        return dx * dx + dy * dy;
+    };
+    auto isLongEdge = [&](uint32_t a, uint32_t b) { return getSquaredEdgeLength(a, b) > maxSquaredEdgeLength; };
+
+    // Midpoints of the edges split in the current pass, keyed by the vertices
+    // of the edge in ascending order.
+    std::unordered_map<uint64_t, uint32_t> midpoints;
+    auto getMidpoint = [&](uint32_t a, uint32_t b) {
+        uint64_t edge = (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+        auto [it, inserted] = midpoints.try_emplace(edge, static_cast<uint32_t>(mesh->x.size()));
+        if (inserted)
+        {
+            mesh->x.push_back(static_cast<float>((static_cast<double>(mesh->x[a]) + mesh->x[b]) / 2.0));
+            mesh->y.push_back(static_cast<float>((static_cast<double>(mesh->y[a]) + mesh->y[b]) / 2.0));
+        }
+        return it->second;
+    };
+
+    std::vector<uint32_t> refinedIndices;
+    bool isRefined = false;
+    for (int pass = 0; pass < maxPasses && !isRefined; pass++)
+    {
+        isRefined = true;
+        midpoints.clear();
+        refinedIndices.clear();
+        refinedIndices.reserve(mesh->indices.size());
+        auto emit = [&](uint32_t a, uint32_t b, uint32_t c) { refinedIndices.insert(refinedIndices.end(), {a, b, c}); };
+
+        for (size_t i = 0; i < mesh->indices.size(); i += 3)
+        {
+            const uint32_t *v = mesh->indices.data() + i;
+            // Edge e connects v[e] and v[(e + 1) % 3].
+            bool isSplit[3] = {isLongEdge(v[0], v[1]), isLongEdge(v[1], v[2]), isLongEdge(v[2], v[0])};
+            int numSplitEdges = isSplit[0] + isSplit[1] + isSplit[2];
+            if (numSplitEdges == 0)
+            {
+                emit(v[0], v[1], v[2]);
+                continue;
+            }
+            isRefined = false;
+
+            if (numSplitEdges == 3)
+            {
+                // Split into four similar triangles.
+                uint32_t m01 = getMidpoint(v[0], v[1]);
+                uint32_t m12 = getMidpoint(v[1], v[2]);
+                uint32_t m20 = getMidpoint(v[2], v[0]);
+                emit(v[0], m01, m20);
+                emit(m01, v[1], m12);
+                emit(m20, m12, v[2]);
+                emit(m01, m12, m20);
+            }
+            else if (numSplitEdges == 1)
+            {
+                // Split the edge a-b and connect its midpoint to c.
+                int e = isSplit[0] ? 0 : (isSplit[1] ? 1 : 2);
+                uint32_t a = v[e];
+                uint32_t b = v[(e + 1) % 3];
+                uint32_t c = v[(e + 2) % 3];
+                uint32_t m = getMidpoint(a, b);
+                emit(a, m, c);
+                emit(m, b, c);
+            }
+            else
+            {
+                // Split the edges a-b and b-c, and the remaining quadrilateral
+                // along its shorter diagonal.
+                int e = !isSplit[0] ? 0 : (!isSplit[1] ? 1 : 2);
+                uint32_t c = v[e];
+                uint32_t a = v[(e + 1) % 3];
+                uint32_t b = v[(e + 2) % 3];
+                uint32_t mab = getMidpoint(a, b);
+                uint32_t mbc = getMidpoint(b, c);
+                emit(mab, b, mbc);
+                if (getSquaredEdgeLength(a, mbc) <= getSquaredEdgeLength(mab, c))
+                {
+                    emit(a, mab, mbc);
+                    emit(a, mbc, c);
+                }
+                else
+                {
+                    emit(a, mab, c);
+                    emit(mab, mbc, c);
+                }
+            }
+        }
+
+        std::swap(mesh->indices, refinedIndices);
+    }
+}
+
+PolygonTriangulator::Node *PolygonTriangulator::createRing(const double *x, const double *y, uint32_t begin,
+                                                           uint32_t end, uint32_t firstVertex, bool clockwise)
+{
+    double area = 0.0;
+    for (uint32_t i = begin, j = end - 1; i < end; j = i++)
+    {
+        area += (x[j] - x[i]) * (y[i] + y[j]);
+    }
+
+    Node *last = nullptr;
+    if (clockwise == (area > 0.0))
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            last = insertNode(firstVertex + i - begin, x[i], y[i], last);
+        }
+    }
+    else
+    {
+        for (uint32_t i = end; i-- > begin;)
+        {
+            last = insertNode(firstVertex + i - begin, x[i], y[i], last);
+        }
+    }
+
+    if (last && isEqual(last, last->next))
+    {
+        Node *next = last->next;
+        removeNode(last);
+        last = next;
+    }
+    return last;
+}
+
+PolygonTriangulator::Node *PolygonTriangulator::insertNode(uint32_t vertex, double x, double y, Node *last)
+{
+    Node *node = &nodes.emplace_back(Node{vertex, x, y});
+    if (!last)
+    {
+        node->prev = node;
+        node->next = node;
+    }
+    else
+    {
+        node->next = last->next;
+        node->prev = last;
+        last->next->prev = node;
+        last->next = node;
+    }
+    return node;
+}
+
+void PolygonTriangulator::removeNode(Node *node)
+{
+    node->next->prev = node->prev;
+    node->prev->next = node->next;
+}
+
+PolygonTriangulator::Node *PolygonTriangulator::eliminateHoles(Node *outerNode)
+{
+    // Bridge the holes from left to right, so that later bridges do not cross earlier ones.
+    std::sort(holes.begin(), holes.end(), [](const Node *a, const Node *b) {
+        return a->x < b->x || (a->x == b->x && a->y < b->y);
+    });
+    for (Node *hole : holes)
+    {
+        outerNode = eliminateHole(hole, outerNode);
+    }
+    return outerNode;
+}
+
+PolygonTriangulator::Node *PolygonTriangulator::eliminateHole(Node *hole, Node *outerNode)
+{
+    Node *bridge = findHoleBridge(hole, outerNode);
+    if (!bridge)
+    {
+        return outerNode;
+    }
+
+    Node *bridgeReverse = splitPolygon(bridge, hole);
+    filterPoints(bridgeReverse, bridgeReverse->next);
+    return filterPoints(bridge, bridge->next);
+}
+
+PolygonTriangulator::Node *PolygonTriangulator::findHoleBridge(Node *hole, Node *outerNode)
+{
+    // Find the segment of the outer ring that is closest to the left of the
+    // leftmost hole vertex on a horizontal ray.
+    Node *p = outerNode;
+    double hx = hole->x;
+    double hy = hole->y;
+    double qx = -std::numeric_limits<double>::infinity();
+    Node *m = nullptr;
+    do
+    {
+        if (hy <= p->y && hy >= p->next->y && p->next->y != p->y)
+        {
+            double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+            if (x <= hx && x > qx)
+            {
+                qx = x;
+                m = p->x < p->next->x ? p : p->next;
+                if (x == hx)
+                {
+                    // The hole touches the outer ring.
+                    return m;
+                }
+            }
+        }
+        p = p->next;
+    } while (p != outerNode);
+
+    if (!m)
+    {
+        return nullptr;
+    }
+
+    // Vertices inside the triangle of the hole vertex, the intersection and
+    // the endpoint of the segment may block the bridge. Connect to the one
+    // with the smallest angle to the ray instead.
+    Node *stop = m;
+    double mx = m->x;
+    double my = m->y;
+    double tanMin = std::numeric_limits<double>::infinity();
+    p = m;
+    do
+    {
+        if (hx >= p->x && p->x >= mx && hx != p->x &&
+            isPointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y))
+        {
+            double tan = std::abs(hy - p->y) / (hx - p->x);
+            bool containsSector = signedArea(m->prev, m, p->prev) < 0.0 && signedArea(p->next, m, m->next) < 0.0;
+            if (isLocallyInside(p, hole) &&
+                (tan < tanMin || (tan == tanMin && (p->x > m->x || (p->x == m->x && containsSector)))))
+            {
+                m = p;
+                tanMin = tan;
+            }
+        }
+        p = p->next;
+    } while (p != stop);
+
+    return m;
+}
+
+PolygonTriangulator::Node *PolygonTriangulator::splitPolygon(Node *a, Node *b)
+{
+    // Connect a and b with a diagonal. If a and b are in the same ring, the
+    // ring is split in two. Otherwise, the two rings are merged.
+    Node *a2 = &nodes.emplace_back(Node{a->vertex, a->x, a->y});
+    Node *b2 = &nodes.emplace_back(Node{b->vertex, b->x, b->y});
+    Node *an = a->next;
+    Node *bp = b->prev;
+
+    a->next = b;
+    b->prev = a;
+
+    a2->next = an;
+    an->prev = a2;
+
+    b2->next = a2;
+    a2->prev = b2;
+
+    bp->next = b2;
+    b2->prev = bp;
+
+    return b2;
+}
+
+PolygonTriangulator::Node *PolygonTriangulator::filterPoints(Node *start, Node *end)
+{
+    if (!start)
+    {
+        return start;
+    }
+    if (!end)
+    {
+        end = start;
+    }
+
+    // Remove duplicate and collinear vertices.
+    Node *p = start;
+    bool again;
+    do
+    {
+        again = false;
+        if (!p->steiner && (isEqual(p, p->next) || signedArea(p->prev, p, p->next) == 0.0))
+        {
+            removeNode(p);
+            p = end = p->prev;
+            if (p == p->next)
+            {
+                break;
+            }
+            again = true;
+        }
+        else
+        {
+            p = p->next;
+        }
+    } while (again || p != end);
+
+    return end;
+}
+
+void PolygonTriangulator::clipEars(Node *ear, std::vector<uint32_t> *indices, int pass)
+{
+    if (!ear)
+    {
+        return;
+    }
+
+    Node *stop = ear;
+    while (ear->prev != ear->next)
+    {
+        Node *prev = ear->prev;
+        Node *next = ear->next;
+
+        if (isEar(ear))
+        {
+            indices->push_back(prev->vertex);
+            indices->push_back(ear->vertex);
+            indices->push_back(next->vertex);
+            removeNode(ear);
+
+            // Skipping the next vertex leads to less sliver triangles.
+            ear = next->next;
+            stop = next->next;
+            continue;
+        }
+
+        ear = next;
+
+        // A full loop without an ear: filter degenerate vertices first, then
+        // cure self-intersections and finally split the ring in two.
+        if (ear == stop)
+        {
+            if (pass == 0)
+            {
+                clipEars(filterPoints(ear), indices, 1);
+            }
+            else if (pass == 1)
+            {
+                ear = cureLocalIntersections(filterPoints(ear), indices);
+                clipEars(ear, indices, 2);
+            }
+            else
+            {
+                splitAndClipEars(ear, indices);
+            }
+            break;
+        }
+    }
+}
+
+bool PolygonTriangulator::isEar(const Node *ear)
+{
+    const Node *a = ear->prev;
+    const Node *b = ear;
+    const Node *c = ear->next;
+
+    // Reflex vertices are no ears.
+    if (signedArea(a, b, c) >= 0.0)
+    {
+        return false;
+    }
+
+    // No other reflex vertex of the ring may lie inside the ear.
+    const Node *p = ear->next->next;
+    while (p != ear->prev)
+    {
+        if (isPointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) &&
+            signedArea(p->prev, p, p->next) >= 0.0)
+        {
+            return false;
+        }
+        p = p->next;
+    }
+    return true;
+}
+
+PolygonTriangulator::Node *PolygonTriangulator::cureLocalIntersections(Node *start, std::vector<uint32_t> *indices)
+{
+    Node *p = start;
+    do
+    {
+        Node *a = p->prev;
+        Node *b = p->next->next;
+
+        if (!isEqual(a, b) && intersects(a, p, p->next, b) && isLocallyInside(a, b) && isLocallyInside(b, a))
+        {
+            indices->push_back(a->vertex);
+            indices->push_back(p->vertex);
+            indices->push_back(b->vertex);
+
+            removeNode(p);
+            removeNode(p->next);
+            p = start = b;
+        }
+        p = p->next;
+    } while (p != start);
+
+    return filterPoints(p);
+}
+
+void PolygonTriangulator::splitAndClipEars(Node *start, std::vector<uint32_t> *indices)
+{
+    // Look for a valid diagonal that divides the ring into two.
+    Node *a = start;
+    do
+    {
+        Node *b = a->next->next;
+        while (b != a->prev)
+        {
+            if (a->vertex != b->vertex && isValidDiagonal(a, b))
+            {
+                Node *c = splitPolygon(a, b);
+
+                a = filterPoints(a, a->next);
+                c = filterPoints(c, c->next);
+
+                clipEars(a, indices, 0);
+                clipEars(c, indices, 0);
+                return;
+            }
+            b = b->next;
+        }
+        a = a->next;
+    } while (a != start);
+}
+
+double PolygonTriangulator::signedArea(const Node *p, const Node *q, const Node *r)
+{
+    return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+}
+
+bool PolygonTriangulator::isEqual(const Node *a, const Node *b)
+{
+    return a->x == b->x && a->y == b->y;
+}
+
+bool PolygonTriangulator::intersects(const Node *p1, const Node *q1, const Node *p2, const Node *q2)
+{
+    auto isOnSegment = [](const Node *p, const Node *q, const Node *r) {
+        return q->x <= std::max(p->x, r->x) && q->x >= std::min(p->x, r->x) && q->y <= std::max(p->y, r->y) &&
+               q->y >= std::min(p->y, r->y);
+    };
+
+    int o1 = sign(signedArea(p1, q1, p2));
+    int o2 = sign(signedArea(p1, q1, q2));
+    int o3 = sign(signedArea(p2, q2, p1));
+    int o4 = sign(signedArea(p2, q2, q1));
+
+    if (o1 != o2 && o3 != o4)
+    {
+        return true;
+    }
+
+    // Collinear segments that overlap.
+    return (o1 == 0 && isOnSegment(p1, p2, q1)) || (o2 == 0 && isOnSegment(p1, q2, q1)) ||
+           (o3 == 0 && isOnSegment(p2, p1, q2)) || (o4 == 0 && isOnSegment(p2, q1, q2));
+}
+
+bool PolygonTriangulator::intersectsPolygon(const Node *a, const Node *b)
+{
+    const Node *p = a;
+    do
+    {
+        if (p->vertex != a->vertex && p->next->vertex != a->vertex && p->vertex != b->vertex &&
+            p->next->vertex != b->vertex && intersects(p, p->next, a, b))
+        {
+            return true;
+        }
+        p = p->next;
+    } while (p != a);
+    return false;
+}
+
+bool PolygonTriangulator::isLocallyInside(const Node *a, const Node *b)
+{
+    return signedArea(a->prev, a, a->next) < 0.0
+               ? signedArea(a, b, a->next) >= 0.0 && signedArea(a, a->prev, b) >= 0.0
+               : signedArea(a, b, a->prev) < 0.0 || signedArea(a, a->next, b) < 0.0;
+}
+
+bool PolygonTriangulator::isMiddleInside(const Node *a, const Node *b)
+{
+    const Node *p = a;
+    bool inside = false;
+    double px = (a->x + b->x) / 2.0;
+    double py = (a->y + b->y) / 2.0;
+    do
+    {
+        if (((p->y > py) != (p->next->y > py)) && p->next->y != p->y &&
+            (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x))
+        {
+            inside = !inside;
+        }
+        p = p->next;
+    } while (p != a);
+    return inside;
+}
+
+bool PolygonTriangulator::isValidDiagonal(const Node *a, const Node *b)
+{
+    if (a->next->vertex == b->vertex || a->prev->vertex == b->vertex || intersectsPolygon(a, b))
+    {
+        return false;
+    }
+
+    // The diagonal has to lie inside the ring and must not create a degenerate
+    // triangle, or it connects two equal points of locally convex corners.
+    bool isInside = isLocallyInside(a, b) && isLocallyInside(b, a) && isMiddleInside(a, b) &&
+                    (signedArea(a->prev, a, b->prev) != 0.0 || signedArea(a, b->prev, b) != 0.0);
+    bool isZeroLength =
+        isEqual(a, b) && signedArea(a->prev, a, a->next) > 0.0 && signedArea(b->prev, b, b->next) > 0.0;
+    return isInside || isZeroLength;
+}
+
+} // namespace Met3D
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file PolygonTriangulation.h
+/// \brief This file declares the PolygonTriangulator class, which triangulates polygons with holes by ear clipping.
+///
+/// Polygons are triangulated once in geographical coordinates. The triangles only reference vertices, so the
+/// triangulation stays valid when the vertices are transformed to another projection and the topology can be reused
+/// without triangulating the polygons again.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace Met3D
+{
+
+///
+/// \brief Indexed triangle list with separate x and y coordinate arrays.
+///
+struct TriangleMesh
+{
+    std::vector<float> x;
+    std::vector<float> y;
+    // Three vertex indices per triangle.
+    std::vector<uint32_t> indices;
+
+    void clear();
+    [[nodiscard]] size_t getNumVertices() const;
+    [[nodiscard]] size_t getNumTriangles() const;
+};
+
+///
+/// \class PolygonTriangulator
+/// \brief Triangulates simple polygons with holes by ear clipping.
+///
+/// Holes are bridged to the outer ring first, so that the ear clipper processes a single ring. Rings that are not
+/// simple, e.g. due to touching holes, are handled by curing local self-intersections and splitting the ring along
+/// valid diagonals. The winding order of the rings does not matter.
+///
+/// The triangulator keeps its scratch memory between calls, so one instance should be reused for all polygons of a
+/// dataset.
+///
+class PolygonTriangulator
+{
+  public:
+    ///
+    /// \brief Triangulates a polygon and appends its vertices and triangles to mesh.
+    ///
+    /// The vertices of ring i are [ringOffsets[i], ringOffsets[i + 1]) of x and y. Ring 0 is the outer ring, all
+    /// following rings are holes. A closing vertex that repeats the first vertex of a ring is ignored.
+    ///
+    void triangulate(const double *x, const double *y, const uint32_t *ringOffsets, size_t numRings,
+                     TriangleMesh *mesh);
+
+    ///
+    /// \brief Reorders the triangles of mesh for the post-transform vertex cache and its vertices by first use.
+    ///
+    /// The triangles are ordered with Tipsify (Sander et al. 2007, "Fast triangle reordering for vertex locality and
+    /// reduced overdraw") for a cache of cacheSize vertices. Afterwards, the vertices are renumbered in the order in
+    /// which the triangles use them, so that vertex fetches are sequential, and unused vertices are removed.
+    ///
+    static void optimizeVertexCache(TriangleMesh *mesh, uint32_t cacheSize = 16);
+
+    ///
+    /// \brief Subdivides the triangles of mesh until no edge is longer than maxEdgeLength.
+    ///
+    /// Long edges are split at their midpoint, which is shared by both triangles of the edge, so that the mesh stays
+    /// conforming. Ear clipping connects distant vertices by straight edges, which become curves under projection.
+    /// Refining the triangles with these Steiner points keeps the projected triangles close to the projected polygons.
+    ///
+    static void refineTriangles(TriangleMesh *mesh, float maxEdgeLength);
+
+  private:
+    struct Node
+    {
+        uint32_t vertex;
+        double x;
+        double y;
+        Node *prev{nullptr};
+        Node *next{nullptr};
+        // Nodes that were created to bridge a hole consisting of a single point.
+        bool steiner{false};
+    };
+
+    Node *createRing(const double *x, const double *y, uint32_t begin, uint32_t end, uint32_t firstVertex,
+                     bool clockwise);
+    Node *insertNode(uint32_t vertex, double x, double y, Node *last);
+    static void removeNode(Node *node);
+
+    Node *eliminateHoles(Node *outerNode);
+    Node *eliminateHole(Node *hole, Node *outerNode);
+    static Node *findHoleBridge(Node *hole, Node *outerNode);
+    Node *splitPolygon(Node *a, Node *b);
+    static Node *filterPoints(Node *start, Node *end = nullptr);
+
+    void clipEars(Node *ear, std::vector<uint32_t> *indices, int pass);
+    static bool isEar(const Node *ear);
+    static Node *cureLocalIntersections(Node *start, std::vector<uint32_t> *indices);
+    void splitAndClipEars(Node *start, std::vector<uint32_t> *indices);
+
+    static double signedArea(const Node *p, const Node *q, const Node *r);
+    static bool isEqual(const Node *a, const Node *b);
+    static bool intersects(const Node *p1, const Node *q1, const Node *p2, const Node *q2);
+    static bool intersectsPolygon(const Node *a, const Node *b);
+    static bool isLocallyInside(const Node *a, const Node *b);
+    static bool isMiddleInside(const Node *a, const Node *b);
+    static bool isValidDiagonal(const Node *a, const Node *b);
+
+    // Nodes of the current polygon, a deque so that pointers stay valid while nodes are added.
+    std::deque<Node> nodes;
+    // Leftmost nodes of the holes of the current polygon.
+    std::vector<Node *> holes;
+};
+
+} // namespace Met3D
@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file PolylineIndex.cpp
+/// \brief This file implements the PolylineIndex class, a static spatial index over the bounding boxes of polylines.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PolylineIndex.h"
+#include "GeometryHandling.h"
+#include "PolylineSet.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace Met3D
+{
+
+namespace
+{
+
+constexpr uint32_t hilbertOrder = 16;
+
+PolylineBounds getInvertedBounds()
+{
+    return {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+            std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+}
+
+void expandBounds(PolylineBounds *b, const PolylineBounds &other)
+{
+    b->minX = std::min(b->minX, other.minX);
+    b->minY = std::min(b->minY, other.minY);
+    b->maxX = std::max(b->maxX, other.maxX);
+    b->maxY = std::max(b->maxY, other.maxY);
+}
+
+// Position of the cell (x, y) of a 2^hilbertOrder x 2^hilbertOrder grid along the Hilbert curve.
+uint64_t getHilbertIndex(uint32_t x, uint32_t y)
+{
+    constexpr uint32_t n = 1u << hilbertOrder;
+    uint64_t index = 0;
+    for (uint32_t s = n / 2; s > 0; s /= 2)
+    {
+        uint32_t rx = (x & s) > 0 ? 1 : 0;
+        uint32_t ry = (y & s) > 0 ? 1 : 0;
+        index += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+
+        // Rotate the quadrant, so that the curve is continuous.
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+// Maps a coordinate to a cell of the Hilbert grid. Coordinates that are not finite are mapped to the first cell.
+uint32_t getHilbertCell(float value, float min, float extent)
+{
+    constexpr float maxCell = static_cast<float>((1u << hilbertOrder) - 1);
+    float cell = extent > 0.0f ? (value - min) / extent * maxCell : 0.0f;
+    if (!(cell >= 0.0f))
+    {
+        return 0;
+    }
+    return static_cast<uint32_t>(std::min(cell, maxCell));
+}
+
+} // namespace
+
+PolylineIndex::PolylineIndex(const PolylineSet &polylines)
+{
+    bounds.resize(polylines.getNumPolylines());
+    for (size_t i = 0; i < polylines.getNumPolylines(); i++)
+    {
+        uint32_t begin = polylines.getPolylineBegin(i);
+        bounds[i] = computeBounds(polylines.getX() + begin, polylines.getY() + begin, polylines.getPolylineSize(i));
+    }
+    build();
+}
+
+PolylineIndex::PolylineIndex(const PolylineBounds *bounds, size_t numPolylines) : bounds(bounds, bounds + numPolylines)
+{
+    build();
+}
+
+void PolylineIndex::query(const RectF &bbox, std::vector<uint32_t> *polylines) const
+{
+    polylines->clear();
+    if (nodeBounds.empty())
+    {
+        return;
+    }
+
+    const size_t numLeaves = bounds.size();
+    const size_t root = nodeBounds.size() - 1;
+    if (!intersects(nodeBounds[root], bbox))
+    {
+        return;
+    }
+    if (root < numLeaves)
+    {
+        polylines->push_back(nodeIndices[root]);
+        return;
+    }
+
+    // Depth first traversal of the intersecting inner nodes, each stored with its level.
+    std::vector<std::pair<size_t, size_t>> stack;
+    stack.emplace_back(root, levelEnds.size() - 1);
+    while (!stack.empty())
+    {
+        auto [node, level] = stack.back();
+        stack.pop_back();
+
+        size_t childBegin = nodeIndices[node];
+        size_t childEnd = std::min(childBegin + nodeSize, levelEnds[level - 1]);
+        for (size_t child = childBegin; child < childEnd; child++)
+        {
+            if (!intersects(nodeBounds[child], bbox))
+            {
+                continue;
+            }
+            if (child < numLeaves)
+            {
+                polylines->push_back(nodeIndices[child]);
+            }
+            else
+            {
+                stack.emplace_back(child, level - 1);
+            }
+        }
+    }
+
+    // The leaves are in Hilbert order, callers expect the original order of the polylines.
+    std::sort(polylines->begin(), polylines->end());
+}
+
+size_t PolylineIndex::getNumPolylines() const
+{
+    return bounds.size();
+}
+
+const PolylineBounds &PolylineIndex::getBounds(size_t polyline) const
+{
+    return bounds[polyline];
+}
+
+PolylineBounds PolylineIndex::computeBounds(const float *x, const float *y, size_t numPoints)
+{
+    PolylineBounds b = getInvertedBounds();
+    bool hasNaN = false;
+    for (size_t i = 0; i < numPoints; i++)
+    {
+        b.minX = std::min(b.minX, x[i]);
+        b.minY = std::min(b.minY, y[i]);
+        b.maxX = std::max(b.maxX, x[i]);
+        b.maxY = std::max(b.maxY, y[i]);
+        hasNaN |= std::isnan(x[i]) || std::isnan(y[i]);
+    }
+
+    if (hasNaN)
+    {
+        constexpr float infinity = std::numeric_limits<float>::infinity();
+        return {-infinity, -infinity, infinity, infinity};
+    }
+    return b;
+}
+
+bool PolylineIndex::intersects(const PolylineBounds &b, const RectF &bbox)
+{
+    return b.maxX >= bbox.left && b.minX <= bbox.right && b.maxY >= bbox.top && b.minY <= bbox.bottom;
+}
+
+bool PolylineIndex::isInside(const PolylineBounds &b, const RectF &bbox)
+{
+    return b.minX >= bbox.left && b.maxX <= bbox.right && b.minY >= bbox.top && b.maxY <= bbox.bottom;
+}
+
+void PolylineIndex::build()
+{
+    const size_t numLeaves = bounds.size();
+    if (numLeaves == 0)
+    {
+        return;
+    }
+
+    // Sort the polylines along a Hilbert curve through the centers of their bounding boxes, so that neighbouring
+    // leaves are close in space and the boxes of the inner nodes stay small.
+    PolylineBounds extent = getInvertedBounds();
+    for (const PolylineBounds &b : bounds)
+    {
+        if (b.minX <= b.maxX && std::isfinite(b.minX) && std::isfinite(b.maxX) && std::isfinite(b.minY) &&
+            std::isfinite(b.maxY))
+        {
+            expandBounds(&extent, b);
+        }
+    }
+
+    std::vector<uint64_t> hilbertIndices(numLeaves);
+    for (size_t i = 0; i < numLeaves; i++)
+    {
+        float centerX = 0.5f * bounds[i].minX + 0.5f * bounds[i].maxX;
+        float centerY = 0.5f * bounds[i].minY + 0.5f * bounds[i].maxY;
+        hilbertIndices[i] = getHilbertIndex(getHilbertCell(centerX, extent.minX, extent.maxX - extent.minX),
+                                            getHilbertCell(centerY, extent.minY, extent.maxY - extent.minY));
+    }
+
+    std::vector<uint32_t> order(numLeaves);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](uint32_t a, uint32_t b) { return hilbertIndices[a] < hilbertIndices[b]; });
+
+    size_t numNodes = numLeaves;
+    for (size_t levelSize = numLeaves; levelSize > 1;)
+    {
+        levelSize = (levelSize + nodeSize - 1) / nodeSize;
+        numNodes += levelSize;
+    }
+    nodeBounds.clear();
+    nodeIndices.clear();
+    levelEnds.clear();
+    nodeBounds.reserve(numNodes);
+    nodeIndices.reserve(numNodes);
+
+    for (uint32_t polyline : order)
+    {
+        nodeBounds.push_back(bounds[polyline]);
+        nodeIndices.push_back(polyline);
+    }
+    levelEnds.push_back(numLeaves);
+
+    // Group the nodes of each level into parents until a single root is left.
+    size_t levelBegin = 0;
+    while (levelEnds.back() - levelBegin > 1)
+    {
+        size_t levelEnd = levelEnds.back();
+        for (size_t child = levelBegin; child < levelEnd; child += nodeSize)
+        {
+            PolylineBounds b = getInvertedBounds();
+            for (size_t i = child; i < std::min(child + nodeSize, levelEnd); i++)
+            {
+                expandBounds(&b, nodeBounds[i]);
+            }
+            nodeBounds.push_back(b);
+            nodeIndices.push_back(static_cast<uint32_t>(child));
+        }
+        levelBegin = levelEnd;
+        levelEnds.push_back(nodeBounds.size());
+    }
+}
+
+} // namespace Met3D
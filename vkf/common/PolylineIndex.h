@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file PolylineIndex.h
+/// \brief This file declares the PolylineIndex class, a static spatial index over the bounding boxes of polylines.
+///
+/// The index is a packed R-tree: the polylines are sorted along a Hilbert curve and grouped into nodes of a fixed size,
+/// level by level, so that the tree is built in one pass and stored in flat arrays. Bounding box queries only visit the
+/// nodes that intersect the query, so their cost depends on the number of results instead of the size of the dataset.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Met3D
+{
+
+class PolylineSet;
+struct RectF;
+
+///
+/// \brief Axis aligned bounding box of a polyline.
+///
+/// Empty polylines have an inverted box that intersects nothing. Polylines with NaN coordinates have an infinite box,
+/// so that they are never skipped by a query.
+///
+struct PolylineBounds
+{
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+};
+
+///
+/// \class PolylineIndex
+/// \brief Packed static R-tree over the bounding boxes of a set of polylines.
+///
+/// Query boxes follow the convention of GeometryHandling: bbox.top is the lower and bbox.bottom the upper y limit. The
+/// bounds are inclusive, like the region codes of the Cohen-Sutherland clipper.
+///
+class PolylineIndex
+{
+  public:
+    ///
+    /// \brief Creates an empty index.
+    ///
+    PolylineIndex() = default;
+
+    ///
+    /// \brief Builds the index over the bounding boxes of all polylines of polylines.
+    ///
+    explicit PolylineIndex(const PolylineSet &polylines);
+
+    ///
+    /// \brief Builds the index over precomputed bounding boxes, one per polyline.
+    ///
+    PolylineIndex(const PolylineBounds *bounds, size_t numPolylines);
+
+    ///
+    /// \brief Replaces polylines by the indices of all polylines whose bounding box intersects bbox, in ascending
+    /// order.
+    ///
+    void query(const RectF &bbox, std::vector<uint32_t> *polylines) const;
+
+    [[nodiscard]] size_t getNumPolylines() const;
+    [[nodiscard]] const PolylineBounds &getBounds(size_t polyline) const;
+
+    ///
+    /// \brief Computes the bounding box of the numPoints vertices given by x and y.
+    ///
+    static PolylineBounds computeBounds(const float *x, const float *y, size_t numPoints);
+
+    ///
+    /// \brief Returns whether the bounding box b intersects bbox.
+    ///
+    static bool intersects(const PolylineBounds &b, const RectF &bbox);
+
+    ///
+    /// \brief Returns whether the bounding box b lies inside bbox, including its boundary.
+    ///
+    static bool isInside(const PolylineBounds &b, const RectF &bbox);
+
+  private:
+    void build();
+
+    static constexpr uint32_t nodeSize = 16;
+
+    // Bounding boxes of the polylines in their original order.
+    std::vector<PolylineBounds> bounds;
+    // Boxes of all tree nodes, starting with the leaves in Hilbert order and ending with the root.
+    std::vector<PolylineBounds> nodeBounds;
+    // For leaves the index of the polyline, for inner nodes the position of the first child in nodeBounds.
+    std::vector<uint32_t> nodeIndices;
+    // Position behind the last node of each level in nodeBounds, starting with the leaf level.
+    std::vector<size_t> levelEnds;
+};
+
+} // namespace Met3D
@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file PolylineSet.cpp
+/// \brief This file implements the PolylineSet class, a flat container for 2D polylines used by GeometryHandling.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PolylineSet.h"
+#include "GeometryHandling.h"
+
+#include <cassert>
+
+namespace Met3D
+{
+
+PolylineSet::PolylineSet(std::pmr::memory_resource *memoryResource)
+    : x{memoryResource}, y{memoryResource}, offsets{memoryResource}
+{
+    offsets.push_back(0);
+}
+
+PolylineSet PolylineSet::fromPolygons(const std::vector<std::vector<PointF>> &polygons,
+                                      std::pmr::memory_resource *memoryResource)
+{
+    size_t numVertices = 0;
+    for (const std::vector<PointF> &polygon : polygons)
+    {
+        numVertices += polygon.size();
+    }
+
+    PolylineSet polylines{memoryResource};
+    polylines.reserve(polygons.size(), numVertices);
+    for (const std::vector<PointF> &polygon : polygons)
+    {
+        polylines.beginPolyline();
+        for (PointF vertex : polygon)
+        {
+            polylines.appendVertex(vertex);
+        }
+    }
+    return polylines;
+}
+
+std::vector<std::vector<PointF>> PolylineSet::toPolygons() const
+{
+    std::vector<std::vector<PointF>> polygons;
+    polygons.reserve(getNumPolylines());
+    for (size_t i = 0; i < getNumPolylines(); i++)
+    {
+        std::vector<PointF> polygon;
+        polygon.reserve(getPolylineSize(i));
+        for (uint32_t j = offsets[i]; j < offsets[i + 1]; j++)
+        {
+            polygon.push_back({x[j], y[j]});
+        }
+        polygons.emplace_back(std::move(polygon));
+    }
+    return polygons;
+}
+
+void PolylineSet::clear()
+{
+    x.clear();
+    y.clear();
+    offsets.clear();
+    offsets.push_back(0);
+}
+
+void PolylineSet::reserve(size_t numPolylines, size_t numVertices)
+{
+    x.reserve(numVertices);
+    y.reserve(numVertices);
+    offsets.reserve(numPolylines + 1);
+}
+
+void PolylineSet::beginPolyline()
+{
+    offsets.push_back(static_cast<uint32_t>(x.size()));
+}
+
+void PolylineSet::appendVertex(float vertexX, float vertexY)
+{
+    assert(getNumPolylines() > 0 && "beginPolyline() has to be called before appending vertices");
+    x.push_back(vertexX);
+    y.push_back(vertexY);
+    offsets.back() = static_cast<uint32_t>(x.size());
+}
+
+void PolylineSet::appendVertex(PointF point)
+{
+    appendVertex(point.x, point.y);
+}
+
+void PolylineSet::appendPolyline(const float *polylineX, const float *polylineY, size_t numPoints)
+{
+    x.insert(x.end(), polylineX, polylineX + numPoints);
+    y.insert(y.end(), polylineY, polylineY + numPoints);
+    offsets.push_back(static_cast<uint32_t>(x.size()));
+}
+
+void PolylineSet::appendPolylines(const PolylineSet &other)
+{
+    appendPolylines(other, 0, other.getNumPolylines());
+}
+
+void PolylineSet::appendPolylines(const PolylineSet &other, size_t firstPolyline, size_t numPolylines)
+{
+    uint32_t otherBegin = other.offsets[firstPolyline];
+    uint32_t otherEnd = other.offsets[firstPolyline + numPolylines];
+    auto base = static_cast<uint32_t>(x.size());
+
+    x.insert(x.end(), other.x.begin() + otherBegin, other.x.begin() + otherEnd);
+    y.insert(y.end(), other.y.begin() + otherBegin, other.y.begin() + otherEnd);
+    for (size_t i = firstPolyline + 1; i <= firstPolyline + numPolylines; i++)
+    {
+        offsets.push_back(base + other.offsets[i] - otherBegin);
+    }
+}
+
+void PolylineSet::splitPolylines(const uint8_t *splitBefore)
+{
+    std::pmr::vector<uint32_t> splitOffsets{offsets.get_allocator()};
+    splitOffsets.reserve(offsets.size());
+    splitOffsets.push_back(0);
+
+    for (size_t i = 0; i < getNumPolylines(); i++)
+    {
+        for (uint32_t j = offsets[i] + 1; j < offsets[i + 1]; j++)
+        {
+            if (splitBefore[j])
+            {
+                splitOffsets.push_back(j);
+            }
+        }
+        splitOffsets.push_back(offsets[i + 1]);
+    }
+
+    offsets.swap(splitOffsets);
+}
+
+size_t PolylineSet::getNumPolylines() const
+{
+    return offsets.size() - 1;
+}
+
+size_t PolylineSet::getNumVertices() const
+{
+    return x.size();
+}
+
+bool PolylineSet::empty() const
+{
+    return getNumPolylines() == 0;
+}
+
+uint32_t PolylineSet::getPolylineBegin(size_t polyline) const
+{
+    return offsets[polyline];
+}
+
+uint32_t PolylineSet::getPolylineSize(size_t polyline) const
+{
+    return offsets[polyline + 1] - offsets[polyline];
+}
+
+PointF PolylineSet::getVertex(size_t index) const
+{
+    return {x[index], y[index]};
+}
+
+float *PolylineSet::getX()
+{
+    return x.data();
+}
+
+float *PolylineSet::getY()
+{
+    return y.data();
+}
+
+const float *PolylineSet::getX() const
+{
+    return x.data();
+}
+
+const float *PolylineSet::getY() const
+{
+    return y.data();
+}
+
+const std::pmr::vector<uint32_t> &PolylineSet::getOffsets() const
+{
+    return offsets;
+}
+
+std::pmr::memory_resource *PolylineSet::getMemoryResource() const
+{
+    return offsets.get_allocator().resource();
+}
+
+} // namespace Met3D
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file PolylineSet.h
+/// \brief This file declares the PolylineSet class, a flat container for 2D polylines used by GeometryHandling.
+///
+/// A PolylineSet stores the vertices of all polylines in one contiguous x and one contiguous y array and marks the
+/// polylines by an offset table. The arrays are allocated from a polymorphic memory resource, so that the stages of
+/// the geometry pipeline can share a reusable arena instead of allocating every polyline individually.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace Met3D
+{
+
+struct PointF;
+
+///
+/// \class PolylineSet
+/// \brief Structure-of-arrays container for a set of 2D polylines.
+///
+/// Polyline i consists of the vertices in the range [getOffsets()[i], getOffsets()[i + 1]) of the coordinate arrays.
+/// The offset table always starts with 0 and has getNumPolylines() + 1 entries. Empty polylines are allowed.
+///
+class PolylineSet
+{
+  public:
+    explicit PolylineSet(std::pmr::memory_resource *memoryResource = std::pmr::get_default_resource());
+
+    ///
+    /// \brief Creates a PolylineSet from the nested representation used by the vector based GeometryHandling methods.
+    ///
+    static PolylineSet fromPolygons(const std::vector<std::vector<PointF>> &polygons,
+                                    std::pmr::memory_resource *memoryResource = std::pmr::get_default_resource());
+
+    ///
+    /// \brief Converts the PolylineSet to the nested representation used by the vector based GeometryHandling methods.
+    ///
+    [[nodiscard]] std::vector<std::vector<PointF>> toPolygons() const;
+
+    ///
+    /// \brief Removes all polylines. The allocated memory is kept for reuse.
+    ///
+    void clear();
+
+    void reserve(size_t numPolylines, size_t numVertices);
+
+    ///
+    /// \brief Starts a new, empty polyline. Subsequent calls of appendVertex() add vertices to it.
+    ///
+    void beginPolyline();
+
+    ///
+    /// \brief Appends a vertex to the last polyline. beginPolyline() has to be called before the first vertex.
+    ///
+    void appendVertex(float x, float y);
+    void appendVertex(PointF point);
+
+    ///
+    /// \brief Appends a polyline with numPoints vertices given by separate coordinate arrays.
+    ///
+    void appendPolyline(const float *x, const float *y, size_t numPoints);
+
+    ///
+    /// \brief Appends all polylines of other.
+    ///
+    void appendPolylines(const PolylineSet &other);
+
+    ///
+    /// \brief Appends the polylines [firstPolyline, firstPolyline + numPolylines) of other.
+    ///
+    void appendPolylines(const PolylineSet &other, size_t firstPolyline, size_t numPolylines);
+
+    ///
+    /// \brief Splits the polylines in place.
+    ///
+    /// A new polyline is started at every vertex i for which splitBefore[i] is non-zero, unless the vertex already is
+    /// the first vertex of its polyline. The vertex arrays are not modified, only the offset table is rebuilt.
+    ///
+    /// \param splitBefore Array with one entry per vertex.
+    ///
+    void splitPolylines(const uint8_t *splitBefore);
+
+    [[nodiscard]] size_t getNumPolylines() const;
+    [[nodiscard]] size_t getNumVertices() const;
+    [[nodiscard]] bool empty() const;
+
+    [[nodiscard]] uint32_t getPolylineBegin(size_t polyline) const;
+    [[nodiscard]] uint32_t getPolylineSize(size_t polyline) const;
+    [[nodiscard]] PointF getVertex(size_t index) const;
+
+    [[nodiscard]] float *getX();
+    [[nodiscard]] float *getY();
+    [[nodiscard]] const float *getX() const;
+    [[nodiscard]] const float *getY() const;
+    [[nodiscard]] const std::pmr::vector<uint32_t> &getOffsets() const;
+    [[nodiscard]] std::pmr::memory_resource *getMemoryResource() const;
+
+  private:
+    std::pmr::vector<float> x;
+    std::pmr::vector<float> y;
+    std::pmr::vector<uint32_t> offsets;
+};
+
+} // namespace Met3D
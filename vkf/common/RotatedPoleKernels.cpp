@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file RotatedPoleKernels.cpp
+/// \brief This file implements the scalar rotated pole kernels and the runtime selection of the SIMD kernels.
+///
+/// The scalar kernels are the reference implementation of the rotated lon-lat projection, see GeometryHandling.cpp for
+/// the origin of the formulas. The SIMD kernels are implemented in RotatedPoleKernelsSse4.cpp and
+/// RotatedPoleKernelsAvx2.cpp.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "RotatedPoleKernels.h"
+#include "CpuFeatures.h"
+#include "Log.h"
+#include "SimdMath.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Met3D
+{
+
+static const double DEG2RAD = SimdMath::PI / 180.0;
+static const double RAD2DEG = 180.0 / SimdMath::PI;
+
+RotatedPoleParameters::RotatedPoleParameters(double poleLon, double poleLat)
+    : poleLonRad{DEG2RAD * poleLon}, sinPoleLat{std::sin(DEG2RAD * poleLat)}, cosPoleLat{std::cos(DEG2RAD * poleLat)},
+      sinPoleLon{std::sin(DEG2RAD * poleLon)}, cosPoleLon{std::cos(DEG2RAD * poleLon)}
+{
+}
+
+static void geographicalToRotatedScalar(const RotatedPoleParameters &pole, const float *inLon, const float *inLat,
+                                        float *outLon, float *outLat, size_t numPoints)
+{
+    for (size_t i = 0; i < numPoints; i++)
+    {
+        double lon = inLon[i];
+        double lat = inLat[i];
+
+        if (lon > 180.0)
+        {
+            lon -= 360.0;
+        }
+
+        double lonRad = DEG2RAD * lon;
+        double latRad = DEG2RAD * lat;
+
+        double x = ((-pole.sinPoleLat) * std::cos(latRad) * std::cos(lonRad - pole.poleLonRad)) + (pole.cosPoleLat * std::sin(latRad));
+        double y = (-std::sin(lonRad - pole.poleLonRad)) * std::cos(latRad);
+        double z = (pole.cosPoleLat * std::cos(latRad) * std::cos(lonRad - pole.poleLonRad)) + (pole.sinPoleLat * std::sin(latRad));
+
+        // Avoid invalid values for z (Might occure due to inaccuracies in
+        // computations).
+        z = std::max(-1., std::min(1., z));
+
+        // Too small values can lead to numerical problems in method atans2.
+        if (std::abs(x) < 1.0e-20)
+        {
+            x = 1.0e-20;
+        }
+
+        outLon[i] = static_cast<float>(RAD2DEG * (std::atan2(y, x)));
+        outLat[i] = static_cast<float>(RAD2DEG * (std::asin(z)));
+    }
+}
+
+static void rotatedToGeographicalScalar(const RotatedPoleParameters &pole, const float *inLon, const float *inLat,
+                                        float *outLon, float *outLat, size_t numPoints)
+{
+    for (size_t i = 0; i < numPoints; i++)
+    {
+        double resultLon = 0.;
+
+        double rotLon = inLon[i];
+        double rotLat = inLat[i];
+
+        if (rotLon > 180.0)
+        {
+            rotLon -= 360.0;
+        }
+
+        double rotLonRad = DEG2RAD * rotLon;
+        double sinRotLatRad = std::sin(DEG2RAD * rotLat);
+        double cosRotLatRad = std::cos(DEG2RAD * rotLat);
+        double cosRotLonRad = std::cos(rotLonRad);
+
+        double x = (pole.cosPoleLon *
+                    (((-pole.sinPoleLat) * cosRotLonRad * cosRotLatRad) + (pole.cosPoleLat * sinRotLatRad))) +
+                   (pole.sinPoleLon * std::sin(rotLonRad) * cosRotLatRad);
+        double y = (pole.sinPoleLon *
+                    (((-pole.sinPoleLat) * cosRotLonRad * cosRotLatRad) + (pole.cosPoleLat * sinRotLatRad))) -
+                   (pole.cosPoleLon * std::sin(rotLonRad) * cosRotLatRad);
+        double z = pole.cosPoleLat * cosRotLatRad * cosRotLonRad + pole.sinPoleLat * sinRotLatRad;
+
+        // Avoid invalid values for z (Might occure due to inaccuracies in
+        // computations).
+        z = std::max(-1., std::min(1., z));
+
+        if (std::abs(x) > 0)
+        {
+            resultLon = RAD2DEG * std::atan2(y, x);
+        }
+        if (std::abs(resultLon) < 9.e-14)
+        {
+            resultLon = 0.;
+        }
+
+        outLon[i] = static_cast<float>(resultLon);
+        outLat[i] = static_cast<float>(RAD2DEG * (std::asin(z)));
+    }
+}
+
+const RotatedPoleKernels &getScalarRotatedPoleKernels()
+{
+    static const RotatedPoleKernels kernels{"scalar", geographicalToRotatedScalar, rotatedToGeographicalScalar};
+    return kernels;
+}
+
+const RotatedPoleKernels &getRotatedPoleKernels()
+{
+    static const RotatedPoleKernels *kernels = []() {
+        const RotatedPoleKernels *selected = &getScalarRotatedPoleKernels();
+#ifdef MET3D_ROTATED_POLE_KERNELS_X86
+        if (cpuSupportsAvx2())
+        {
+            selected = &getAvx2RotatedPoleKernels();
+        }
+        else if (cpuSupportsSse4())
+        {
+            selected = &getSse4RotatedPoleKernels();
+        }
+#endif
+        LOG_DEBUG("Using {} kernels for rotated lon-lat projections", selected->name)
+        return selected;
+    }();
+    return *kernels;
+}
+
+} // namespace Met3D
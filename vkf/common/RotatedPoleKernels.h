@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file RotatedPoleKernels.h
+/// \brief This file declares the batch kernels for the rotated lon-lat projection used by GeometryHandling.
+///
+/// The kernels convert contiguous arrays of longitudes and latitudes between geographical and rotated coordinates. A
+/// scalar reference implementation is always available, SSE4.1 and AVX2 implementations are selected at runtime if the
+/// CPU supports them.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CpuFeatures.h"
+
+#include <cstddef>
+
+namespace Met3D
+{
+
+///
+/// \struct RotatedPoleParameters
+/// \brief Precomputed terms of the rotated north pole that are shared by all points of a batch.
+///
+struct RotatedPoleParameters
+{
+    explicit RotatedPoleParameters(double poleLon, double poleLat);
+
+    double poleLonRad;
+    double sinPoleLat;
+    double cosPoleLat;
+    double sinPoleLon;
+    double cosPoleLon;
+};
+
+///
+/// \brief Signature of a rotated pole kernel.
+///
+/// Transforms numPoints points given by (inLon[i], inLat[i]) into (outLon[i], outLat[i]). Coordinates are in degrees,
+/// input and output arrays may be identical.
+///
+using RotatedPoleKernel = void (*)(const RotatedPoleParameters &pole, const float *inLon, const float *inLat,
+                                   float *outLon, float *outLat, size_t numPoints);
+
+///
+/// \struct RotatedPoleKernels
+/// \brief Set of kernels for one instruction set.
+///
+struct RotatedPoleKernels
+{
+    const char *name;
+    RotatedPoleKernel geographicalToRotated;
+    RotatedPoleKernel rotatedToGeographical;
+};
+
+///
+/// \brief Returns the scalar reference kernels, which use the C library trigonometric functions.
+///
+const RotatedPoleKernels &getScalarRotatedPoleKernels();
+
+///
+/// \brief Returns the fastest kernels supported by the CPU.
+///
+/// The CPU features are queried once on the first call. The SIMD kernels use the approximations in SimdMath.h and
+/// produce the same float results as the scalar reference, up to one unit in the last place. The only exception are
+/// points that are mapped exactly onto a pole, where the longitude is undefined and may differ.
+///
+const RotatedPoleKernels &getRotatedPoleKernels();
+
+#ifdef MET3D_CPU_X86
+#define MET3D_ROTATED_POLE_KERNELS_X86 1
+const RotatedPoleKernels &getSse4RotatedPoleKernels();
+const RotatedPoleKernels &getAvx2RotatedPoleKernels();
+#endif
+
+} // namespace Met3D
@@ -0,0 +1,33 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file RotatedPoleKernelsAvx2.cpp
+/// \brief This file implements the AVX2 rotated pole kernels.
+///
+/// The file is compiled with AVX2 and FMA enabled (see vkf/CMakeLists.txt) and must not include headers with inline
+/// functions that are also used by other translation units, otherwise the linker might pick an AVX2 version of them.
+/// Four points are processed per iteration in double precision.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "RotatedPoleKernels.h"
+
+#ifdef MET3D_ROTATED_POLE_KERNELS_X86
+
+#include "RotatedPoleKernelsSimd.h"
+#include "SimdVectorAvx2.h"
+
+namespace Met3D
+{
+
+const RotatedPoleKernels &getAvx2RotatedPoleKernels()
+{
+    static const RotatedPoleKernels kernels{"AVX2", geographicalToRotatedSimd<VecD>, rotatedToGeographicalSimd<VecD>};
+    return kernels;
+}
+
+} // namespace Met3D
+
+#endif
@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file RotatedPoleKernelsSimd.h
+/// \brief This file implements the rotated pole kernels as templates over a SIMD vector wrapper type.
+///
+/// The templates are only meant to be included by the ISA specific translation units (RotatedPoleKernelsSse4.cpp and
+/// RotatedPoleKernelsAvx2.cpp). Besides the functions required by SimdMath.h, the vector type V has to provide the
+/// lane count V::width, V::load and V::store for float arrays as well as minimum and maximum. The computations mirror
+/// the scalar reference kernels in RotatedPoleKernels.cpp operation by operation.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RotatedPoleKernels.h"
+#include "SimdMath.h"
+
+namespace Met3D
+{
+
+namespace RotatedPoleSimd
+{
+
+constexpr double DEG2RAD = SimdMath::PI / 180.0;
+constexpr double RAD2DEG = 180.0 / SimdMath::PI;
+
+template <class V>
+inline void geographicalToRotatedBlock(const RotatedPoleParameters &pole, const float *inLon, const float *inLat,
+                                       float *outLon, float *outLat)
+{
+    V lon = V::load(inLon);
+    V lat = V::load(inLat);
+
+    lon = select(cmpGt(lon, V{180.0}), lon - V{360.0}, lon);
+
+    V lonRad = V{DEG2RAD} * lon;
+    V latRad = V{DEG2RAD} * lat;
+
+    V sinLat{0.0}, cosLat{0.0}, sinDeltaLon{0.0}, cosDeltaLon{0.0};
+    SimdMath::sinCos(latRad, &sinLat, &cosLat);
+    SimdMath::sinCos(lonRad - V{pole.poleLonRad}, &sinDeltaLon, &cosDeltaLon);
+
+    V x = (V{-pole.sinPoleLat} * cosLat * cosDeltaLon) + (V{pole.cosPoleLat} * sinLat);
+    V y = (-sinDeltaLon) * cosLat;
+    V z = (V{pole.cosPoleLat} * cosLat * cosDeltaLon) + (V{pole.sinPoleLat} * sinLat);
+
+    z = maximum(V{-1.0}, minimum(V{1.0}, z));
+    x = select(cmpLt(abs(x), V{1.0e-20}), V{1.0e-20}, x);
+
+    (V{RAD2DEG} * SimdMath::atan2(y, x)).store(outLon);
+    (V{RAD2DEG} * SimdMath::asin(z)).store(outLat);
+}
+
+template <class V>
+inline void rotatedToGeographicalBlock(const RotatedPoleParameters &pole, const float *inLon, const float *inLat,
+                                       float *outLon, float *outLat)
+{
+    V rotLon = V::load(inLon);
+    V rotLat = V::load(inLat);
+
+    rotLon = select(cmpGt(rotLon, V{180.0}), rotLon - V{360.0}, rotLon);
+
+    V sinRotLonRad{0.0}, cosRotLonRad{0.0}, sinRotLatRad{0.0}, cosRotLatRad{0.0};
+    SimdMath::sinCos(V{DEG2RAD} * rotLon, &sinRotLonRad, &cosRotLonRad);
+    SimdMath::sinCos(V{DEG2RAD} * rotLat, &sinRotLatRad, &cosRotLatRad);
+
+    V t = (V{-pole.sinPoleLat} * cosRotLonRad * cosRotLatRad) + (V{pole.cosPoleLat} * sinRotLatRad);
+    V x = (V{pole.cosPoleLon} * t) + (V{pole.sinPoleLon} * sinRotLonRad * cosRotLatRad);
+    V y = (V{pole.sinPoleLon} * t) - (V{pole.cosPoleLon} * sinRotLonRad * cosRotLatRad);
+    V z = V{pole.cosPoleLat} * cosRotLatRad * cosRotLonRad + V{pole.sinPoleLat} * sinRotLatRad;
+
+    z = maximum(V{-1.0}, minimum(V{1.0}, z));
+
+    V resultLon = V{RAD2DEG} * SimdMath::atan2(y, x);
+    resultLon = select(cmpGt(abs(x), V{0.0}), resultLon, V{0.0});
+    resultLon = select(cmpLt(abs(resultLon), V{9.e-14}), V{0.0}, resultLon);
+
+    resultLon.store(outLon);
+    (V{RAD2DEG} * SimdMath::asin(z)).store(outLat);
+}
+
+///
+/// \brief Runs a block kernel over all points, the remainder is processed in a zero padded block.
+///
+template <class V, void (*Block)(const RotatedPoleParameters &, const float *, const float *, float *, float *)>
+inline void runBlocks(const RotatedPoleParameters &pole, const float *inLon, const float *inLat, float *outLon,
+                      float *outLat, size_t numPoints)
+{
+    size_t i = 0;
+    for (; i + V::width <= numPoints; i += V::width)
+    {
+        Block(pole, inLon + i, inLat + i, outLon + i, outLat + i);
+    }
+
+    if (i < numPoints)
+    {
+        float lon[V::width] = {};
+        float lat[V::width] = {};
+        size_t remaining = numPoints - i;
+        for (size_t j = 0; j < remaining; j++)
+        {
+            lon[j] = inLon[i + j];
+            lat[j] = inLat[i + j];
+        }
+        Block(pole, lon, lat, lon, lat);
+        for (size_t j = 0; j < remaining; j++)
+        {
+            outLon[i + j] = lon[j];
+            outLat[i + j] = lat[j];
+        }
+    }
+}
+
+} // namespace RotatedPoleSimd
+
+template <class V>
+void geographicalToRotatedSimd(const RotatedPoleParameters &pole, const float *inLon, const float *inLat,
+                               float *outLon, float *outLat, size_t numPoints)
+{
+    RotatedPoleSimd::runBlocks<V, RotatedPoleSimd::geographicalToRotatedBlock<V>>(pole, inLon, inLat, outLon, outLat,
+                                                                                  numPoints);
+}
+
+template <class V>
+void rotatedToGeographicalSimd(const RotatedPoleParameters &pole, const float *inLon, const float *inLat,
+                               float *outLon, float *outLat, size_t numPoints)
+{
+    RotatedPoleSimd::runBlocks<V, RotatedPoleSimd::rotatedToGeographicalBlock<V>>(pole, inLon, inLat, outLon, outLat,
+                                                                                  numPoints);
+}
+
+} // namespace Met3D
@@ -0,0 +1,33 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file RotatedPoleKernelsSse4.cpp
+/// \brief This file implements the SSE4.1 rotated pole kernels.
+///
+/// The file is compiled with SSE4.1 enabled (see vkf/CMakeLists.txt) and must not include headers with inline
+/// functions that are also used by other translation units, otherwise the linker might pick an SSE4.1 version of them.
+/// Two points are processed per iteration in double precision.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "RotatedPoleKernels.h"
+
+#ifdef MET3D_ROTATED_POLE_KERNELS_X86
+
+#include "RotatedPoleKernelsSimd.h"
+#include "SimdVectorSse4.h"
+
+namespace Met3D
+{
+
+const RotatedPoleKernels &getSse4RotatedPoleKernels()
+{
+    static const RotatedPoleKernels kernels{"SSE4.1", geographicalToRotatedSimd<VecD>, rotatedToGeographicalSimd<VecD>};
+    return kernels;
+}
+
+} // namespace Met3D
+
+#endif
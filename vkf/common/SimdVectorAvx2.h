@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file SimdVectorAvx2.h
+/// \brief This file implements the AVX2 vector wrapper used by the SIMD geometry kernels.
+///
+/// VecD holds four double precision lanes and provides the operations required by SimdMath.h. The header may
+/// only be included by translation units that are compiled with AVX2 and FMA enabled (see vkf/CMakeLists.txt). Its
+/// functions are defined in an unnamed namespace, so that every translation unit gets its own copy and the linker
+/// cannot mix them up with functions compiled for another instruction set.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <immintrin.h>
+
+namespace Met3D
+{
+
+namespace
+{
+
+struct VecD
+{
+    static constexpr size_t width = 4;
+
+    VecD(__m256d value) : v{value}
+    {
+    }
+    explicit VecD(double value) : v{_mm256_set1_pd(value)}
+    {
+    }
+
+    static VecD load(const float *p)
+    {
+        return _mm256_cvtps_pd(_mm_loadu_ps(p));
+    }
+    void store(float *p) const
+    {
+        _mm_storeu_ps(p, _mm256_cvtpd_ps(v));
+    }
+    static VecD load(const double *p)
+    {
+        return _mm256_loadu_pd(p);
+    }
+    void store(double *p) const
+    {
+        _mm256_storeu_pd(p, v);
+    }
+
+    __m256d v;
+};
+
+inline VecD operator+(VecD a, VecD b)
+{
+    return _mm256_add_pd(a.v, b.v);
+}
+
+inline VecD operator-(VecD a, VecD b)
+{
+    return _mm256_sub_pd(a.v, b.v);
+}
+
+inline VecD operator*(VecD a, VecD b)
+{
+    return _mm256_mul_pd(a.v, b.v);
+}
+
+inline VecD operator/(VecD a, VecD b)
+{
+    return _mm256_div_pd(a.v, b.v);
+}
+
+inline VecD operator-(VecD a)
+{
+    return _mm256_xor_pd(a.v, _mm256_set1_pd(-0.0));
+}
+
+inline VecD fmadd(VecD a, VecD b, VecD c)
+{
+    return _mm256_fmadd_pd(a.v, b.v, c.v);
+}
+
+inline VecD abs(VecD a)
+{
+    return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v);
+}
+
+inline VecD sqrt(VecD a)
+{
+    return _mm256_sqrt_pd(a.v);
+}
+
+inline VecD roundNearest(VecD a)
+{
+    return _mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+inline VecD floor(VecD a)
+{
+    return _mm256_floor_pd(a.v);
+}
+
+inline VecD minimum(VecD a, VecD b)
+{
+    return _mm256_min_pd(a.v, b.v);
+}
+
+inline VecD maximum(VecD a, VecD b)
+{
+    return _mm256_max_pd(a.v, b.v);
+}
+
+inline VecD cmpLt(VecD a, VecD b)
+{
+    return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ);
+}
+
+inline VecD cmpGt(VecD a, VecD b)
+{
+    return _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ);
+}
+
+inline VecD cmpEq(VecD a, VecD b)
+{
+    return _mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ);
+}
+
+inline VecD maskOr(VecD a, VecD b)
+{
+    return _mm256_or_pd(a.v, b.v);
+}
+
+inline VecD maskAndNot(VecD a, VecD b)
+{
+    return _mm256_andnot_pd(a.v, b.v);
+}
+
+inline VecD select(VecD mask, VecD a, VecD b)
+{
+    return _mm256_blendv_pd(b.v, a.v, mask.v);
+}
+
+inline VecD bitAnd(VecD a, VecD b)
+{
+    return _mm256_and_pd(a.v, b.v);
+}
+
+inline VecD bitOr(VecD a, VecD b)
+{
+    return _mm256_or_pd(a.v, b.v);
+}
+
+// Splits a positive normal number into a mantissa in [0.5, 1) and its exponent, like std::frexp.
+inline VecD frexp(VecD a, VecD *exponent)
+{
+    // The biased exponent is converted to double by placing it in the mantissa of 2^52.
+    __m256i bits = _mm256_castpd_si256(a.v);
+    __m256d twoPow52 = _mm256_set1_pd(4503599627370496.0);
+    __m256i biased = _mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_castpd_si256(twoPow52));
+    *exponent = _mm256_sub_pd(_mm256_sub_pd(_mm256_castsi256_pd(biased), twoPow52), _mm256_set1_pd(1022.0));
+    __m256i mantissa = _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFF));
+    return _mm256_castsi256_pd(_mm256_or_si256(mantissa, _mm256_set1_epi64x(0x3FE0000000000000)));
+}
+
+// Multiplies a by 2^exponent for integral exponents in [-1022, 1023], like std::ldexp.
+inline VecD ldexp(VecD a, VecD exponent)
+{
+    // Adding 2^52 + 1023 moves the biased exponent into the low mantissa bits.
+    __m256d biased = _mm256_add_pd(exponent.v, _mm256_set1_pd(4503599627370496.0 + 1023.0));
+    __m256d scale = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(biased), 52));
+    return _mm256_mul_pd(a.v, scale);
+}
+
+} // namespace
+
+} // namespace Met3D
@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file SimdVectorSse4.h
+/// \brief This file implements the SSE4.1 vector wrapper used by the SIMD geometry kernels.
+///
+/// VecD holds two double precision lanes and provides the operations required by SimdMath.h. The header may
+/// only be included by translation units that are compiled with SSE4.1 enabled (see vkf/CMakeLists.txt). Its
+/// functions are defined in an unnamed namespace, so that every translation unit gets its own copy and the linker
+/// cannot mix them up with functions compiled for another instruction set.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <smmintrin.h>
+
+namespace Met3D
+{
+
+namespace
+{
+
+struct VecD
+{
+    static constexpr size_t width = 2;
+
+    VecD(__m128d value) : v{value}
+    {
+    }
+    explicit VecD(double value) : v{_mm_set1_pd(value)}
+    {
+    }
+
+    static VecD load(const float *p)
+    {
+        return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p))));
+    }
+    void store(float *p) const
+    {
+        _mm_storel_pi(reinterpret_cast<__m64 *>(p), _mm_cvtpd_ps(v));
+    }
+    static VecD load(const double *p)
+    {
+        return _mm_loadu_pd(p);
+    }
+    void store(double *p) const
+    {
+        _mm_storeu_pd(p, v);
+    }
+
+    __m128d v;
+};
+
+inline VecD operator+(VecD a, VecD b)
+{
+    return _mm_add_pd(a.v, b.v);
+}
+
+inline VecD operator-(VecD a, VecD b)
+{
+    return _mm_sub_pd(a.v, b.v);
+}
+
+inline VecD operator*(VecD a, VecD b)
+{
+    return _mm_mul_pd(a.v, b.v);
+}
+
+inline VecD operator/(VecD a, VecD b)
+{
+    return _mm_div_pd(a.v, b.v);
+}
+
+inline VecD operator-(VecD a)
+{
+    return _mm_xor_pd(a.v, _mm_set1_pd(-0.0));
+}
+
+inline VecD fmadd(VecD a, VecD b, VecD c)
+{
+    return _mm_add_pd(_mm_mul_pd(a.v, b.v), c.v);
+}
+
+inline VecD abs(VecD a)
+{
+    return _mm_andnot_pd(_mm_set1_pd(-0.0), a.v);
+}
+
+inline VecD sqrt(VecD a)
+{
+    return _mm_sqrt_pd(a.v);
+}
+
+inline VecD roundNearest(VecD a)
+{
+    return _mm_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+inline VecD floor(VecD a)
+{
+    return _mm_floor_pd(a.v);
+}
+
+inline VecD minimum(VecD a, VecD b)
+{
+    return _mm_min_pd(a.v, b.v);
+}
+
+inline VecD maximum(VecD a, VecD b)
+{
+    return _mm_max_pd(a.v, b.v);
+}
+
+inline VecD cmpLt(VecD a, VecD b)
+{
+    return _mm_cmplt_pd(a.v, b.v);
+}
+
+inline VecD cmpGt(VecD a, VecD b)
+{
+    return _mm_cmpgt_pd(a.v, b.v);
+}
+
+inline VecD cmpEq(VecD a, VecD b)
+{
+    return _mm_cmpeq_pd(a.v, b.v);
+}
+
+inline VecD maskOr(VecD a, VecD b)
+{
+    return _mm_or_pd(a.v, b.v);
+}
+
+inline VecD maskAndNot(VecD a, VecD b)
+{
+    return _mm_andnot_pd(a.v, b.v);
+}
+
+inline VecD select(VecD mask, VecD a, VecD b)
+{
+    return _mm_blendv_pd(b.v, a.v, mask.v);
+}
+
+inline VecD bitAnd(VecD a, VecD b)
+{
+    return _mm_and_pd(a.v, b.v);
+}
+
+inline VecD bitOr(VecD a, VecD b)
+{
+    return _mm_or_pd(a.v, b.v);
+}
+
+// Splits a positive normal number into a mantissa in [0.5, 1) and its exponent, like std::frexp.
+inline VecD frexp(VecD a, VecD *exponent)
+{
+    // The biased exponent is converted to double by placing it in the mantissa of 2^52.
+    __m128i bits = _mm_castpd_si128(a.v);
+    __m128d twoPow52 = _mm_set1_pd(4503599627370496.0);
+    __m128i biased = _mm_or_si128(_mm_srli_epi64(bits, 52), _mm_castpd_si128(twoPow52));
+    *exponent = _mm_sub_pd(_mm_sub_pd(_mm_castsi128_pd(biased), twoPow52), _mm_set1_pd(1022.0));
+    __m128i mantissa = _mm_and_si128(bits, _mm_set1_epi64x(0x000FFFFFFFFFFFFF));
+    return _mm_castsi128_pd(_mm_or_si128(mantissa, _mm_set1_epi64x(0x3FE0000000000000)));
+}
+
+// Multiplies a by 2^exponent for integral exponents in [-1022, 1023], like std::ldexp.
+inline VecD ldexp(VecD a, VecD exponent)
+{
+    // Adding 2^52 + 1023 moves the biased exponent into the low mantissa bits.
+    __m128d biased = _mm_add_pd(exponent.v, _mm_set1_pd(4503599627370496.0 + 1023.0));
+    __m128d scale = _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(biased), 52));
+    return _mm_mul_pd(a.v, scale);
+}
+
+} // namespace
+
+} // namespace Met3D
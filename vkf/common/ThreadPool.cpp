@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file ThreadPool.cpp
+/// \brief This file implements the ThreadPool class, which runs independent tasks on a fixed set of worker threads.
+///
+/// The ThreadPool class is part of the vkf namespace. It is used to parallelize CPU heavy work such as the projection
+/// and clipping of map geometry.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace vkf
+{
+
+ThreadPool::ThreadPool(uint32_t numThreads)
+{
+    for (uint32_t i = 1; i < numThreads; i++)
+    {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)> &task)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    if (workers.empty() || count == 1)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> dispatchLock(dispatchMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->task = &task;
+        this->count = count;
+        nextIteration = 0;
+        activeWorkers = workers.size();
+        firstException = nullptr;
+        generation++;
+    }
+    wakeCondition.notify_all();
+
+    runIterations();
+
+    std::exception_ptr exception;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCondition.wait(lock, [this] { return activeWorkers == 0; });
+        this->task = nullptr;
+        exception = firstException;
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+uint32_t ThreadPool::getNumThreads() const
+{
+    return static_cast<uint32_t>(workers.size()) + 1;
+}
+
+ThreadPool &ThreadPool::getShared()
+{
+    static ThreadPool pool{std::max(1u, std::thread::hardware_concurrency())};
+    return pool;
+}
+
+void ThreadPool::workerLoop()
+{
+    uint64_t finishedGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&] { return stopping || generation != finishedGeneration; });
+            if (stopping)
+            {
+                return;
+            }
+            finishedGeneration = generation;
+        }
+
+        runIterations();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            activeWorkers--;
+        }
+        doneCondition.notify_one();
+    }
+}
+
+void ThreadPool::runIterations()
+{
+    size_t i;
+    while ((i = nextIteration.fetch_add(1)) < count)
+    {
+        try
+        {
+            (*task)(i);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!firstException)
+            {
+                firstException = std::current_exception();
+            }
+        }
+    }
+}
+
+} // namespace vkf
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file ThreadPool.h
+/// \brief This file declares the ThreadPool class, which runs independent tasks on a fixed set of worker threads.
+///
+/// The ThreadPool class is part of the vkf namespace. It is used to parallelize CPU heavy work such as the projection
+/// and clipping of map geometry.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vkf
+{
+
+///
+/// \class ThreadPool
+/// \brief This class manages a set of worker threads that execute the iterations of a parallel loop.
+///
+/// The calling thread takes part in the execution of a parallel loop, so a pool with n threads creates n - 1 worker
+/// threads. Parallel loops are executed one after another.
+///
+class ThreadPool
+{
+  public:
+    ///
+    /// \brief Constructor that starts the worker threads.
+    ///
+    /// \param numThreads The number of threads that execute a parallel loop, including the calling thread.
+    ///
+    explicit ThreadPool(uint32_t numThreads);
+    ThreadPool(const ThreadPool &) = delete;            ///< Deleted copy constructor
+    ThreadPool(ThreadPool &&) = delete;                 ///< Deleted move constructor
+    ThreadPool &operator=(const ThreadPool &) = delete; ///< Deleted copy assignment operator
+    ThreadPool &operator=(ThreadPool &&) = delete;      ///< Deleted move assignment operator
+    ~ThreadPool();                                      ///< Destructor
+
+    ///
+    /// \brief Executes task(i) for all i in [0, count) and returns once all iterations have finished.
+    ///
+    /// The iterations are distributed dynamically, so their order of execution is undefined. If an iteration throws an
+    /// exception, the remaining iterations are still executed and the first exception is rethrown afterwards.
+    ///
+    void parallelFor(size_t count, const std::function<void(size_t)> &task);
+
+    [[nodiscard]] uint32_t getNumThreads() const;
+
+    ///
+    /// \brief Returns a pool shared by the whole application, which uses one thread per hardware thread.
+    ///
+    static ThreadPool &getShared();
+
+  private:
+    void workerLoop();
+    void runIterations();
+
+    std::vector<std::thread> workers;
+
+    std::mutex dispatchMutex; // serializes calls of parallelFor
+    std::mutex mutex;         // protects the state of the current loop
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+
+    const std::function<void(size_t)> *task{nullptr};
+    size_t count{0};
+    std::atomic<size_t> nextIteration{0};
+    size_t activeWorkers{0};
+    uint64_t generation{0};
+    bool stopping{false};
+    std::exception_ptr firstException;
+};
+
+} // namespace vkf
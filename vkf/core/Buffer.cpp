@@ -12,14 +12,14 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Buffer.h"
-#include "CommandPool.h"
 #include "Device.h"
+#include "UploadManager.h"
 
 namespace vkf::core
 {
 
 Buffer::Buffer(const Device &device, vk::BufferCreateInfo createInfo, VmaAllocationCreateFlags allocationFlags)
-    : device{device}
+    : device{device}, size{static_cast<uint32_t>(createInfo.size)}
 {
     VmaAllocationCreateInfo allocationCreateInfo{};
     allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
@@ -27,6 +27,13 @@ Buffer::Buffer(const Device &device, vk::BufferCreateInfo createInfo, VmaAllocat
 
     persistentMapped = (allocationFlags & VMA_ALLOCATION_CREATE_MAPPED_BIT) != 0;
 
+    // Descriptors in a descriptor buffer reference uniform and storage buffers by their device address.
+    if (device.hasDescriptorBuffer() &&
+        (createInfo.usage & (vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eStorageBuffer)))
+    {
+        createInfo.usage |= vk::BufferUsageFlagBits::eShaderDeviceAddress;
+    }
+
     VmaAllocationInfo allocationInfo{};
     auto result = vmaCreateBuffer(device.getVmaAllocator(), reinterpret_cast<const VkBufferCreateInfo *>(&createInfo),
                                   &allocationCreateInfo, &handle, &allocation, &allocationInfo);
@@ -107,17 +114,14 @@ void Buffer::updateData(const void *data, const uint32_t size, const uint32_t of
 
 void Buffer::copyBuffer(const Buffer &srcBuffer)
 {
-    auto &cmd = device.getCommandBuffers()->at(0);
-
-    cmd.begin(vk::CommandBufferBeginInfo{.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
-
-    vk::BufferCopy copyRegion{.srcOffset = 0, .dstOffset = 0, .size = srcBuffer.getSize()};
-    cmd.copyBuffer(srcBuffer.getBuffer(), this->getBuffer(), copyRegion);
-    cmd.end();
+    copyBuffer(srcBuffer, 0, 0, srcBuffer.getSize());
+}
 
-    auto &queue = device.getQueueWithFlags(0, vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eTransfer).getHandle();
-    queue.submit(vk::SubmitInfo{.commandBufferCount = 1, .pCommandBuffers = &(*cmd)}, nullptr);
-    queue.waitIdle();
+void Buffer::copyBuffer(const Buffer &srcBuffer, vk::DeviceSize srcOffset, vk::DeviceSize dstOffset,
+                        vk::DeviceSize size)
+{
+    auto &uploads = device.getUploadManager();
+    uploads.wait(uploads.copyBuffer(srcBuffer, *this, srcOffset, dstOffset, size));
 }
 
 vk::Buffer Buffer::getBuffer() const
@@ -125,6 +129,17 @@ vk::Buffer Buffer::getBuffer() const
     return {handle};
 }
 
+vk::DeviceAddress Buffer::getDeviceAddress() const
+{
+    return device.getHandle().getBufferAddress(vk::BufferDeviceAddressInfo{.buffer = handle});
+}
+
+void *Buffer::getMappedData() const
+{
+    assert(persistentMapped && "Only persistently mapped buffers provide access to their memory");
+    return mappedData;
+}
+
 uint32_t Buffer::getSize() const
 {
     return size;
@@ -60,6 +60,13 @@ class Buffer
 
     void updateData(const void *data, const uint32_t size, const uint32_t offset);
 
+    ///
+    /// \brief Returns the pointer to the mapped memory of a persistently mapped buffer.
+    ///
+    /// This allows writing data directly into the buffer, e.g. to convert it while filling a staging buffer.
+    ///
+    [[nodiscard]] void *getMappedData() const;
+
     ///
     /// \brief Copies the contents of the srcBuffer to this buffer.
     ///
@@ -70,7 +77,19 @@ class Buffer
     ///
     void copyBuffer(const Buffer &srcBuffer);
 
+    ///
+    /// \brief Copies size bytes starting at srcOffset of the srcBuffer to dstOffset of this buffer.
+    ///
+    /// The copy is submitted together with the pending uploads of the UploadManager, and only its fence is waited for.
+    ///
+    void copyBuffer(const Buffer &srcBuffer, vk::DeviceSize srcOffset, vk::DeviceSize dstOffset, vk::DeviceSize size);
+
     [[nodiscard]] vk::Buffer getBuffer() const;
+
+    ///
+    /// \brief Returns the device address of a uniform or storage buffer, see Device::hasDescriptorBuffer().
+    ///
+    [[nodiscard]] vk::DeviceAddress getDeviceAddress() const;
     [[nodiscard]] uint32_t getSize() const;
 
   private:
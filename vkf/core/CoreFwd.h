@@ -14,6 +14,8 @@ class Buffer;
 class CommandPool;
 class Device;
 class Framebuffer;
+class GeometryAllocation;
+class GeometryArena;
 class Image;
 class Instance;
 class PhysicalDevice;
@@ -22,4 +24,5 @@ class Queue;
 class RenderPass;
 class Shader;
 class Swapchain;
+class UploadManager;
 } // namespace vkf::core
\ No newline at end of file
@@ -14,8 +14,10 @@
 #include "Device.h"
 #include "../common/Log.h"
 #include "CommandPool.h"
+#include "GeometryArena.h"
 #include "Instance.h"
 #include "PhysicalDevice.h"
+#include "UploadManager.h"
 
 #define VMA_IMPLEMENTATION
 #define VMA_STATIC_VULKAN_FUNCTIONS 0
@@ -26,7 +28,8 @@
 
 namespace vkf::core
 {
-Device::Device(Instance &instance, vk::raii::SurfaceKHR &surface, const std::vector<const char *> &requiredExtensions)
+Device::Device(Instance &instance, vk::raii::SurfaceKHR &surface, const std::vector<const char *> &requiredExtensions,
+               bool preferDescriptorBuffer)
     : surface{surface}, gpu{instance.getSuitableGpu(surface)}
 {
     LOG_INFO("Picked GPU: {}", gpu.getProperties().deviceName.data())
@@ -34,6 +37,10 @@ Device::Device(Instance &instance, vk::raii::SurfaceKHR &surface, const std::vec
     availableExtensions = gpu.getHandle().enumerateDeviceExtensionProperties();
     validateExtensions(requiredExtensions);
     enableExtension("VK_KHR_portability_subset"); // only necessary for macOS and MoltenVK
+    if (preferDescriptorBuffer)
+    {
+        enableDescriptorBuffer();
+    }
 
     auto feature = gpu.requestExtensionFeatures<vk::PhysicalDeviceDescriptorIndexingFeatures>();
     assert(feature.shaderSampledImageArrayNonUniformIndexing &&
@@ -65,7 +72,7 @@ Device::Device(Instance &instance, vk::raii::SurfaceKHR &surface, const std::vec
 
     createVmaAllocator(instance, gpu);
 
-    // This commandPool could use an exclusive transfer queue instead. But that would require queue ownership transfer
+    // One-time commands on the graphics queue. Uploads use the UploadManager, which prefers a transfer-only queue.
     commandPool = std::make_unique<CommandPool>(
         *this,
         vk::CommandPoolCreateInfo{
@@ -73,16 +80,71 @@ Device::Device(Instance &instance, vk::raii::SurfaceKHR &surface, const std::vec
             .queueFamilyIndex = getQueueWithFlags(0, vk::QueueFlagBits::eGraphics, vk::QueueFlags()).getFamilyIndex()});
 
     commandBuffers = commandPool->requestCommandBuffers(vk::CommandBufferLevel::ePrimary, 1).second;
+
+    uploadManager = std::make_unique<UploadManager>(*this);
+    geometryArena = std::make_unique<GeometryArena>(*this);
 }
 
 Device::~Device()
 {
+    // The staging buffers of the UploadManager have to be destroyed before the allocator. The UploadManager goes
+    // first, its pending releases return ranges to the GeometryArena.
+    uploadManager.reset();
+    geometryArena.reset();
     if (vmaAllocator)
     {
         vmaDestroyAllocator(vmaAllocator);
     }
 }
 
+void Device::enableDescriptorBuffer()
+{
+    if (!enableExtension(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME))
+    {
+        return;
+    }
+
+    auto features = gpu.getHandle()
+                        .getFeatures2KHR<vk::PhysicalDeviceFeatures2KHR, vk::PhysicalDeviceDescriptorBufferFeaturesEXT,
+                                      vk::PhysicalDeviceBufferDeviceAddressFeatures>();
+    if (!features.get<vk::PhysicalDeviceDescriptorBufferFeaturesEXT>().descriptorBuffer ||
+        !features.get<vk::PhysicalDeviceBufferDeviceAddressFeatures>().bufferDeviceAddress)
+    {
+        LOG_WARN("Device does not support descriptor buffers, falling back to descriptor sets")
+        enabledExtensions.pop_back();
+        return;
+    }
+
+    // The BindlessManager packs the combined image samplers into a single array of the descriptor buffer. Devices that
+    // need separate image and sampler arrays for them use descriptor sets.
+    auto properties = gpu.getHandle()
+                          .getProperties2KHR<vk::PhysicalDeviceProperties2KHR,
+                                             vk::PhysicalDeviceDescriptorBufferPropertiesEXT>()
+                          .get<vk::PhysicalDeviceDescriptorBufferPropertiesEXT>();
+    if (!properties.combinedImageSamplerDescriptorSingleArray)
+    {
+        LOG_WARN("Device cannot store combined image samplers in a single descriptor buffer array, falling back to "
+                 "descriptor sets")
+        enabledExtensions.pop_back();
+        return;
+    }
+
+    // Only the features that are used are enabled, capture and replay may slow down the driver.
+    auto &descriptorBufferFeatures = gpu.requestExtensionFeatures<vk::PhysicalDeviceDescriptorBufferFeaturesEXT>();
+    descriptorBufferFeatures.descriptorBufferCaptureReplay = VK_FALSE;
+    descriptorBufferFeatures.descriptorBufferImageLayoutIgnored = VK_FALSE;
+    descriptorBufferFeatures.descriptorBufferPushDescriptors = VK_FALSE;
+    auto &bufferDeviceAddressFeatures = gpu.requestExtensionFeatures<vk::PhysicalDeviceBufferDeviceAddressFeatures>();
+    bufferDeviceAddressFeatures.bufferDeviceAddressCaptureReplay = VK_FALSE;
+    bufferDeviceAddressFeatures.bufferDeviceAddressMultiDevice = VK_FALSE;
+    descriptorBufferEnabled = true;
+}
+
+bool Device::hasDescriptorBuffer() const
+{
+    return descriptorBufferEnabled;
+}
+
 void Device::validateExtensions(const std::vector<const char *> &requiredExtensions)
 {
     for (auto extension : requiredExtensions)
@@ -208,6 +270,10 @@ void Device::createVmaAllocator(const Instance &instance, const PhysicalDevice &
     vmaCreteInfo.vulkanApiVersion = VK_API_VERSION_1_3;
     vmaCreteInfo.pVulkanFunctions = &vulkanFunctions;
     vmaCreteInfo.flags = VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+    if (descriptorBufferEnabled)
+    {
+        vmaCreteInfo.flags |= VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
+    }
 
     // Create VMA allocator
     VkResult result = vmaCreateAllocator(&vmaCreteInfo, &vmaAllocator);
@@ -238,6 +304,16 @@ vk::raii::CommandBuffers *Device::getCommandBuffers() const
     return commandBuffers;
 }
 
+UploadManager &Device::getUploadManager() const
+{
+    return *uploadManager;
+}
+
+GeometryArena &Device::getGeometryArena() const
+{
+    return *geometryArena;
+}
+
 Queue const &Device::getQueue(uint32_t queueIndex, uint32_t familyIndex) const
 {
     return queues[familyIndex][queueIndex];
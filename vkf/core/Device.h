@@ -40,8 +40,10 @@ class Device
     /// \param instance The Vulkan instance.
     /// \param surface The Vulkan surface.
     /// \param requiredExtensions A vector of required extensions (optional).
+    /// \param preferDescriptorBuffer Enables VK_EXT_descriptor_buffer if the GPU supports it (optional).
     ///
-    Device(Instance &instance, vk::raii::SurfaceKHR &surface, const std::vector<const char *> &requiredExtensions = {});
+    Device(Instance &instance, vk::raii::SurfaceKHR &surface, const std::vector<const char *> &requiredExtensions = {},
+           bool preferDescriptorBuffer = false);
 
     Device(const Device &) = delete;            ///< Deleted copy constructor
     Device(Device &&) noexcept = default;       ///< Default move constructor
@@ -124,6 +126,13 @@ class Device
     ///
     [[nodiscard]] bool hasQueueWithPresent(uint32_t queueIndex, vk::QueueFlags excludeFlags = vk::QueueFlags()) const;
 
+    ///
+    /// \brief Checks if VK_EXT_descriptor_buffer and buffer device addresses are enabled.
+    ///
+    /// The BindlessManager then writes its descriptors into a descriptor buffer instead of a descriptor set.
+    ///
+    [[nodiscard]] bool hasDescriptorBuffer() const;
+
     [[nodiscard]] const VmaAllocator &getVmaAllocator() const;
     [[nodiscard]] const vk::raii::Device &getHandle() const;
     [[nodiscard]] const PhysicalDevice &getPhysicalDevice() const;
@@ -138,6 +147,25 @@ class Device
     ///
     [[nodiscard]] vk::raii::CommandBuffers *getCommandBuffers() const;
 
+    ///
+    /// \brief Getter for the UploadManager.
+    ///
+    /// The UploadManager uploads buffer and image data without waiting for the GPU. Its uploads are submitted by the
+    /// RenderManager before each frame.
+    ///
+    /// \return A reference to the UploadManager.
+    ///
+    [[nodiscard]] UploadManager &getUploadManager() const;
+
+    ///
+    /// \brief Getter for the GeometryArena.
+    ///
+    /// The GeometryArena suballocates the vertex and index data of meshes from a few large buffers.
+    ///
+    /// \return A reference to the GeometryArena.
+    ///
+    [[nodiscard]] GeometryArena &getGeometryArena() const;
+
   private:
     void createQueuesInfos();
     void createQueues();
@@ -165,8 +193,14 @@ class Device
     ///
     bool enableExtension(const char *requiredExtensionName);
 
+    ///
+    /// \brief Enables VK_EXT_descriptor_buffer and the features it requires, if they are available.
+    ///
+    void enableDescriptorBuffer();
+
     std::vector<const char *> enabledExtensions;
     std::vector<vk::ExtensionProperties> availableExtensions;
+    bool descriptorBufferEnabled{false};
 
     vk::raii::Device handle{VK_NULL_HANDLE};
 
@@ -179,5 +213,7 @@ class Device
 
     std::unique_ptr<CommandPool> commandPool;
     vk::raii::CommandBuffers *commandBuffers;
+    std::unique_ptr<UploadManager> uploadManager;
+    std::unique_ptr<GeometryArena> geometryArena;
 };
 } // namespace vkf::core
\ No newline at end of file
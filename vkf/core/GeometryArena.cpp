@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file GeometryArena.cpp
+/// \brief This file implements the GeometryArena class which suballocates vertex and index data from large buffers.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GeometryArena.h"
+#include "../common/Log.h"
+#include "Buffer.h"
+#include "Device.h"
+#include "UploadManager.h"
+
+namespace vkf::core
+{
+
+GeometryAllocation::GeometryAllocation(GeometryAllocation &&other) noexcept
+    : arena{other.arena}, pool{other.pool}, block{other.block}, allocation{other.allocation}, offset{other.offset},
+      size{other.size}, elementSize{other.elementSize}
+{
+    // Invalidate the source object
+    other.arena = nullptr;
+}
+
+GeometryAllocation &GeometryAllocation::operator=(GeometryAllocation &&other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+        arena = other.arena;
+        pool = other.pool;
+        block = other.block;
+        allocation = other.allocation;
+        offset = other.offset;
+        size = other.size;
+        elementSize = other.elementSize;
+        other.arena = nullptr;
+    }
+    return *this;
+}
+
+GeometryAllocation::~GeometryAllocation()
+{
+    reset();
+}
+
+GeometryAllocation::operator bool() const
+{
+    return arena != nullptr;
+}
+
+const Buffer &GeometryAllocation::getBuffer() const
+{
+    assert(arena && "Allocation is empty");
+    return *arena->pools[pool].blocks[block].buffer;
+}
+
+vk::DeviceSize GeometryAllocation::getOffset() const
+{
+    return offset;
+}
+
+vk::DeviceSize GeometryAllocation::getSize() const
+{
+    return size;
+}
+
+uint32_t GeometryAllocation::getFirstElement() const
+{
+    return offset / elementSize;
+}
+
+void GeometryAllocation::reset()
+{
+    if (arena)
+    {
+        arena->free(*this);
+        arena = nullptr;
+    }
+}
+
+GeometryArena::GeometryArena(const Device &device) : device{device}
+{
+    pools[vertexPool].usage = vk::BufferUsageFlagBits::eVertexBuffer;
+    pools[indexPool].usage = vk::BufferUsageFlagBits::eIndexBuffer;
+}
+
+GeometryArena::~GeometryArena() = default;
+
+GeometryAllocation GeometryArena::allocateVertices(vk::DeviceSize size, uint32_t vertexSize)
+{
+    return allocate(vertexPool, size, vertexSize);
+}
+
+GeometryAllocation GeometryArena::allocateIndices(uint32_t indexCount)
+{
+    return allocate(indexPool, vk::DeviceSize{indexCount} * sizeof(uint32_t), sizeof(uint32_t));
+}
+
+GeometryAllocation GeometryArena::allocate(uint32_t poolIndex, vk::DeviceSize size, uint32_t elementSize)
+{
+    if (size == 0)
+    {
+        return {};
+    }
+
+    // The range is padded, so that its start can be aligned to the element size. Vertex sizes are not necessarily
+    // powers of two, e.g. 12 bytes for vec3 vertices.
+    vk::DeviceSize paddedSize = size + elementSize - 1;
+    if (paddedSize > std::numeric_limits<uint32_t>::max())
+    {
+        throw std::runtime_error{"Geometry allocation exceeds 4 GiB"};
+    }
+
+    Pool &pool = pools[poolIndex];
+    OffsetAllocator::Allocation allocation;
+    uint32_t blockIndex = 0;
+    for (; blockIndex < pool.blocks.size(); blockIndex++)
+    {
+        if (pool.blocks[blockIndex].allocator)
+        {
+            allocation = pool.blocks[blockIndex].allocator->allocate(static_cast<uint32_t>(paddedSize));
+            if (allocation.isValid())
+            {
+                break;
+            }
+        }
+    }
+    if (!allocation.isValid())
+    {
+        // Blocks for larger ranges are rounded up to the bin size of the range, an allocator cannot hand out its
+        // whole range otherwise.
+        vk::DeviceSize newBlockSize = OffsetAllocator::roundUpToBinSize(static_cast<uint32_t>(paddedSize));
+        if (newBlockSize > std::numeric_limits<uint32_t>::max())
+        {
+            throw std::runtime_error{"Geometry allocation exceeds 4 GiB"};
+        }
+        blockIndex = createBlock(pool, std::max(blockSize, static_cast<uint32_t>(newBlockSize)));
+        allocation = pool.blocks[blockIndex].allocator->allocate(static_cast<uint32_t>(paddedSize));
+        if (!allocation.isValid())
+        {
+            throw std::runtime_error{"Failed to allocate geometry range from a new arena block"};
+        }
+    }
+
+    GeometryAllocation result;
+    result.arena = this;
+    result.pool = poolIndex;
+    result.block = blockIndex;
+    result.allocation = allocation;
+    result.offset = (allocation.offset + elementSize - 1) / elementSize * elementSize;
+    result.size = static_cast<uint32_t>(size);
+    result.elementSize = elementSize;
+    return result;
+}
+
+uint32_t GeometryArena::createBlock(Pool &pool, uint32_t size)
+{
+    // The entries of destroyed blocks are reused, so that the block indices of live allocations stay valid.
+    auto it = std::find_if(pool.blocks.begin(), pool.blocks.end(), [](const Block &block) { return !block.buffer; });
+    if (it == pool.blocks.end())
+    {
+        it = pool.blocks.emplace(pool.blocks.end());
+    }
+
+    vk::BufferCreateInfo bufferCreateInfo{
+        .size = size,
+        .usage = pool.usage | vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst};
+    it->buffer = std::make_unique<Buffer>(device, bufferCreateInfo, VmaAllocationCreateFlags{0});
+    it->allocator = std::make_unique<OffsetAllocator>(size);
+    LOG_DEBUG("Created geometry arena block of {} MiB", size / (1024 * 1024))
+    return static_cast<uint32_t>(it - pool.blocks.begin());
+}
+
+void GeometryArena::free(const GeometryAllocation &allocation)
+{
+    uint32_t poolIndex = allocation.pool;
+    uint32_t blockIndex = allocation.block;
+    OffsetAllocator::Allocation range = allocation.allocation;
+    device.getUploadManager().retire([this, poolIndex, blockIndex, range]() {
+        Block &block = pools[poolIndex].blocks[blockIndex];
+        block.allocator->free(range);
+        // The first block of a pool is kept for the next meshes.
+        if (blockIndex > 0 && block.allocator->getFreeSize() == block.allocator->getSize())
+        {
+            block.buffer.reset();
+            block.allocator.reset();
+        }
+    });
+}
+
+} // namespace vkf::core
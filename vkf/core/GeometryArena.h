@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file GeometryArena.h
+/// \brief This file declares the GeometryArena class which suballocates vertex and index data from large buffers.
+///
+/// The GeometryArena class is part of the vkf::core namespace. Meshes store their vertices and indices in ranges of a
+/// few large buffers instead of creating a buffer each, which keeps the number of device memory allocations small and
+/// lets consecutive draws share their vertex and index buffer bindings.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "../common/OffsetAllocator.h"
+
+// Forward declarations
+#include "CoreFwd.h"
+
+namespace vkf::core
+{
+
+class GeometryArena;
+
+///
+/// \class GeometryAllocation
+/// \brief A range of a buffer of the GeometryArena, which is freed when the allocation is destroyed.
+///
+/// The range is returned to the arena only after the frames that were submitted until then have finished, so a mesh
+/// can replace its allocation while the previous one is still drawn.
+///
+class GeometryAllocation
+{
+  public:
+    GeometryAllocation() = default;
+    GeometryAllocation(const GeometryAllocation &) = delete;
+    GeometryAllocation(GeometryAllocation &&other) noexcept;
+    GeometryAllocation &operator=(const GeometryAllocation &) = delete;
+    GeometryAllocation &operator=(GeometryAllocation &&other) noexcept;
+    ~GeometryAllocation();
+
+    [[nodiscard]] explicit operator bool() const;
+
+    [[nodiscard]] const Buffer &getBuffer() const;
+
+    ///
+    /// \brief Returns the offset of the range in bytes, which is a multiple of the element size.
+    ///
+    [[nodiscard]] vk::DeviceSize getOffset() const;
+    [[nodiscard]] vk::DeviceSize getSize() const;
+
+    ///
+    /// \brief Returns the index of the first element in the buffer, i.e. the firstVertex or firstIndex of a draw.
+    ///
+    [[nodiscard]] uint32_t getFirstElement() const;
+
+    ///
+    /// \brief Frees the range, see the class description.
+    ///
+    void reset();
+
+  private:
+    friend class GeometryArena;
+
+    GeometryArena *arena{nullptr};
+    uint32_t pool{0};
+    uint32_t block{0};
+    OffsetAllocator::Allocation allocation;
+    uint32_t offset{0};
+    uint32_t size{0};
+    uint32_t elementSize{1};
+};
+
+///
+/// \class GeometryArena
+/// \brief This class suballocates vertex and index buffer ranges from blocks of blockSize bytes.
+///
+/// Vertices and indices are allocated from separate pools of blocks. Each block is a buffer whose ranges are managed by
+/// an OffsetAllocator. A range is aligned to its element size, so a mesh can be drawn with the block bound at offset 0
+/// and the first vertex or index of its range. Allocations larger than a block get a block of their own. All blocks but
+/// the first one of a pool are destroyed as soon as they are empty again.
+///
+/// The GeometryArena is owned by the Device. Ranges are written with the UploadManager, which also delays freeing them
+/// until the GPU no longer reads them.
+///
+class GeometryArena
+{
+  public:
+    explicit GeometryArena(const Device &device);
+
+    GeometryArena(const GeometryArena &) = delete;            ///< Deleted copy constructor
+    GeometryArena(GeometryArena &&) = delete;                 ///< Deleted move constructor
+    GeometryArena &operator=(const GeometryArena &) = delete; ///< Deleted copy assignment operator
+    GeometryArena &operator=(GeometryArena &&) = delete;      ///< Deleted move assignment operator
+    ~GeometryArena();                                         ///< Destructor
+
+    ///
+    /// \brief Allocates size bytes of vertex data with vertices of vertexSize bytes.
+    ///
+    [[nodiscard]] GeometryAllocation allocateVertices(vk::DeviceSize size, uint32_t vertexSize);
+
+    ///
+    /// \brief Allocates indexCount 32 bit indices.
+    ///
+    [[nodiscard]] GeometryAllocation allocateIndices(uint32_t indexCount);
+
+  private:
+    friend class GeometryAllocation;
+
+    struct Block
+    {
+        std::unique_ptr<Buffer> buffer;
+        std::unique_ptr<OffsetAllocator> allocator;
+    };
+
+    struct Pool
+    {
+        vk::BufferUsageFlags usage;
+        std::vector<Block> blocks;
+    };
+
+    GeometryAllocation allocate(uint32_t poolIndex, vk::DeviceSize size, uint32_t elementSize);
+    uint32_t createBlock(Pool &pool, uint32_t blockSize);
+
+    ///
+    /// \brief Returns the range of allocation to its block once the frames that may draw it have finished.
+    ///
+    void free(const GeometryAllocation &allocation);
+
+    static constexpr uint32_t vertexPool = 0;
+    static constexpr uint32_t indexPool = 1;
+    static constexpr uint32_t blockSize = 64 * 1024 * 1024;
+
+    const Device &device;
+    std::array<Pool, 2> pools;
+};
+
+} // namespace vkf::core
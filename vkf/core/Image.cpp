@@ -14,6 +14,7 @@
 #include "Image.h"
 #include "Buffer.h"
 #include "Device.h"
+#include "UploadManager.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -148,11 +149,18 @@ void Image::unmapMemory()
 
 void Image::copyBufferToImage(const Buffer &srcBuffer)
 {
-    auto &cmd = device.getCommandBuffers()->at(0);
+    auto &uploads = device.getUploadManager();
+    uploads.wait(uploads.copyBufferToImage(srcBuffer, *this));
+}
 
-    cmd.begin(vk::CommandBufferBeginInfo{.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+void Image::transitionImageLayout(vk::ImageLayout newLayout)
+{
+    device.getUploadManager().transitionImageLayout(*this, newLayout);
+}
 
-    vk::BufferImageCopy copyRegion{.bufferOffset = 0,
+void Image::recordCopyBufferToImage(const vk::raii::CommandBuffer &cmd, vk::Buffer srcBuffer, vk::DeviceSize srcOffset)
+{
+    vk::BufferImageCopy copyRegion{.bufferOffset = srcOffset,
                                    .bufferRowLength = 0,
                                    .bufferImageHeight = 0,
                                    .imageSubresource =
@@ -164,20 +172,11 @@ void Image::copyBufferToImage(const Buffer &srcBuffer)
                                        },
                                    .imageOffset = vk::Offset3D{0, 0, 0},
                                    .imageExtent = vk::Extent3D{createInfo.extent.width, createInfo.extent.height, 1}};
-    cmd.copyBufferToImage(srcBuffer.getBuffer(), handle, currentLayout, copyRegion);
-    cmd.end();
-
-    auto &queue = device.getQueueWithFlags(0, vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eTransfer).getHandle();
-    queue.submit(vk::SubmitInfo{.commandBufferCount = 1, .pCommandBuffers = &(*cmd)}, nullptr);
-    queue.waitIdle();
+    cmd.copyBufferToImage(srcBuffer, handle, currentLayout, copyRegion);
 }
 
-void Image::transitionImageLayout(vk::ImageLayout newLayout)
+void Image::recordTransitionImageLayout(const vk::raii::CommandBuffer &cmd, vk::ImageLayout newLayout)
 {
-    auto &cmd = device.getCommandBuffers()->at(0);
-
-    cmd.begin(vk::CommandBufferBeginInfo{.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
-
     vk::ImageMemoryBarrier barrier{.oldLayout = currentLayout,
                                    .newLayout = newLayout,
                                    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
@@ -212,13 +211,24 @@ void Image::transitionImageLayout(vk::ImageLayout newLayout)
 
     cmd.pipelineBarrier(sourceStage, destinationStage, vk::DependencyFlags{}, {}, {}, {barrier});
 
-    cmd.end();
-
     currentLayout = newLayout;
+}
 
-    auto &queue = device.getQueueWithFlags(0, vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eTransfer).getHandle();
-    queue.submit(vk::SubmitInfo{.commandBufferCount = 1, .pCommandBuffers = &(*cmd)}, nullptr);
-    queue.waitIdle();
+vk::ImageMemoryBarrier Image::createOwnershipTransferBarrier(vk::ImageLayout newLayout, uint32_t srcQueueFamilyIndex,
+                                                             uint32_t dstQueueFamilyIndex)
+{
+    vk::ImageMemoryBarrier barrier{.oldLayout = currentLayout,
+                                   .newLayout = newLayout,
+                                   .srcQueueFamilyIndex = srcQueueFamilyIndex,
+                                   .dstQueueFamilyIndex = dstQueueFamilyIndex,
+                                   .image = handle,
+                                   .subresourceRange = {.aspectMask = vk::ImageAspectFlagBits::eColor,
+                                                        .baseMipLevel = 0,
+                                                        .levelCount = createInfo.mipLevels,
+                                                        .baseArrayLayer = 0,
+                                                        .layerCount = createInfo.arrayLayers}};
+    currentLayout = newLayout;
+    return barrier;
 }
 
 } // namespace vkf::core
\ No newline at end of file
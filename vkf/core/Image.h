@@ -63,6 +63,8 @@ class Image
     ///
     /// \brief Transition the image layout.
     ///
+    /// The transition is recorded by the UploadManager of the device and executed before the next frame.
+    ///
     /// \param newLayout The new layout for the image.
     ///
     void transitionImageLayout(vk::ImageLayout newLayout);
@@ -70,10 +72,36 @@ class Image
     ///
     /// \brief Copies the contents of the srcBuffer to this image.
     ///
+    /// Waits for the copy, so that the srcBuffer can be destroyed afterwards. Use UploadManager::uploadImage to upload
+    /// without waiting.
+    ///
     /// \param srcBuffer The buffer to copy from. Inteded to be a staging buffer.
     ///
     void copyBufferToImage(const Buffer &srcBuffer);
 
+    ///
+    /// \brief Records a transition of the image layout into cmd.
+    ///
+    /// The layout of the image is updated immediately, so the command buffer must be submitted before the image is
+    /// used in the new layout.
+    ///
+    void recordTransitionImageLayout(const vk::raii::CommandBuffer &cmd, vk::ImageLayout newLayout);
+
+    ///
+    /// \brief Records a copy of tightly packed texels starting at srcOffset of srcBuffer to the first mip level.
+    ///
+    void recordCopyBufferToImage(const vk::raii::CommandBuffer &cmd, vk::Buffer srcBuffer, vk::DeviceSize srcOffset);
+
+    ///
+    /// \brief Returns a barrier that transitions the image to newLayout and transfers it between queue families.
+    ///
+    /// The barrier has to be recorded as release operation on the source queue and as acquire operation on the
+    /// destination queue, the access masks are set by the caller. The layout of the image is updated immediately.
+    ///
+    [[nodiscard]] vk::ImageMemoryBarrier createOwnershipTransferBarrier(vk::ImageLayout newLayout,
+                                                                        uint32_t srcQueueFamilyIndex,
+                                                                        uint32_t dstQueueFamilyIndex);
+
   private:
     void createImageView(vk::ImageAspectFlags aspectFlags);
     void createSampler();
@@ -21,7 +21,8 @@ namespace vkf::core
 Pipeline::Pipeline(const Device &device, const PipelineState &state)
 {
     auto pipelineCreateInfo =
-        vk::GraphicsPipelineCreateInfo{.stageCount = static_cast<uint32_t>(state.shaderStageCreateInfos.size()),
+        vk::GraphicsPipelineCreateInfo{.flags = state.flags,
+                                       .stageCount = static_cast<uint32_t>(state.shaderStageCreateInfos.size()),
                                        .pStages = state.shaderStageCreateInfos.data(),
                                        .pVertexInputState = &state.vertexInputCreateInfo,
                                        .pInputAssemblyState = &state.inputAssemblyCreateInfo,
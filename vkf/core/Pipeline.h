@@ -26,6 +26,7 @@ namespace vkf::core
 ///
 struct PipelineState
 {
+    vk::PipelineCreateFlags flags;
     std::vector<vk::PipelineShaderStageCreateInfo> shaderStageCreateInfos;
     vk::PipelineVertexInputStateCreateInfo vertexInputCreateInfo;
     vk::PipelineInputAssemblyStateCreateInfo inputAssemblyCreateInfo;
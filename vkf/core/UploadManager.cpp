@@ -0,0 +1,479 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file UploadManager.cpp
+/// \brief This file implements the UploadManager class which uploads buffer and image data to the GPU asynchronously.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "UploadManager.h"
+#include "../common/Log.h"
+#include "Buffer.h"
+#include "CommandPool.h"
+#include "Device.h"
+#include "Image.h"
+
+#include <cstring>
+
+namespace vkf::core
+{
+
+namespace
+{
+
+const Queue &selectTransferQueue(const Device &device)
+{
+    // A transfer-only family is usually backed by the copy engines of the GPU, which run alongside the rendering.
+    vk::QueueFlags excludeFlags = vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute;
+    if (device.hasQueueWithFlags(0, vk::QueueFlagBits::eTransfer, excludeFlags))
+    {
+        return device.getQueueWithFlags(0, vk::QueueFlagBits::eTransfer, excludeFlags);
+    }
+    return device.getQueueWithFlags(0, vk::QueueFlagBits::eGraphics);
+}
+
+} // namespace
+
+UploadManager::UploadManager(const Device &device)
+    : device{device}, graphicsQueue{device.getQueueWithFlags(0, vk::QueueFlagBits::eGraphics)},
+      transferQueue{selectTransferQueue(device)},
+      ownershipTransfer{transferQueue.getFamilyIndex() != graphicsQueue.getFamilyIndex()}
+{
+    graphicsCommandPool = std::make_unique<CommandPool>(
+        device, vk::CommandPoolCreateInfo{.flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+                                          .queueFamilyIndex = graphicsQueue.getFamilyIndex()});
+    // Graphics and acquire command buffer of each slot.
+    auto *graphicsCommandBuffers =
+        graphicsCommandPool->requestCommandBuffers(vk::CommandBufferLevel::ePrimary, 2 * numSlots).second;
+
+    vk::raii::CommandBuffers *transferCommandBuffers = nullptr;
+    if (ownershipTransfer)
+    {
+        transferCommandPool = std::make_unique<CommandPool>(
+            device, vk::CommandPoolCreateInfo{.flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+                                              .queueFamilyIndex = transferQueue.getFamilyIndex()});
+        transferCommandBuffers =
+            transferCommandPool->requestCommandBuffers(vk::CommandBufferLevel::ePrimary, numSlots).second;
+        LOG_INFO("Uploading on the transfer queue family {}", transferQueue.getFamilyIndex())
+    }
+    else
+    {
+        LOG_INFO("Uploading on the graphics queue family {}, no transfer-only family found",
+                 graphicsQueue.getFamilyIndex())
+    }
+
+    slots.resize(numSlots);
+    for (uint32_t i = 0; i < numSlots; i++)
+    {
+        auto &slot = slots[i];
+        slot.graphicsCommandBuffer = &(*graphicsCommandBuffers)[2 * i];
+        slot.acquireCommandBuffer = &(*graphicsCommandBuffers)[2 * i + 1];
+        slot.transferCommandBuffer = ownershipTransfer ? &(*transferCommandBuffers)[i] : slot.graphicsCommandBuffer;
+        slot.fence = vk::raii::Fence{device.getHandle(), vk::FenceCreateInfo{}};
+        if (ownershipTransfer)
+        {
+            slot.transferSemaphore = vk::raii::Semaphore{device.getHandle(), vk::SemaphoreCreateInfo{}};
+        }
+    }
+
+    stagingRing = createStagingBuffer(stagingRingSize);
+    stagingRingData = stagingRing->getMappedData();
+}
+
+UploadManager::~UploadManager()
+{
+    waitAll();
+}
+
+std::unique_ptr<Buffer> UploadManager::createStagingBuffer(vk::DeviceSize size) const
+{
+    // The staging memory is read by both queues, e.g. by image copies on the graphics queue. Sharing it concurrently
+    // avoids ownership transfers of staging memory that is reused by the other queue.
+    std::array<uint32_t, 2> queueFamilyIndices{graphicsQueue.getFamilyIndex(), transferQueue.getFamilyIndex()};
+    vk::BufferCreateInfo bufferCreateInfo{.size = size, .usage = vk::BufferUsageFlagBits::eTransferSrc};
+    if (ownershipTransfer)
+    {
+        bufferCreateInfo.setSharingMode(vk::SharingMode::eConcurrent);
+        bufferCreateInfo.setQueueFamilyIndices(queueFamilyIndices);
+    }
+    return std::make_unique<Buffer>(device, bufferCreateInfo,
+                                    VMA_ALLOCATION_CREATE_MAPPED_BIT |
+                                        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+}
+
+StagingAllocation UploadManager::allocateStaging(vk::DeviceSize size, vk::DeviceSize alignment)
+{
+    // Begin recording first, the staging memory belongs to the slot that records the copies reading it.
+    beginRecording();
+    auto &slot = slots[currentSlot];
+
+    if (size > stagingRingSize / 2)
+    {
+        slot.dedicatedStagingBuffers.push_back(createStagingBuffer(size));
+        auto &buffer = *slot.dedicatedStagingBuffers.back();
+        return StagingAllocation{.buffer = &buffer, .offset = 0, .data = buffer.getMappedData()};
+    }
+
+    vk::DeviceSize offset = 0;
+    while (!tryAllocateRing(size, alignment, &offset))
+    {
+        // Free the oldest submission. If there is none, the recorded uploads occupy the ring and are submitted.
+        pollCompletion();
+        bool released = false;
+        for (uint32_t i = 1; i <= numSlots && !released; i++)
+        {
+            auto &oldSlot = slots[(currentSlot + i) % numSlots];
+            if (!oldSlot.recording && oldSlot.ringBytes > 0)
+            {
+                release(oldSlot);
+                released = true;
+            }
+        }
+        if (!released)
+        {
+            submit();
+            beginRecording();
+        }
+    }
+
+    return StagingAllocation{
+        .buffer = stagingRing.get(), .offset = offset, .data = static_cast<uint8_t *>(stagingRingData) + offset};
+}
+
+bool UploadManager::tryAllocateRing(vk::DeviceSize size, vk::DeviceSize alignment, vk::DeviceSize *offset)
+{
+    vk::DeviceSize alignedHead = (ringHead + alignment - 1) / alignment * alignment;
+    vk::DeviceSize skipped = alignedHead - ringHead;
+    if (alignedHead + size > stagingRingSize)
+    {
+        // Wrap around, the end of the ring stays unused until the slot is released.
+        alignedHead = 0;
+        skipped = stagingRingSize - ringHead;
+    }
+    if (ringUsed + skipped + size > stagingRingSize)
+    {
+        return false;
+    }
+
+    auto &slot = slots[currentSlot];
+    ringUsed += skipped + size;
+    ringHead = alignedHead + size;
+    slot.ringBytes += skipped + size;
+    *offset = alignedHead;
+    return true;
+}
+
+bool UploadManager::isStagingBuffer(const Buffer &buffer) const
+{
+    const auto &dedicated = slots[currentSlot].dedicatedStagingBuffers;
+    return &buffer == stagingRing.get() || std::any_of(dedicated.begin(), dedicated.end(),
+                                                       [&](const auto &staging) { return staging.get() == &buffer; });
+}
+
+UploadTicket UploadManager::copyBuffer(const Buffer &srcBuffer, const Buffer &dstBuffer, vk::DeviceSize srcOffset,
+                                       vk::DeviceSize dstOffset, vk::DeviceSize size)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    vk::BufferCopy copyRegion{.srcOffset = srcOffset, .dstOffset = dstOffset, .size = size};
+    if (!isStagingBuffer(srcBuffer))
+    {
+        // The source is owned by the graphics queue and may have been written by a copy that was recorded before,
+        // e.g. when a buffer grows. Its acquire barrier is executed before the graphics command buffer.
+        auto &cmd = getGraphicsCommandBuffer();
+        vk::MemoryBarrier barrier{.srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+                                  .dstAccessMask = vk::AccessFlagBits::eTransferRead};
+        cmd.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer,
+                            vk::DependencyFlags{}, {barrier}, {}, {});
+        cmd.copyBuffer(srcBuffer.getBuffer(), dstBuffer.getBuffer(), copyRegion);
+        return nextTicket;
+    }
+
+    getTransferCommandBuffer().copyBuffer(srcBuffer.getBuffer(), dstBuffer.getBuffer(), copyRegion);
+    if (ownershipTransfer)
+    {
+        // The transfer queue takes ownership of the destination range without an acquire, which leaves its contents
+        // undefined, and then releases it to the graphics queue. Streamed uploads write consecutive ranges.
+        auto &releases = slots[currentSlot].bufferReleases;
+        if (!releases.empty() && releases.back().buffer == dstBuffer.getBuffer() &&
+            releases.back().offset + releases.back().size == dstOffset)
+        {
+            releases.back().size += size;
+        }
+        else
+        {
+            releases.push_back(vk::BufferMemoryBarrier{.srcQueueFamilyIndex = transferQueue.getFamilyIndex(),
+                                                       .dstQueueFamilyIndex = graphicsQueue.getFamilyIndex(),
+                                                       .buffer = dstBuffer.getBuffer(),
+                                                       .offset = dstOffset,
+                                                       .size = size});
+        }
+    }
+    return nextTicket;
+}
+
+UploadTicket UploadManager::uploadBuffer(const Buffer &dstBuffer, const void *data, vk::DeviceSize size,
+                                         vk::DeviceSize dstOffset)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+    auto staging = allocateStaging(size);
+    std::memcpy(staging.data, data, size);
+    return copyBuffer(*staging.buffer, dstBuffer, staging.offset, dstOffset, size);
+}
+
+UploadTicket UploadManager::uploadImage(Image &image, const void *data, vk::DeviceSize size)
+{
+    auto staging = allocateStaging(size);
+    std::memcpy(staging.data, data, size);
+
+    auto &cmd = getTransferCommandBuffer();
+    image.recordTransitionImageLayout(cmd, vk::ImageLayout::eTransferDstOptimal);
+    image.recordCopyBufferToImage(cmd, staging.buffer->getBuffer(), staging.offset);
+    if (ownershipTransfer)
+    {
+        // The transition to the shader layout is part of the release and acquire barriers.
+        slots[currentSlot].imageReleases.push_back(image.createOwnershipTransferBarrier(
+            vk::ImageLayout::eShaderReadOnlyOptimal, transferQueue.getFamilyIndex(), graphicsQueue.getFamilyIndex()));
+    }
+    else
+    {
+        image.recordTransitionImageLayout(cmd, vk::ImageLayout::eShaderReadOnlyOptimal);
+    }
+    return nextTicket;
+}
+
+UploadTicket UploadManager::copyBufferToImage(const Buffer &srcBuffer, Image &image, vk::DeviceSize srcOffset)
+{
+    image.recordCopyBufferToImage(getGraphicsCommandBuffer(), srcBuffer.getBuffer(), srcOffset);
+    return nextTicket;
+}
+
+UploadTicket UploadManager::transitionImageLayout(Image &image, vk::ImageLayout newLayout)
+{
+    image.recordTransitionImageLayout(getGraphicsCommandBuffer(), newLayout);
+    return nextTicket;
+}
+
+void UploadManager::retire(std::shared_ptr<Buffer> buffer)
+{
+    if (buffer)
+    {
+        // The slot is submitted even if nothing else is recorded, its fence then marks the end of the earlier frames.
+        beginRecording();
+        slots[currentSlot].retiredBuffers.push_back(std::move(buffer));
+    }
+}
+
+void UploadManager::retire(std::function<void()> releaseFunction)
+{
+    beginRecording();
+    slots[currentSlot].releaseFunctions.push_back(std::move(releaseFunction));
+}
+
+UploadTicket UploadManager::submit()
+{
+    auto &slot = slots[currentSlot];
+    if (!slot.recording)
+    {
+        return nextTicket - 1;
+    }
+
+    // Make the transfers visible to all commands that are submitted to the queue afterwards, i.e. the next frame.
+    auto &graphicsCmd = *slot.graphicsCommandBuffer;
+    vk::MemoryBarrier barrier{.srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+                              .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite};
+    graphicsCmd.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands,
+                                vk::DependencyFlags{}, {barrier}, {}, {});
+    graphicsCmd.end();
+
+    device.getHandle().resetFences(*slot.fence);
+    if (ownershipTransfer)
+    {
+        submitOwnershipTransfer(slot);
+    }
+    else
+    {
+        graphicsQueue.getHandle().submit(
+            vk::SubmitInfo{.commandBufferCount = 1, .pCommandBuffers = &(*graphicsCmd)}, *slot.fence);
+    }
+
+    slot.ticket = nextTicket++;
+    slot.recording = false;
+    currentSlot = (currentSlot + 1) % numSlots;
+    return slot.ticket;
+}
+
+void UploadManager::submitOwnershipTransfer(FrameSlot &slot)
+{
+    bool hasReleases = !slot.bufferReleases.empty() || !slot.imageReleases.empty();
+
+    // Release the uploaded ranges and images on the transfer queue ...
+    auto &transferCmd = *slot.transferCommandBuffer;
+    if (hasReleases)
+    {
+        for (auto &bufferBarrier : slot.bufferReleases)
+        {
+            bufferBarrier.setSrcAccessMask(vk::AccessFlagBits::eTransferWrite);
+        }
+        for (auto &imageBarrier : slot.imageReleases)
+        {
+            imageBarrier.setSrcAccessMask(vk::AccessFlagBits::eTransferWrite);
+        }
+        transferCmd.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe,
+                                    vk::DependencyFlags{}, {}, slot.bufferReleases, slot.imageReleases);
+    }
+    transferCmd.end();
+
+    // ... and acquire them on the graphics queue with the same barriers, except for the access masks.
+    auto &acquireCmd = *slot.acquireCommandBuffer;
+    acquireCmd.begin(vk::CommandBufferBeginInfo{.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+    if (hasReleases)
+    {
+        for (auto &bufferBarrier : slot.bufferReleases)
+        {
+            bufferBarrier.setSrcAccessMask(vk::AccessFlagBits::eNone);
+            bufferBarrier.setDstAccessMask(vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite);
+        }
+        for (auto &imageBarrier : slot.imageReleases)
+        {
+            imageBarrier.setSrcAccessMask(vk::AccessFlagBits::eNone);
+            imageBarrier.setDstAccessMask(vk::AccessFlagBits::eShaderRead);
+        }
+        acquireCmd.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eAllCommands,
+                                   vk::DependencyFlags{}, {}, slot.bufferReleases, slot.imageReleases);
+    }
+    acquireCmd.end();
+    slot.bufferReleases.clear();
+    slot.imageReleases.clear();
+
+    transferQueue.getHandle().submit(vk::SubmitInfo{.commandBufferCount = 1,
+                                                    .pCommandBuffers = &(*transferCmd),
+                                                    .signalSemaphoreCount = 1,
+                                                    .pSignalSemaphores = &(*slot.transferSemaphore)});
+
+    // The acquire command buffer runs first, so the graphics command buffer may use the uploaded resources.
+    std::array<vk::CommandBuffer, 2> commandBuffers{*acquireCmd, **slot.graphicsCommandBuffer};
+    vk::PipelineStageFlags waitStage = vk::PipelineStageFlagBits::eAllCommands;
+    graphicsQueue.getHandle().submit(vk::SubmitInfo{.waitSemaphoreCount = 1,
+                                                    .pWaitSemaphores = &(*slot.transferSemaphore),
+                                                    .pWaitDstStageMask = &waitStage,
+                                                    .commandBufferCount = static_cast<uint32_t>(commandBuffers.size()),
+                                                    .pCommandBuffers = commandBuffers.data()},
+                                     *slot.fence);
+}
+
+bool UploadManager::isComplete(UploadTicket ticket)
+{
+    if (ticket > completedTicket && ticket < nextTicket)
+    {
+        pollCompletion();
+    }
+    return ticket <= completedTicket;
+}
+
+void UploadManager::wait(UploadTicket ticket)
+{
+    if (ticket <= completedTicket)
+    {
+        return;
+    }
+    if (ticket >= nextTicket)
+    {
+        submit();
+    }
+
+    // Submissions finish in order, so the slots are released from the oldest one until the ticket is reached.
+    for (uint32_t i = 0; i < numSlots && completedTicket < ticket; i++)
+    {
+        auto &slot = slots[(currentSlot + i) % numSlots];
+        if (!slot.recording)
+        {
+            release(slot);
+        }
+    }
+}
+
+void UploadManager::waitAll()
+{
+    wait(submit());
+}
+
+void UploadManager::beginRecording()
+{
+    auto &slot = slots[currentSlot];
+    if (!slot.recording)
+    {
+        // Normally the submission of the slot has finished long ago, because it was submitted numSlots frames ago.
+        release(slot);
+        vk::CommandBufferBeginInfo beginInfo{.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit};
+        slot.graphicsCommandBuffer->begin(beginInfo);
+        if (ownershipTransfer)
+        {
+            slot.transferCommandBuffer->begin(beginInfo);
+        }
+        slot.recording = true;
+    }
+}
+
+vk::raii::CommandBuffer &UploadManager::getTransferCommandBuffer()
+{
+    beginRecording();
+    return *slots[currentSlot].transferCommandBuffer;
+}
+
+vk::raii::CommandBuffer &UploadManager::getGraphicsCommandBuffer()
+{
+    beginRecording();
+    return *slots[currentSlot].graphicsCommandBuffer;
+}
+
+void UploadManager::release(FrameSlot &slot)
+{
+    if (slot.ticket > completedTicket)
+    {
+        auto result = device.getHandle().waitForFences(*slot.fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+        if (result != vk::Result::eSuccess)
+        {
+            throw std::runtime_error{"Failed to wait for upload fence"};
+        }
+        completedTicket = slot.ticket;
+    }
+
+    ringUsed -= slot.ringBytes;
+    slot.ringBytes = 0;
+    slot.dedicatedStagingBuffers.clear();
+    slot.retiredBuffers.clear();
+    for (auto &releaseFunction : slot.releaseFunctions)
+    {
+        releaseFunction();
+    }
+    slot.releaseFunctions.clear();
+}
+
+void UploadManager::pollCompletion()
+{
+    // The oldest submission is the one of the current slot, unless the current slot is recording.
+    for (uint32_t i = 0; i < numSlots; i++)
+    {
+        auto &slot = slots[(currentSlot + i) % numSlots];
+        if (slot.recording)
+        {
+            continue;
+        }
+        if (slot.ticket > completedTicket && slot.fence.getStatus() != vk::Result::eSuccess)
+        {
+            break;
+        }
+        release(slot);
+    }
+}
+
+} // namespace vkf::core
@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file UploadManager.h
+/// \brief This file declares the UploadManager class which uploads buffer and image data to the GPU asynchronously.
+///
+/// The UploadManager class is part of the vkf::core namespace. Uploads are staged in a persistently mapped ring buffer
+/// and recorded into a transfer command buffer together with the image layout transitions they need. The recorded
+/// commands are submitted once per frame before the frame itself, so an upload costs no more than a memcpy on the CPU
+/// and never waits for the GPU to become idle. If the device has a transfer-only queue family, the copies run on it and
+/// overlap the rendering.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Forward declarations
+#include "CoreFwd.h"
+
+namespace vkf::core
+{
+
+///
+/// \brief Identifies the submission an upload is part of.
+///
+/// Tickets increase with every submission, so an upload with ticket t has finished once all submissions up to t have
+/// finished. The ticket 0 refers to no upload and is always complete.
+///
+using UploadTicket = uint64_t;
+
+///
+/// \struct StagingAllocation
+/// \brief Host visible memory of the staging ring that is reserved for one upload.
+///
+struct StagingAllocation
+{
+    const Buffer *buffer{nullptr};
+    vk::DeviceSize offset{0};
+    void *data{nullptr};
+};
+
+///
+/// \class UploadManager
+/// \brief This class stages uploads in a ring buffer and submits them with one command buffer per frame.
+///
+/// Each frame slot owns a command buffer, a fence and the part of the staging ring that was written while the slot was
+/// recording. Recording into a slot begins with the first upload after its previous submission has finished, which
+/// normally is the case, because frames are submitted at the same rate. submit() is called by the RenderManager before
+/// the frame is submitted to the same queue, so the frame sees all uploads that were recorded before it. Uploads that
+/// do not fit into the ring get a dedicated staging buffer. If the ring is full, the oldest submissions are waited for.
+///
+/// Buffers and images that are replaced by an upload can be handed to retire(), they are released when the submission
+/// of the upload has finished. Its fence is signaled only after all previously submitted frames have finished, too.
+///
+/// Copies from staging memory are executed on a transfer-only queue family if the device has one. The destination
+/// buffer ranges and images are then released by the transfer queue and acquired by the graphics queue with queue
+/// family ownership transfer barriers, which are recorded when the slot is submitted. The graphics queue waits for the
+/// transfer queue with a semaphore before it executes the acquire barriers and the commands that need the graphics
+/// queue, i.e. copies from other buffers and image layout transitions. These are therefore executed after all copies
+/// from staging memory of the same submission. Without a transfer-only family, all commands are recorded into a single
+/// command buffer for the graphics queue.
+///
+/// The UploadManager is owned by the Device and must only be used from the main thread.
+///
+class UploadManager
+{
+  public:
+    explicit UploadManager(const Device &device);
+
+    UploadManager(const UploadManager &) = delete;            ///< Deleted copy constructor
+    UploadManager(UploadManager &&) = delete;                 ///< Deleted move constructor
+    UploadManager &operator=(const UploadManager &) = delete; ///< Deleted copy assignment operator
+    UploadManager &operator=(UploadManager &&) = delete;      ///< Deleted move assignment operator
+    ~UploadManager();                                         ///< Waits for all submissions
+
+    ///
+    /// \brief Reserves size bytes of staging memory, which the caller fills before recording the copy that reads it.
+    ///
+    /// The copy has to be recorded before staging memory is allocated again, because the allocation may submit the
+    /// recorded uploads to make room in the ring.
+    ///
+    StagingAllocation allocateStaging(vk::DeviceSize size, vk::DeviceSize alignment = 16);
+
+    ///
+    /// \brief Records a copy of size bytes from srcOffset of srcBuffer to dstOffset of dstBuffer.
+    ///
+    /// Both buffers must stay alive until the returned ticket is complete. If srcBuffer is staging memory, the previous
+    /// contents of the destination range are discarded, so it must not be used by submitted frames.
+    ///
+    UploadTicket copyBuffer(const Buffer &srcBuffer, const Buffer &dstBuffer, vk::DeviceSize srcOffset,
+                            vk::DeviceSize dstOffset, vk::DeviceSize size);
+
+    ///
+    /// \brief Stages size bytes of data and records their copy to dstOffset of dstBuffer.
+    ///
+    UploadTicket uploadBuffer(const Buffer &dstBuffer, const void *data, vk::DeviceSize size,
+                              vk::DeviceSize dstOffset = 0);
+
+    ///
+    /// \brief Stages the tightly packed texels of the first mip level of image and records their upload.
+    ///
+    /// The image is transitioned to eTransferDstOptimal for the copy and to eShaderReadOnlyOptimal afterwards.
+    ///
+    UploadTicket uploadImage(Image &image, const void *data, vk::DeviceSize size);
+
+    ///
+    /// \brief Records the copy of a tightly packed buffer to the first mip level of image in its current layout.
+    ///
+    /// The copy is executed on the graphics queue, like transitionImageLayout().
+    ///
+    UploadTicket copyBufferToImage(const Buffer &srcBuffer, Image &image, vk::DeviceSize srcOffset = 0);
+
+    ///
+    /// \brief Records a transition of image to newLayout.
+    ///
+    UploadTicket transitionImageLayout(Image &image, vk::ImageLayout newLayout);
+
+    ///
+    /// \brief Keeps a buffer that may still be used by submitted frames alive until the current uploads have finished.
+    ///
+    void retire(std::shared_ptr<Buffer> buffer);
+
+    ///
+    /// \brief Calls releaseFunction once the current uploads and all earlier frames have finished.
+    ///
+    /// This releases resources that are not buffers, e.g. ranges of the GeometryArena.
+    ///
+    void retire(std::function<void()> releaseFunction);
+
+    ///
+    /// \brief Submits the recorded uploads and returns their ticket.
+    ///
+    /// If nothing was recorded, the ticket of the last submission is returned.
+    ///
+    UploadTicket submit();
+
+    ///
+    /// \brief Returns whether the upload with the given ticket has finished, without blocking.
+    ///
+    [[nodiscard]] bool isComplete(UploadTicket ticket);
+
+    ///
+    /// \brief Blocks until the upload with the given ticket has finished, and submits it first if necessary.
+    ///
+    void wait(UploadTicket ticket);
+
+    ///
+    /// \brief Blocks until all uploads have finished.
+    ///
+    void waitAll();
+
+  private:
+    struct FrameSlot
+    {
+        // The transfer command buffer is the graphics command buffer if there is no transfer-only queue family.
+        vk::raii::CommandBuffer *transferCommandBuffer{nullptr};
+        vk::raii::CommandBuffer *acquireCommandBuffer{nullptr};
+        vk::raii::CommandBuffer *graphicsCommandBuffer{nullptr};
+        vk::raii::Fence fence{VK_NULL_HANDLE};
+        vk::raii::Semaphore transferSemaphore{VK_NULL_HANDLE};
+        // Ticket of the last submission of this slot, 0 if it has never been submitted.
+        UploadTicket ticket{0};
+        bool recording{false};
+        // Number of staging ring bytes written while the slot was recording, including the bytes skipped when the ring
+        // wrapped around.
+        vk::DeviceSize ringBytes{0};
+        std::vector<std::unique_ptr<Buffer>> dedicatedStagingBuffers;
+        std::vector<std::shared_ptr<Buffer>> retiredBuffers;
+        std::vector<std::function<void()>> releaseFunctions;
+        // Ownership transfer barriers of the uploads, recorded on both queues when the slot is submitted.
+        std::vector<vk::BufferMemoryBarrier> bufferReleases;
+        std::vector<vk::ImageMemoryBarrier> imageReleases;
+    };
+
+    ///
+    /// \brief Begins recording into the command buffers of the current slot if necessary.
+    ///
+    void beginRecording();
+
+    vk::raii::CommandBuffer &getTransferCommandBuffer();
+    vk::raii::CommandBuffer &getGraphicsCommandBuffer();
+
+    ///
+    /// \brief Submits the transfer command buffer of slot and its acquire and graphics command buffers after it.
+    ///
+    void submitOwnershipTransfer(FrameSlot &slot);
+
+    [[nodiscard]] std::unique_ptr<Buffer> createStagingBuffer(vk::DeviceSize size) const;
+
+    ///
+    /// \brief Waits for the submission of slot and releases its staging memory and retired buffers.
+    ///
+    void release(FrameSlot &slot);
+
+    ///
+    /// \brief Releases the resources of all slots whose submission has finished.
+    ///
+    void pollCompletion();
+
+    [[nodiscard]] bool isStagingBuffer(const Buffer &buffer) const;
+
+    bool tryAllocateRing(vk::DeviceSize size, vk::DeviceSize alignment, vk::DeviceSize *offset);
+
+    const Device &device;
+    const Queue &graphicsQueue;
+    const Queue &transferQueue;
+    // Whether the transfer queue belongs to another family than the graphics queue.
+    bool ownershipTransfer;
+
+    std::unique_ptr<CommandPool> graphicsCommandPool;
+    std::unique_ptr<CommandPool> transferCommandPool;
+    std::vector<FrameSlot> slots;
+    uint32_t currentSlot{0};
+
+    // Ticket of the next submission, given to all uploads that are recorded until then.
+    UploadTicket nextTicket{1};
+    UploadTicket completedTicket{0};
+
+    std::unique_ptr<Buffer> stagingRing;
+    void *stagingRingData{nullptr};
+    vk::DeviceSize ringHead{0};
+    vk::DeviceSize ringUsed{0};
+
+    // One slot per frame in flight, see RenderManager::framesInFlight.
+    static constexpr uint32_t numSlots = 3;
+    // Size of the staging ring. Larger uploads use a dedicated staging buffer.
+    static constexpr vk::DeviceSize stagingRingSize = 32 * 1024 * 1024;
+};
+
+} // namespace vkf::core
@@ -122,8 +122,13 @@ void Application::onEvent(Event &event)
 void Application::onUpdate()
 {
     renderManager->beginFrame();
+    bindlessManager->beginFrame(renderManager->getActiveFrame());
     scene->getCamera()->updateCameraBuffer();
     gui->preRender(*scene);
+    // After the GUI, so that the frame uniforms include this frame's changes of the components.
+    scene->updateFrameUniforms();
+    // The descriptors of the resources created during this frame are written at once, before they are drawn.
+    bindlessManager->flushDescriptorWrites();
 
     renderManager->render();
     renderManager->endFrame();
@@ -194,22 +199,14 @@ void Application::createDevice()
 {
     //    enableDeviceExtension(VK_EXT_MULTI_DRAW_EXTENSION_NAME); AMD doesn't support this extension
     enableDeviceExtension(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
-    device = std::make_unique<core::Device>(*instance, *surface, deviceExtensions);
+    // The bindless resources use a descriptor buffer where available, see BindlessManager.
+    device = std::make_unique<core::Device>(*instance, *surface, deviceExtensions, true);
 }
 
 void Application::createScene(const core::RenderPass &renderPass)
 {
-
-    vk::BufferCreateInfo bufferModelCreateInfo{.size = 64, .usage = vk::BufferUsageFlagBits::eUniformBuffer};
-    core::Buffer buffer{*device, bufferModelCreateInfo,
-                        VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT};
-    auto cameraHandle = bindlessManager->storeBuffer(buffer, vk::BufferUsageFlagBits::eUniformBuffer);
-
-    auto camera = scene::Camera{*bindlessManager, cameraHandle, 45, 1, 0.1, 1000};
-
-    auto viewProjection = camera.getViewProjectionMatrix();
-
-    bindlessManager->updateBuffer(cameraHandle, glm::value_ptr(viewProjection), sizeof(glm::mat4), 0);
+    // The camera is written to a frame uniform every frame, see onUpdate().
+    auto camera = scene::Camera{*bindlessManager, 45, 1, 0.1, 1000};
 
     scene = std::make_unique<scene::Scene>(*device, *bindlessManager, renderPass, camera);
 }
@@ -14,29 +14,16 @@
 #include "BindlessManager.h"
 #include "../common/Log.h"
 #include "../core/Device.h"
+#include "RenderManager.h"
+
+#include <cstring>
 
 namespace vkf::rendering
 {
 
-BindlessManager::BindlessManager(const core::Device &device) : device{device}
+BindlessManager::BindlessManager(const core::Device &device)
+    : device{device}, useDescriptorBuffer{device.hasDescriptorBuffer()}
 {
-    // Temporary DescriptorPool creation
-
-    // Pool Sizes
-    std::vector<vk::DescriptorPoolSize> poolSizes = {{vk::DescriptorType::eUniformBuffer, UniformCount},
-                                                     {vk::DescriptorType::eStorageBuffer, StorageCount},
-                                                     {vk::DescriptorType::eCombinedImageSampler, ImageSamplerCount}};
-
-    // Create descriptor pool
-    auto createInfo = vk::DescriptorPoolCreateInfo{
-        .flags =
-            vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind | vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
-        .maxSets = 1,
-        .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
-        .pPoolSizes = poolSizes.data(),
-    };
-    descriptorPool = vk::raii::DescriptorPool{device.getHandle(), createInfo};
-
     std::vector<vk::DescriptorSetLayoutBinding> bindings = {
         vk::DescriptorSetLayoutBinding{
             .binding = UniformBinding,
@@ -58,29 +45,64 @@ BindlessManager::BindlessManager(const core::Device &device) : device{device}
         },
     };
 
-    std::vector<vk::DescriptorBindingFlags> bindingFlags = {
-        vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind,
-        vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind,
-        vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind,
-    };
-    vk::DescriptorSetLayoutBindingFlagsCreateInfo setLayoutBindingFlagsCreateInfo{
-        .bindingCount = static_cast<uint32_t>(bindingFlags.size()),
-        .pBindingFlags = bindingFlags.data(),
-    };
-    auto descriptorSetLayoutCreateInfo = vk::DescriptorSetLayoutCreateInfo{
-        .pNext = &setLayoutBindingFlagsCreateInfo,
-        .flags = vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool,
-        .bindingCount = static_cast<uint32_t>(bindings.size()),
-        .pBindings = bindings.data(),
-    };
-    descriptorSetLayouts.emplace_back(device.getHandle(), descriptorSetLayoutCreateInfo);
+    if (useDescriptorBuffer)
+    {
+        // Descriptors in a descriptor buffer may be written at any time, so no binding flags are needed.
+        auto descriptorSetLayoutCreateInfo = vk::DescriptorSetLayoutCreateInfo{
+            .flags = vk::DescriptorSetLayoutCreateFlagBits::eDescriptorBufferEXT,
+            .bindingCount = static_cast<uint32_t>(bindings.size()),
+            .pBindings = bindings.data(),
+        };
+        descriptorSetLayouts.emplace_back(device.getHandle(), descriptorSetLayoutCreateInfo);
+        useDescriptorBuffer = createDescriptorBuffer();
+        if (!useDescriptorBuffer)
+        {
+            descriptorSetLayouts.clear();
+        }
+    }
+
+    if (!useDescriptorBuffer)
+    {
+        // Pool Sizes
+        std::vector<vk::DescriptorPoolSize> poolSizes = {
+            {vk::DescriptorType::eUniformBuffer, UniformCount},
+            {vk::DescriptorType::eStorageBuffer, StorageCount},
+            {vk::DescriptorType::eCombinedImageSampler, ImageSamplerCount}};
 
-    auto descriptorSets = vk::raii::DescriptorSets{
-        device.getHandle(),
-        vk::DescriptorSetAllocateInfo{.descriptorPool = *descriptorPool,
-                                      .descriptorSetCount = static_cast<uint32_t>(descriptorSetLayouts.size()),
-                                      .pSetLayouts = &*descriptorSetLayouts[0]}};
-    descriptorSet = std::move(descriptorSets[0]);
+        // Create descriptor pool
+        auto createInfo = vk::DescriptorPoolCreateInfo{
+            .flags = vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind |
+                     vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
+            .maxSets = 1,
+            .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+            .pPoolSizes = poolSizes.data(),
+        };
+        descriptorPool = vk::raii::DescriptorPool{device.getHandle(), createInfo};
+
+        std::vector<vk::DescriptorBindingFlags> bindingFlags = {
+            vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind,
+            vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind,
+            vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind,
+        };
+        vk::DescriptorSetLayoutBindingFlagsCreateInfo setLayoutBindingFlagsCreateInfo{
+            .bindingCount = static_cast<uint32_t>(bindingFlags.size()),
+            .pBindingFlags = bindingFlags.data(),
+        };
+        auto descriptorSetLayoutCreateInfo = vk::DescriptorSetLayoutCreateInfo{
+            .pNext = &setLayoutBindingFlagsCreateInfo,
+            .flags = vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool,
+            .bindingCount = static_cast<uint32_t>(bindings.size()),
+            .pBindings = bindings.data(),
+        };
+        descriptorSetLayouts.emplace_back(device.getHandle(), descriptorSetLayoutCreateInfo);
+
+        auto descriptorSets = vk::raii::DescriptorSets{
+            device.getHandle(),
+            vk::DescriptorSetAllocateInfo{.descriptorPool = *descriptorPool,
+                                          .descriptorSetCount = static_cast<uint32_t>(descriptorSetLayouts.size()),
+                                          .pSetLayouts = &*descriptorSetLayouts[0]}};
+        descriptorSet = std::move(descriptorSets[0]);
+    }
 
     std::vector<vk::PushConstantRange> pushConstantRanges = {
         vk::PushConstantRange{
@@ -96,106 +118,465 @@ BindlessManager::BindlessManager(const core::Device &device) : device{device}
         .pPushConstantRanges = pushConstantRanges.data(),
     };
     pipelineLayout = vk::raii::PipelineLayout{device.getHandle(), pipelineLayoutCreateInfo};
-    LOG_INFO("BindlessManager created")
+
+    createFrameUniformRing();
+    createVersionedUniforms();
+    LOG_INFO("BindlessManager created ({})", useDescriptorBuffer ? "descriptor buffer" : "descriptor set")
 }
 
-uint32_t BindlessManager::storeBuffer(core::Buffer &buffer, vk::BufferUsageFlags usage)
+bool BindlessManager::createDescriptorBuffer()
 {
-    uint32_t newHandle;
-    if (!freeHandles.empty())
+    auto properties = device.getPhysicalDevice()
+                          .getHandle()
+                          .getProperties2KHR<vk::PhysicalDeviceProperties2KHR,
+                                             vk::PhysicalDeviceDescriptorBufferPropertiesEXT>()
+                          .get<vk::PhysicalDeviceDescriptorBufferPropertiesEXT>();
+    descriptorSizes[UniformBinding] = properties.uniformBufferDescriptorSize;
+    descriptorSizes[StorageBinding] = properties.storageBufferDescriptorSize;
+    descriptorSizes[ImageSamplerBinding] = properties.combinedImageSamplerDescriptorSize;
+
+    const auto &layout = descriptorSetLayouts[0];
+    for (uint32_t binding = 0; binding < bindingOffsets.size(); binding++)
     {
-        newHandle = freeHandles.back();
-        freeHandles.pop_back();
+        bindingOffsets[binding] = layout.getBindingOffsetEXT(binding);
     }
-    else
+
+    // The combined image samplers contain samplers, so the single buffer is bound as resource and sampler descriptor
+    // buffer and has to fit into the ranges and address spaces of both.
+    vk::DeviceSize size = layout.getSizeEXT();
+    if (size > properties.maxResourceDescriptorBufferRange || size > properties.maxSamplerDescriptorBufferRange ||
+        size > properties.resourceDescriptorBufferAddressSpaceSize ||
+        size > properties.samplerDescriptorBufferAddressSpaceSize ||
+        size > properties.descriptorBufferAddressSpaceSize)
     {
-        newHandle = images.size() + buffers.size();
+        LOG_WARN("Descriptor buffer of {} bytes exceeds the device limits, falling back to descriptor sets", size)
+        return false;
     }
-    buffers.emplace(newHandle, std::move(buffer));
 
-    vk::DescriptorBufferInfo bufferInfo{
-        .buffer = buffers.at(newHandle).getBuffer(),
-        .offset = 0,
-        .range = VK_WHOLE_SIZE,
-    };
+    vk::BufferCreateInfo bufferCreateInfo{.size = size,
+                                          .usage = vk::BufferUsageFlagBits::eResourceDescriptorBufferEXT |
+                                                   vk::BufferUsageFlagBits::eSamplerDescriptorBufferEXT |
+                                                   vk::BufferUsageFlagBits::eShaderDeviceAddress};
+    descriptorBuffer = std::make_unique<core::Buffer>(device, bufferCreateInfo,
+                                                      VMA_ALLOCATION_CREATE_MAPPED_BIT |
+                                                          VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+    descriptorBufferAddress = descriptorBuffer->getDeviceAddress();
+
+    // The buffer is bound at offset 0, so its address has to satisfy the offset alignment.
+    if (descriptorBufferAddress % properties.descriptorBufferOffsetAlignment != 0)
+    {
+        LOG_WARN("Descriptor buffer address is not aligned to {} bytes, falling back to descriptor sets",
+                 properties.descriptorBufferOffsetAlignment)
+        descriptorBuffer.reset();
+        descriptorBufferAddress = 0;
+        return false;
+    }
+    return true;
+}
+
+void BindlessManager::writeDescriptor(const vk::DescriptorGetInfoEXT &info, uint32_t binding, uint32_t index)
+{
+    // The descriptors of a binding are tightly packed, starting at the offset of the binding.
+    auto *descriptorData = static_cast<uint8_t *>(descriptorBuffer->getMappedData()) + bindingOffsets[binding] +
+                           index * descriptorSizes[binding];
+    device.getHandle().getDescriptorEXT(info, descriptorSizes[binding], descriptorData);
+}
+
+void BindlessManager::createFrameUniformRing()
+{
+    uint32_t numSlots = RenderManager::framesInFlight * FrameUniformCount;
+    frameUniformBase = UniformCount - numSlots;
+
+    vk::BufferCreateInfo bufferCreateInfo{.size = vk::DeviceSize{numSlots} * FrameUniformSize,
+                                          .usage = vk::BufferUsageFlagBits::eUniformBuffer};
+    frameUniformRing = std::make_unique<core::Buffer>(device, bufferCreateInfo,
+                                                      VMA_ALLOCATION_CREATE_MAPPED_BIT |
+                                                          VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+
+    writeUniformSlots(*frameUniformRing, frameUniformBase, numSlots);
+    frameUniformOverflow.resize(RenderManager::framesInFlight);
+}
+
+void BindlessManager::createVersionedUniforms()
+{
+    // The versioned uniforms are placed right below the frame uniform ring. Slot i of frame f has the handle
+    // versionedUniformBase + f * VersionedUniformCount + i.
+    uint32_t numSlots = RenderManager::framesInFlight * VersionedUniformCount;
+    versionedUniformBase = frameUniformBase - numSlots;
+    uniformBuffers.capacity = versionedUniformBase;
+
+    vk::BufferCreateInfo bufferCreateInfo{.size = vk::DeviceSize{numSlots} * FrameUniformSize,
+                                          .usage = vk::BufferUsageFlagBits::eUniformBuffer};
+    versionedUniformBuffer = std::make_unique<core::Buffer>(device, bufferCreateInfo,
+                                                            VMA_ALLOCATION_CREATE_MAPPED_BIT |
+                                                                VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+    writeUniformSlots(*versionedUniformBuffer, versionedUniformBase, numSlots);
+
+    versionedUniformData.resize(size_t{VersionedUniformCount} * FrameUniformSize);
+    versionedUniformSizes.resize(VersionedUniformCount);
+    staleFrames.resize(VersionedUniformCount);
+}
+
+void BindlessManager::writeUniformSlots(const core::Buffer &buffer, uint32_t firstHandle, uint32_t numSlots)
+{
+    // The slots never move, so their descriptors are written once. The slot size is a multiple of every
+    // minUniformBufferOffsetAlignment, which is at most 256 bytes.
+    if (useDescriptorBuffer)
+    {
+        vk::DeviceAddress address = buffer.getDeviceAddress();
+        for (uint32_t slot = 0; slot < numSlots; slot++)
+        {
+            vk::DescriptorAddressInfoEXT addressInfo{.address = address + vk::DeviceSize{slot} * FrameUniformSize,
+                                                     .range = FrameUniformSize};
+            vk::DescriptorGetInfoEXT info{.type = vk::DescriptorType::eUniformBuffer};
+            info.data.setPUniformBuffer(&addressInfo);
+            writeDescriptor(info, UniformBinding, firstHandle + slot);
+        }
+        return;
+    }
+
+    std::vector<vk::DescriptorBufferInfo> bufferInfos(numSlots);
+    for (uint32_t slot = 0; slot < numSlots; slot++)
+    {
+        bufferInfos[slot] = vk::DescriptorBufferInfo{
+            .buffer = buffer.getBuffer(),
+            .offset = vk::DeviceSize{slot} * FrameUniformSize,
+            .range = FrameUniformSize,
+        };
+    }
 
     vk::WriteDescriptorSet write{
         .dstSet = *descriptorSet,
-        .dstArrayElement = newHandle,
-        .descriptorCount = 1,
-        .pBufferInfo = &bufferInfo,
+        .dstBinding = UniformBinding,
+        .dstArrayElement = firstHandle,
+        .descriptorCount = numSlots,
+        .descriptorType = vk::DescriptorType::eUniformBuffer,
+        .pBufferInfo = bufferInfos.data(),
     };
+    device.getHandle().updateDescriptorSets(write, nullptr);
+}
 
-    if ((usage & vk::BufferUsageFlagBits::eUniformBuffer) == vk::BufferUsageFlagBits::eUniformBuffer)
+template <typename Resource>
+uint32_t BindlessManager::insert(ResourceSlots<Resource> &slots, Resource &resource)
+{
+    uint32_t index;
+    if (!slots.freeIndices.empty())
+    {
+        index = slots.freeIndices.back();
+        slots.freeIndices.pop_back();
+    }
+    else if (slots.resources.size() < slots.capacity)
+    {
+        index = static_cast<uint32_t>(slots.resources.size());
+        slots.resources.emplace_back();
+        slots.generations.emplace_back(1);
+    }
+    else
     {
-        write.setDstBinding(UniformBinding);
-        write.setDescriptorType(vk::DescriptorType::eUniformBuffer);
+        throw std::runtime_error{"Out of bindless handles"};
     }
+    slots.resources[index].emplace(std::move(resource));
 
-    if ((usage & vk::BufferUsageFlagBits::eStorageBuffer) == vk::BufferUsageFlagBits::eStorageBuffer)
+    uint32_t handle = (slots.generations[index] << GenerationShift) | (slots.binding << IndexBits) | index;
+    pendingWrites.emplace_back(handle);
+    return handle;
+}
+
+template <typename Resource>
+Resource &BindlessManager::lookup(ResourceSlots<Resource> &slots, uint32_t handle)
+{
+    uint32_t index = getIndex(handle);
+    if (((handle >> IndexBits) & BindingMask) != slots.binding || index >= slots.resources.size() ||
+        slots.generations[index] != handle >> GenerationShift || !slots.resources[index])
     {
-        write.setDstBinding(StorageBinding);
-        write.setDescriptorType(vk::DescriptorType::eStorageBuffer);
+        throw std::runtime_error{"Invalid or stale bindless handle"};
     }
+    return *slots.resources[index];
+}
 
-    device.getHandle().updateDescriptorSets(write, nullptr);
-    return newHandle;
+template <typename Resource> void BindlessManager::erase(ResourceSlots<Resource> &slots, uint32_t handle)
+{
+    lookup(slots, handle);
+
+    // A new generation invalidates the handles of the slot, generation 0 is skipped so that no handle is 0.
+    uint32_t index = getIndex(handle);
+    slots.resources[index].reset();
+    slots.generations[index] = (slots.generations[index] + 1) & GenerationMask;
+    if (slots.generations[index] == 0)
+    {
+        slots.generations[index] = 1;
+    }
+    slots.freeIndices.emplace_back(index);
+}
+
+uint32_t BindlessManager::storeBuffer(core::Buffer &buffer, vk::BufferUsageFlags usage)
+{
+    if ((usage & vk::BufferUsageFlagBits::eStorageBuffer) == vk::BufferUsageFlagBits::eStorageBuffer)
+    {
+        return insert(storageBuffers, buffer);
+    }
+    return insert(uniformBuffers, buffer);
 }
 
 void BindlessManager::updateBuffer(uint32_t handle, const void *data, uint32_t size, uint32_t offset)
 {
-    buffers.at(handle).updateData(data, size, offset);
+    auto &slots = ((handle >> IndexBits) & BindingMask) == StorageBinding ? storageBuffers : uniformBuffers;
+    lookup(slots, handle).updateData(data, size, offset);
 }
 
 void BindlessManager::removeBuffer(uint32_t handle)
 {
-    buffers.erase(handle);
-    freeHandles.emplace_back(handle);
+    erase(((handle >> IndexBits) & BindingMask) == StorageBinding ? storageBuffers : uniformBuffers, handle);
 }
 
 uint32_t BindlessManager::storeImage(core::Image &image)
 {
-    uint32_t newHandle;
-    if (!freeHandles.empty())
+    return insert(images, image);
+}
+
+void BindlessManager::updateImage(uint32_t handle, core::Image &newImage)
+{
+    lookup(images, handle);
+    images.resources[getIndex(handle)].emplace(std::move(newImage));
+    pendingWrites.emplace_back(handle);
+}
+
+void BindlessManager::removeImage(uint32_t handle)
+{
+    erase(images, handle);
+}
+
+void BindlessManager::flushDescriptorWrites()
+{
+    if (pendingWrites.empty())
+    {
+        return;
+    }
+
+    // The infos are reserved up front, as the writes point into them.
+    std::vector<vk::DescriptorBufferInfo> bufferInfos;
+    std::vector<vk::DescriptorImageInfo> imageInfos;
+    std::vector<vk::WriteDescriptorSet> writes;
+    if (!useDescriptorBuffer)
     {
-        newHandle = freeHandles.back();
-        freeHandles.pop_back();
+        bufferInfos.reserve(pendingWrites.size());
+        imageInfos.reserve(pendingWrites.size());
+        writes.reserve(pendingWrites.size());
+    }
+
+    for (uint32_t handle : pendingWrites)
+    {
+        uint32_t index = getIndex(handle);
+        uint32_t binding = (handle >> IndexBits) & BindingMask;
+        vk::WriteDescriptorSet write{
+            .dstSet = *descriptorSet,
+            .dstBinding = binding,
+            .dstArrayElement = index,
+            .descriptorCount = 1,
+        };
+
+        if (binding == ImageSamplerBinding)
+        {
+            // Resources that were removed before their descriptor was written are skipped.
+            if (images.generations[index] != handle >> GenerationShift || !images.resources[index])
+            {
+                continue;
+            }
+            auto &image = *images.resources[index];
+            vk::DescriptorImageInfo imageInfo{
+                .sampler = image.getSampler(),
+                .imageView = image.getImageView(vk::ImageAspectFlagBits::eColor),
+                .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal,
+            };
+            if (useDescriptorBuffer)
+            {
+                vk::DescriptorGetInfoEXT info{.type = vk::DescriptorType::eCombinedImageSampler};
+                info.data.setPCombinedImageSampler(&imageInfo);
+                writeDescriptor(info, binding, index);
+                continue;
+            }
+            imageInfos.emplace_back(imageInfo);
+            write.setDescriptorType(vk::DescriptorType::eCombinedImageSampler);
+            write.setPImageInfo(&imageInfos.back());
+        }
+        else
+        {
+            auto &slots = binding == StorageBinding ? storageBuffers : uniformBuffers;
+            if (slots.generations[index] != handle >> GenerationShift || !slots.resources[index])
+            {
+                continue;
+            }
+            auto &buffer = *slots.resources[index];
+            auto descriptorType =
+                binding == StorageBinding ? vk::DescriptorType::eStorageBuffer : vk::DescriptorType::eUniformBuffer;
+            if (useDescriptorBuffer)
+            {
+                // Descriptor buffers need the exact range of the buffer instead of VK_WHOLE_SIZE.
+                vk::DescriptorAddressInfoEXT addressInfo{.address = buffer.getDeviceAddress(),
+                                                         .range = buffer.getSize()};
+                vk::DescriptorGetInfoEXT info{.type = descriptorType};
+                if (binding == StorageBinding)
+                {
+                    info.data.setPStorageBuffer(&addressInfo);
+                }
+                else
+                {
+                    info.data.setPUniformBuffer(&addressInfo);
+                }
+                writeDescriptor(info, binding, index);
+                continue;
+            }
+            bufferInfos.emplace_back(vk::DescriptorBufferInfo{
+                .buffer = buffer.getBuffer(),
+                .offset = 0,
+                .range = VK_WHOLE_SIZE,
+            });
+            write.setDescriptorType(descriptorType);
+            write.setPBufferInfo(&bufferInfos.back());
+        }
+        writes.emplace_back(write);
+    }
+
+    if (!writes.empty())
+    {
+        device.getHandle().updateDescriptorSets(writes, nullptr);
+    }
+    pendingWrites.clear();
+}
+
+void BindlessManager::bind(const vk::raii::CommandBuffer &cmd, vk::PipelineBindPoint bindPoint) const
+{
+    if (useDescriptorBuffer)
+    {
+        uint32_t bufferIndex = 0;
+        vk::DeviceSize offset = 0;
+        cmd.bindDescriptorBuffersEXT(vk::DescriptorBufferBindingInfoEXT{
+            .address = descriptorBufferAddress,
+            .usage = vk::BufferUsageFlagBits::eResourceDescriptorBufferEXT |
+                     vk::BufferUsageFlagBits::eSamplerDescriptorBufferEXT,
+        });
+        cmd.setDescriptorBufferOffsetsEXT(bindPoint, *pipelineLayout, 0, bufferIndex, offset);
     }
     else
     {
-        newHandle = images.size() + buffers.size();
+        cmd.bindDescriptorSets(bindPoint, *pipelineLayout, 0, {*descriptorSet}, {});
     }
-    images.emplace(newHandle, std::move(image));
+}
 
-    vk::DescriptorImageInfo imageInfo{
-        .sampler = images.at(newHandle).getSampler(),
-        .imageView = images.at(newHandle).getImageView(vk::ImageAspectFlagBits::eColor),
-        .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal,
-    };
+vk::PipelineCreateFlags BindlessManager::getPipelineCreateFlags() const
+{
+    return useDescriptorBuffer ? vk::PipelineCreateFlagBits::eDescriptorBufferEXT : vk::PipelineCreateFlags{};
+}
 
-    vk::WriteDescriptorSet write{
-        .dstSet = *descriptorSet,
-        .dstBinding = ImageSamplerBinding,
-        .dstArrayElement = newHandle,
-        .descriptorCount = 1,
-        .descriptorType = vk::DescriptorType::eCombinedImageSampler,
-        .pImageInfo = &imageInfo,
-    };
+void BindlessManager::beginFrame(uint32_t frameIndex)
+{
+    frameUniformFrame = frameIndex;
+    frameUniformHead = 0;
 
-    device.getHandle().updateDescriptorSets(write, nullptr);
-    return newHandle;
+    // The frame has finished on the GPU, so the updates that it missed are copied into its slots now.
+    for (auto it = staleVersionedUniforms.begin(); it != staleVersionedUniforms.end();)
+    {
+        writeVersionedUniformSlot(*it);
+        if (--staleFrames[*it] == 0)
+        {
+            it = staleVersionedUniforms.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
 }
 
-void BindlessManager::updateImage(uint32_t handle, core::Image &newImage)
+uint32_t BindlessManager::allocateFrameUniform(const void *data, uint32_t size)
 {
-    removeImage(handle);
-    storeImage(newImage);
+    assert(size <= FrameUniformSize && "Frame uniform exceeds its slot");
+    if (frameUniformHead < FrameUniformCount)
+    {
+        uint32_t slot = frameUniformFrame * FrameUniformCount + frameUniformHead++;
+        auto *slotData = static_cast<uint8_t *>(frameUniformRing->getMappedData()) + slot * FrameUniformSize;
+        std::memcpy(slotData, data, size);
+        return frameUniformBase + slot;
+    }
+
+    // The region of the frame is full, the remaining frame uniforms are stored in buffers of their own. They are kept
+    // for the frame in flight and reused when it is recorded again, so only the first frame that overflows creates
+    // buffers and writes their descriptors.
+    uint32_t overflowIndex = frameUniformHead++ - FrameUniformCount;
+    auto &overflowHandles = frameUniformOverflow[frameUniformFrame];
+    if (overflowIndex == overflowHandles.size())
+    {
+        vk::BufferCreateInfo bufferCreateInfo{.size = FrameUniformSize,
+                                              .usage = vk::BufferUsageFlagBits::eUniformBuffer};
+        core::Buffer buffer(device, bufferCreateInfo,
+                            VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+        overflowHandles.emplace_back(insert(uniformBuffers, buffer));
+        if (overflowIndex == 0)
+        {
+            LOG_WARN("Frame uniform ring is full, storing further frame uniforms in dedicated buffers")
+        }
+    }
+
+    uint32_t handle = overflowHandles[overflowIndex];
+    std::memcpy(lookup(uniformBuffers, handle).getMappedData(), data, size);
+    return handle;
 }
 
-void BindlessManager::removeImage(uint32_t handle)
+uint32_t BindlessManager::storeVersionedUniform()
+{
+    uint32_t index;
+    if (!freeVersionedUniforms.empty())
+    {
+        index = freeVersionedUniforms.back();
+        freeVersionedUniforms.pop_back();
+    }
+    else if (numVersionedUniforms < VersionedUniformCount)
+    {
+        index = numVersionedUniforms++;
+    }
+    else
+    {
+        throw std::runtime_error{"Out of versioned uniforms"};
+    }
+    versionedUniformSizes[index] = 0;
+    return index;
+}
+
+void BindlessManager::updateVersionedUniform(uint32_t index, const void *data, uint32_t size)
+{
+    assert(size <= FrameUniformSize && "Versioned uniform exceeds its slot");
+    std::memcpy(versionedUniformData.data() + size_t{index} * FrameUniformSize, data, size);
+    versionedUniformSizes[index] = size;
+
+    // The current frame waited for its fence in beginFrame(), the other frames are updated when they begin.
+    writeVersionedUniformSlot(index);
+    if (staleFrames[index] == 0)
+    {
+        staleVersionedUniforms.push_back(index);
+    }
+    staleFrames[index] = RenderManager::framesInFlight - 1;
+}
+
+void BindlessManager::removeVersionedUniform(uint32_t index)
+{
+    if (staleFrames[index] > 0)
+    {
+        std::erase(staleVersionedUniforms, index);
+        staleFrames[index] = 0;
+    }
+    freeVersionedUniforms.emplace_back(index);
+}
+
+void BindlessManager::writeVersionedUniformSlot(uint32_t index)
+{
+    uint32_t slot = frameUniformFrame * VersionedUniformCount + index;
+    auto *slotData = static_cast<uint8_t *>(versionedUniformBuffer->getMappedData()) + slot * FrameUniformSize;
+    std::memcpy(slotData, versionedUniformData.data() + size_t{index} * FrameUniformSize, versionedUniformSizes[index]);
+}
+
+uint32_t BindlessManager::getVersionedUniformBase() const
 {
-    images.erase(handle);
-    freeHandles.emplace_back(handle);
+    return versionedUniformBase + frameUniformFrame * VersionedUniformCount;
 }
 
 const vk::PipelineLayout &BindlessManager::getPipelineLayout() const
@@ -16,6 +16,9 @@
 #include "../core/Buffer.h"
 #include "../core/Image.h"
 
+#include <array>
+#include <optional>
+
 // Forward declarations
 #include "../core/CoreFwd.h"
 
@@ -29,6 +32,30 @@ namespace vkf::rendering
 /// This class provides functionality to store, update, and remove buffers. It also provides methods to update
 /// descriptor sets and get pipeline layout and descriptor set.
 ///
+/// Buffers and images are stored in dense slot arrays, one for each binding. Their handles consist of the index of the
+/// slot, which is the array element of the descriptor, the binding and the generation of the slot. The generation is
+/// incremented whenever a slot is freed, so a handle of a removed resource is detected instead of reaching the
+/// resource that reuses the slot. Shaders only see the index, see getIndex(). The descriptors of new resources are
+/// queued and written in one batch by flushDescriptorWrites() before the frame is rendered.
+///
+/// If the Device has enabled VK_EXT_descriptor_buffer, the descriptors are not written into a descriptor set from a
+/// pool. They are written straight into a mapped descriptor buffer with vkGetDescriptorEXT(), which is bound by bind().
+/// The handles and the shaders are the same for both backends, only the pipelines have to be created with
+/// getPipelineCreateFlags(). If the descriptor buffer exceeds the descriptor buffer limits of the device, descriptor
+/// sets are used instead.
+///
+/// Small uniforms that are written every frame, e.g. model matrices and colors, are not stored as buffers of their own.
+/// They are copied into the frame uniform ring, a mapped buffer with a region for each frame in flight. The region is
+/// divided into slots of FrameUniformSize bytes, whose uniform descriptors occupy the last handles of the uniform
+/// binding and are written once, so allocating a frame uniform is a bump of the slot index and a memcpy. Frame
+/// uniforms beyond FrameUniformCount in a frame are stored in dedicated buffers, which are reused by later frames.
+///
+/// Uniforms that change rarely, e.g. the parameters of a graticule, are versioned uniforms. Each of them has a slot in
+/// every frame in flight and a copy in host memory. An update writes the slot of the current frame and the slots of
+/// the other frames once they are recorded again, so no frame that is still in flight is written. Shaders read the
+/// slot of the current frame by adding the versioned uniform index of the material to the base of the frame, which is
+/// pushed as the push constant FrameBaseIndex.
+///
 class BindlessManager
 {
   public:
@@ -57,6 +84,8 @@ class BindlessManager
     ///
     /// This method takes a handle to a buffer, data to update, size of the data, and offset in the buffer, and updates
     /// the buffer.
+    /// The data is copied right away, so the buffer must not be read by a frame that is in flight. Uniforms that change
+    /// while they are drawn are versioned uniforms, see updateVersionedUniform().
     ///
     void updateBuffer(uint32_t handle, const void *data, uint32_t size, uint32_t offset);
 
@@ -77,8 +106,8 @@ class BindlessManager
     ///
     /// \brief Method to update an image.
     ///
-    /// This method takes a handle to an image and a new image. It updates the image by removing the old image and
-    /// storing the new image.
+    /// This method takes a handle to an image and a new image. It replaces the image in the slot of the handle, so the
+    /// handle stays valid.
     ///
     void updateImage(uint32_t handle, core::Image &newImage);
 
@@ -89,17 +118,123 @@ class BindlessManager
     ///
     void removeImage(uint32_t handle);
 
+    ///
+    /// \brief Method to write the queued descriptors of new resources.
+    ///
+    /// This method writes the descriptors of all resources stored or updated since the last call with a single
+    /// updateDescriptorSets() call. It must be called before the frame that uses the resources is rendered.
+    ///
+    void flushDescriptorWrites();
+
+    ///
+    /// \brief Returns the descriptor array element of a handle, which is the index pushed to the shaders.
+    ///
+    static constexpr uint32_t getIndex(uint32_t handle)
+    {
+        return handle & IndexMask;
+    }
+
+    ///
+    /// \brief Method to start the frame uniforms of a frame.
+    ///
+    /// This method discards the frame uniforms that were allocated when the frame in flight frameIndex was recorded the
+    /// last time. It must be called after RenderManager::beginFrame() has waited for that frame.
+    ///
+    void beginFrame(uint32_t frameIndex);
+
+    ///
+    /// \brief Method to allocate a frame uniform.
+    ///
+    /// This method copies size bytes of data, at most FrameUniformSize, into the next slot of the frame uniform ring
+    /// and returns the uniform handle of the slot. The handle is only valid for the current frame, so the frame
+    /// uniforms of all drawn entities are allocated again every frame.
+    ///
+    uint32_t allocateFrameUniform(const void *data, uint32_t size);
+
+    ///
+    /// \brief Method to store a versioned uniform.
+    ///
+    /// This method returns the index of a new versioned uniform of at most FrameUniformSize bytes. The index is
+    /// relative to the versioned uniform base of the frame, see getVersionedUniformBase().
+    ///
+    uint32_t storeVersionedUniform();
+
+    ///
+    /// \brief Method to update a versioned uniform.
+    ///
+    /// This method copies size bytes of data into the versioned uniform index. The frames that are in flight keep
+    /// reading the previous data.
+    ///
+    void updateVersionedUniform(uint32_t index, const void *data, uint32_t size);
+
+    ///
+    /// \brief Method to remove a versioned uniform.
+    ///
+    void removeVersionedUniform(uint32_t index);
+
+    ///
+    /// \brief Returns the uniform handle of the versioned uniform 0 of the current frame.
+    ///
+    [[nodiscard]] uint32_t getVersionedUniformBase() const;
+
+    ///
+    /// \brief Binds the bindless descriptors as set 0 of the pipeline layout.
+    ///
+    /// This method binds the descriptor buffer or the descriptor set, depending on the backend.
+    ///
+    void bind(const vk::raii::CommandBuffer &cmd, vk::PipelineBindPoint bindPoint) const;
+
+    ///
+    /// \brief Returns the flags that pipelines using the pipeline layout have to be created with.
+    ///
+    [[nodiscard]] vk::PipelineCreateFlags getPipelineCreateFlags() const;
+
     [[nodiscard]] const vk::PipelineLayout &getPipelineLayout() const;
     [[nodiscard]] vk::DescriptorSet getDescriptorSet() const;
 
-    static constexpr uint32_t UniformBinding = 0;        ///< Uniform binding index
-    static constexpr uint32_t StorageBinding = 1;        ///< Storage binding index
-    static constexpr uint32_t ImageSamplerBinding = 2;   ///< imageSampler binding index
-    static constexpr uint32_t UniformCount = 65536;      ///< Maximum number of uniform buffers
-    static constexpr uint32_t ImageSamplerCount = 65536; ///< Maximum number of imageSamplers
-    static constexpr uint32_t StorageCount = 65536;      ///< Maximum number of storage buffers
+    static constexpr uint32_t UniformBinding = 0;           ///< Uniform binding index
+    static constexpr uint32_t StorageBinding = 1;           ///< Storage binding index
+    static constexpr uint32_t ImageSamplerBinding = 2;      ///< imageSampler binding index
+    static constexpr uint32_t UniformCount = 65536;         ///< Maximum number of uniform buffers
+    static constexpr uint32_t ImageSamplerCount = 65536;    ///< Maximum number of imageSamplers
+    static constexpr uint32_t StorageCount = 65536;         ///< Maximum number of storage buffers
+    static constexpr uint32_t FrameUniformSize = 256;       ///< Size of a frame uniform slot in bytes
+    static constexpr uint32_t FrameUniformCount = 4096;     ///< Number of frame uniform slots per frame
+    static constexpr uint32_t VersionedUniformCount = 1024; ///< Maximum number of versioned uniforms
+    static constexpr uint32_t FrameBaseIndex = 31;          ///< Push constant with the versioned uniform base
+
+    // Layout of the handles of buffers and images, from the lowest bit: slot index, binding and generation.
+    static constexpr uint32_t IndexBits = 16;                                      ///< Bits of the slot index
+    static constexpr uint32_t BindingBits = 2;                                     ///< Bits of the binding
+    static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;                   ///< Mask of the slot index
+    static constexpr uint32_t BindingMask = (1u << BindingBits) - 1;               ///< Mask of the binding
+    static constexpr uint32_t GenerationShift = IndexBits + BindingBits;           ///< First bit of the generation
+    static constexpr uint32_t GenerationMask = (1u << (32 - GenerationShift)) - 1; ///< Mask of the generation
 
   private:
+    ///
+    /// \brief Dense slot array of the resources of one binding.
+    ///
+    template <typename Resource> struct ResourceSlots
+    {
+        uint32_t binding;                               ///< Binding of the descriptors of the slots
+        uint32_t capacity;                              ///< Number of descriptors that the slots may use
+        std::vector<std::optional<Resource>> resources; ///< Resource of each slot, empty if the slot is free
+        std::vector<uint32_t> generations;              ///< Current generation of each slot
+        std::vector<uint32_t> freeIndices;              ///< Free slots that are reused first
+    };
+
+    template <typename Resource> uint32_t insert(ResourceSlots<Resource> &slots, Resource &resource);
+    template <typename Resource> Resource &lookup(ResourceSlots<Resource> &slots, uint32_t handle);
+    template <typename Resource> void erase(ResourceSlots<Resource> &slots, uint32_t handle);
+
+    bool createDescriptorBuffer();
+    void writeDescriptor(const vk::DescriptorGetInfoEXT &info, uint32_t binding, uint32_t index);
+    void createFrameUniformRing();
+    void createVersionedUniforms();
+    void writeUniformSlots(const core::Buffer &buffer, uint32_t firstHandle, uint32_t numSlots);
+    void writeVersionedUniformSlot(uint32_t index);
+
     const core::Device &device;
 
     vk::raii::DescriptorPool descriptorPool = VK_NULL_HANDLE;
@@ -107,10 +242,32 @@ class BindlessManager
     std::vector<vk::raii::DescriptorSetLayout> descriptorSetLayouts;
     vk::raii::PipelineLayout pipelineLayout = VK_NULL_HANDLE;
 
-    std::unordered_map<uint32_t, core::Buffer> buffers; ///< Map of handles and their corresponding buffers
-    std::unordered_map<uint32_t, core::Image> images;   ///< Map of handles and their corresponding images
+    bool useDescriptorBuffer{false};                ///< Whether the descriptors are written into the descriptor buffer
+    std::unique_ptr<core::Buffer> descriptorBuffer; ///< Mapped buffer with the descriptors of all bindings
+    vk::DeviceAddress descriptorBufferAddress{0};   ///< Device address of the descriptor buffer
+    std::array<vk::DeviceSize, 3> bindingOffsets{}; ///< Offset of each binding in the descriptor buffer
+    std::array<size_t, 3> descriptorSizes{};        ///< Size of a descriptor of each binding
+
+    ResourceSlots<core::Buffer> uniformBuffers{.binding = UniformBinding, .capacity = UniformCount};
+    ResourceSlots<core::Buffer> storageBuffers{.binding = StorageBinding, .capacity = StorageCount};
+    ResourceSlots<core::Image> images{.binding = ImageSamplerBinding, .capacity = ImageSamplerCount};
+
+    std::vector<uint32_t> pendingWrites; ///< Handles whose descriptors are written by flushDescriptorWrites()
+
+    std::unique_ptr<core::Buffer> frameUniformRing;          ///< Mapped buffer with a region of slots for each frame
+    uint32_t frameUniformBase{0};                            ///< Uniform handle of the first slot of the ring
+    uint32_t frameUniformFrame{0};                           ///< Frame in flight whose region is allocated from
+    uint32_t frameUniformHead{0};                            ///< Number of frame uniforms allocated in the frame
+    std::vector<std::vector<uint32_t>> frameUniformOverflow; ///< Handles of the overflow buffers of each frame
 
-    std::vector<uint32_t> freeHandles; ///< Vector of free handles
+    std::unique_ptr<core::Buffer> versionedUniformBuffer; ///< Mapped buffer with a region of slots for each frame
+    uint32_t versionedUniformBase{0};                     ///< Uniform handle of the first slot of the buffer
+    std::vector<uint8_t> versionedUniformData;            ///< Latest data of each versioned uniform
+    std::vector<uint32_t> versionedUniformSizes;          ///< Size of the latest data of each versioned uniform
+    std::vector<uint32_t> staleVersionedUniforms;         ///< Versioned uniforms whose slots are not all up to date
+    std::vector<uint32_t> staleFrames;                    ///< Number of frames whose slot is outdated, per uniform
+    std::vector<uint32_t> freeVersionedUniforms;          ///< Vector of free versioned uniform indices
+    uint32_t numVersionedUniforms{0};                     ///< Number of versioned uniform indices handed out
 };
 
 } // namespace vkf::rendering
\ No newline at end of file
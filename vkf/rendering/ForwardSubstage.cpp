@@ -28,8 +28,7 @@ ForwardSubstage::ForwardSubstage(scene::Scene &scene, RenderSource *source,
 
 void ForwardSubstage::draw(vk::raii::CommandBuffer *cmd)
 {
-    cmd->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, bindlessManager.getPipelineLayout(), 0,
-                            {bindlessManager.getDescriptorSet()}, {});
+    bindlessManager.bind(*cmd, vk::PipelineBindPoint::eGraphics);
 
     vk::Viewport viewport{.x = 0.0f,
                           .y = 0.0f,
@@ -42,8 +41,17 @@ void ForwardSubstage::draw(vk::raii::CommandBuffer *cmd)
     vk::Rect2D scissor{.offset = {0, 0}, .extent = source->getExtent()};
     cmd->setScissor(0, {scissor});
 
+    // The materials push the other push constants, so the versioned uniform base of the frame is pushed once.
+    cmd->pushConstants<uint32_t>(bindlessManager.getPipelineLayout(), vk::ShaderStageFlagBits::eAll,
+                                 BindlessManager::FrameBaseIndex * sizeof(uint32_t),
+                                 bindlessManager.getVersionedUniformBase());
+
     auto view = scene.getRegistry().view<scene::MeshComponent, scene::MaterialComponent>();
 
+    // The meshes share the buffers of the GeometryArena, so the bindings only change when a mesh lies in another block.
+    vk::Buffer boundVertexBuffer;
+    vk::Buffer boundIndexBuffer;
+
     for (auto entity : view)
     {
         auto &meshComp = view.get<scene::MeshComponent>(entity);
@@ -59,18 +67,47 @@ void ForwardSubstage::draw(vk::raii::CommandBuffer *cmd)
 
         cmd->pushConstants<uint32_t>(bindlessManager.getPipelineLayout(), vk::ShaderStageFlagBits::eAll, 0,
                                      materialComp.indices);
-        cmd->bindVertexBuffers(0, {meshComp.vertexBuffer->getBuffer()}, {0});
+        // Meshes that are generated in the shader have no vertices.
+        uint32_t firstVertex = 0;
+        if (meshComp.vertices)
+        {
+            vk::Buffer vertexBuffer = meshComp.vertices.getBuffer().getBuffer();
+            if (vertexBuffer != boundVertexBuffer)
+            {
+                cmd->bindVertexBuffers(0, {vertexBuffer}, {0});
+                boundVertexBuffer = vertexBuffer;
+            }
+            firstVertex = meshComp.vertices.getFirstElement();
+        }
 
-        if (!meshComp.multiDraw)
+        if (meshComp.indices)
         {
-            cmd->draw(meshComp.numVertices, 1, 0, 0);
+            vk::Buffer indexBuffer = meshComp.indices.getBuffer().getBuffer();
+            if (indexBuffer != boundIndexBuffer)
+            {
+                cmd->bindIndexBuffer(indexBuffer, 0, vk::IndexType::eUint32);
+                boundIndexBuffer = indexBuffer;
+            }
+            cmd->drawIndexed(meshComp.numIndices, meshComp.instanceCount, meshComp.indices.getFirstElement(),
+                             static_cast<int32_t>(firstVertex), 0);
+        }
+        else if (!meshComp.multiDraw)
+        {
+            cmd->draw(meshComp.numVertices, meshComp.instanceCount, firstVertex, 0);
         }
         else
         {
             //        cmd->drawMultiEXT(meshComp.multiDrawInfos, 1, 0);
-            for (int i = 0; i < meshComp.startIndices.size(); ++i)
+            size_t firstDraw = 0;
+            size_t lastDraw = meshComp.startIndices.size();
+            if (meshComp.lod + 1 < meshComp.lodDrawOffsets.size())
+            {
+                firstDraw = meshComp.lodDrawOffsets[meshComp.lod];
+                lastDraw = meshComp.lodDrawOffsets[meshComp.lod + 1];
+            }
+            for (size_t i = firstDraw; i < lastDraw; ++i)
             {
-                cmd->draw(meshComp.vertexCounts[i], 1, meshComp.startIndices[i], 0);
+                cmd->draw(meshComp.vertexCounts[i], meshComp.instanceCount, firstVertex + meshComp.startIndices[i], 0);
             }
         }
     }
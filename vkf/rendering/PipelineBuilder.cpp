@@ -112,6 +112,12 @@ PipelineBuilder &PipelineBuilder::setPipelineLayout(const vk::PipelineLayout &la
     return *this;
 }
 
+PipelineBuilder &PipelineBuilder::setPipelineFlags(vk::PipelineCreateFlags flags)
+{
+    state.flags = flags;
+    return *this;
+}
+
 PipelineBuilder &PipelineBuilder::setRenderPass(const vk::RenderPass &pass)
 {
     state.renderPass = pass;
@@ -52,6 +52,7 @@ class PipelineBuilder
     PipelineBuilder &setDynamicStateCreateInfo(const vk::PipelineDynamicStateCreateInfo &info,
                                                std::vector<vk::DynamicState> &states);
     PipelineBuilder &setPipelineLayout(const vk::PipelineLayout &layout);
+    PipelineBuilder &setPipelineFlags(vk::PipelineCreateFlags flags);
     PipelineBuilder &setRenderPass(const vk::RenderPass &pass);
 
     core::Pipeline build(const core::Device &device);
@@ -18,6 +18,7 @@
 #include "../core/Framebuffer.h"
 #include "../core/RenderPass.h"
 #include "../core/Swapchain.h"
+#include "../core/UploadManager.h"
 #include "../platform/Gui.h"
 #include "../platform/Window.h"
 #include "FrameData.h"
@@ -153,6 +154,10 @@ void RenderManager::endRenderPass(uint32_t currentRenderPass)
 void RenderManager::render()
 {
     updateFrameBuffers();
+
+    // The uploads recorded since the last frame are submitted to the same queue first, so the frame sees them.
+    device.getUploadManager().submit();
+
     for (size_t i = 0; i < renderers.size(); ++i)
     {
         beginRenderPass(*renderers[i], i);
@@ -161,6 +166,11 @@ void RenderManager::render()
     }
 }
 
+uint32_t RenderManager::getActiveFrame() const
+{
+    return activeFrame;
+}
+
 void RenderManager::createFrameData()
 {
     std::vector<FrameData *> renderFrameData;
@@ -59,6 +59,11 @@ class RenderManager
 
     void syncFrameData();
 
+    ///
+    /// \brief Returns the index of the frame in flight that is recorded, in [0, framesInFlight).
+    ///
+    [[nodiscard]] uint32_t getActiveFrame() const;
+
     static constexpr uint32_t framesInFlight{3};
 
   private:
@@ -22,9 +22,8 @@
 namespace vkf::scene
 {
 
-Camera::Camera(vkf::rendering::BindlessManager &bindlessManager, uint32_t handle, float fov, float aspect, float near,
-               float far)
-    : bindlessManager{bindlessManager}, handle{handle}, position{0.0f, 400.0f, 400.0f}, target{0.0f, 0.0f, 0.0f},
+Camera::Camera(vkf::rendering::BindlessManager &bindlessManager, float fov, float aspect, float near, float far)
+    : bindlessManager{bindlessManager}, position{0.0f, 400.0f, 400.0f}, target{0.0f, 0.0f, 0.0f},
       up{0.0f, 1.0f, 0.0f}, fov{fov}, aspect{aspect}, near{near}, far{far}
 {
     createViewMatrix();
@@ -63,6 +62,16 @@ glm::vec3 Camera::getPosition() const
     return position;
 }
 
+glm::vec3 Camera::getTarget() const
+{
+    return target;
+}
+
+float Camera::getFieldOfView() const
+{
+    return fov;
+}
+
 uint32_t Camera::getHandle() const
 {
     return handle;
@@ -135,7 +144,8 @@ void Camera::updateAspectRatio(float aspect)
 
 void Camera::updateCameraBuffer()
 {
-    bindlessManager.updateBuffer(handle, glm::value_ptr(getViewProjectionMatrix()), sizeof(glm::mat4), 0);
+    glm::mat4 viewProjection = getViewProjectionMatrix();
+    handle = bindlessManager.allocateFrameUniform(glm::value_ptr(viewProjection), sizeof(viewProjection));
 }
 
 void Camera::createProjectionMatrix()
@@ -34,21 +34,18 @@ class Camera
 {
   public:
     ///
-    /// \brief Constructor that takes a BindlessManager reference, handle, field of view, aspect ratio, near and far
-    /// plane distances as parameters.
+    /// \brief Constructor that takes a BindlessManager reference, field of view, aspect ratio, near and far plane
+    /// distances as parameters.
     ///
-    /// This constructor initializes the bindlessManager reference, handle, and camera parameters with the provided
-    /// values.
+    /// This constructor initializes the bindlessManager reference and camera parameters with the provided values.
     ///
     /// \param bindlessManager The BindlessManager reference to use for creating the Camera.
-    /// \param handle The handle to use for creating the Camera.
     /// \param fov The field of view to use for creating the Camera.
     /// \param aspect The aspect ratio to use for creating the Camera.
     /// \param near The near plane distance to use for creating the Camera.
     /// \param far The far plane distance to use for creating the Camera.
     ///
-    Camera(rendering::BindlessManager &bindlessManager, uint32_t handle, float fov, float aspect, float near,
-           float far);
+    Camera(rendering::BindlessManager &bindlessManager, float fov, float aspect, float near, float far);
 
     Camera(const Camera &) = delete;            ///< Deleted copy constructor
     Camera(Camera &&) noexcept = default;       ///< Default move constructor
@@ -63,6 +60,8 @@ class Camera
     [[nodiscard]] glm::mat4 getViewProjectionMatrix() const;
     [[nodiscard]] glm::vec3 getXAxis() const;
     [[nodiscard]] glm::vec3 getPosition() const;
+    [[nodiscard]] glm::vec3 getTarget() const;
+    [[nodiscard]] float getFieldOfView() const;
     [[nodiscard]] uint32_t getHandle() const;
 
     /// \brief Method to orbit the camera.
@@ -82,7 +81,8 @@ class Camera
 
     /// \brief Method to update the camera buffer.
     ///
-    /// This method updates the camera buffer.
+    /// This method copies the view projection matrix into a frame uniform. The handle returned by getHandle() changes
+    /// with every call and is only valid for the current frame.
     void updateCameraBuffer();
 
   private:
@@ -90,7 +90,7 @@ class Camera
     void createViewMatrix();
 
     rendering::BindlessManager &bindlessManager;
-    uint32_t handle;
+    uint32_t handle{0};
 
     glm::vec3 position;
     glm::vec3 target;
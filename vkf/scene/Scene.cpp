@@ -64,6 +64,18 @@ void Scene::updateSelectedPrefabComponents()
     prefabs[selectedPrefabUUID]->updateComponents();
 }
 
+void Scene::updateFrameUniforms()
+{
+    for (auto &pair : prefabs)
+    {
+        // Destroyed prefabs stay in the map, but their entity is gone.
+        if (pair.second != nullptr && registry.valid(pair.second->getEntity()))
+        {
+            pair.second->updateFrameUniforms(sceneCamera->getHandle());
+        }
+    }
+}
+
 void Scene::updateGlobalFunctions()
 {
     for (auto &pair : globalFunctions)
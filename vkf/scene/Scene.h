@@ -63,6 +63,11 @@ class Scene
 
     void updateSelectedPrefabGui();
     void updateSelectedPrefabComponents();
+
+    ///
+    /// \brief Allocates the frame uniforms of all prefabs, see Prefab::updateFrameUniforms().
+    ///
+    void updateFrameUniforms();
     void updateGlobalFunctions();
     void addGlobalFunction(UUID uuid, std::function<void()> function);
     void removeGlobalFunction(UUID uuid);
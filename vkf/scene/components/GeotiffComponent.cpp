@@ -8,8 +8,9 @@
 
 #include "GeotiffComponent.h"
 #include "../../common/Log.h"
-#include "../../core/Buffer.h"
+#include "../../core/Device.h"
 #include "../../core/Image.h"
+#include "../../core/UploadManager.h"
 #include <gdal.h>
 #include <gdal_priv.h>
 #include <imgui.h>
@@ -29,6 +30,8 @@ GeotiffComponent::GeotiffComponent(const vkf::core::Device &device) : device{dev
 
 core::Image GeotiffComponent::createImage()
 {
+    // The previous texture is replaced in the BindlessManager and may still be in use by the frames in flight
+    device.getHandle().waitIdle();
     this->path =
         (this->path.empty()) ? PROJECT_ROOT_DIR + std::string("/assets/HYP_50M_SR_W/HYP_50M_SR_W.tif") : this->path;
 
@@ -169,16 +172,7 @@ core::Image GeotiffComponent::createImage()
                             .initialLayout = vk::ImageLayout::eUndefined},
         VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT};
 
-    vk::BufferCreateInfo bufferCreateInfo{.size = imgSize, .usage = vk::BufferUsageFlagBits::eTransferSrc};
-    core::Buffer stagingBuffer{device, bufferCreateInfo,
-                               VMA_ALLOCATION_CREATE_MAPPED_BIT |
-                                   VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT};
-
-    stagingBuffer.updateData(tiffImg.data(), imgSize, 0);
-
-    texture.transitionImageLayout(vk::ImageLayout::eTransferDstOptimal);
-    texture.copyBufferToImage(stagingBuffer);
-    texture.transitionImageLayout(vk::ImageLayout::eShaderReadOnlyOptimal);
+    device.getUploadManager().uploadImage(texture, tiffImg.data(), imgSize);
 
     hasNewTexture = false;
 
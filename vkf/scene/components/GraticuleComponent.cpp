@@ -23,6 +23,13 @@ void GraticuleComponent::updateGui()
     ImGui::Text("Latitudes:");
     ImGui::InputFloat3("##Latitudes", graticuleLatitudes.data());
 
+    ImGui::Checkbox("Stream coast- and borderlines", &streamGeometry);
+
+    if (ImGui::Checkbox("Fill countries", &fillCountries))
+    {
+        hasNewGraticule = true;
+    }
+
     ImGui::Spacing();
 
     if (ImGui::Button("Load Graticule"))
@@ -21,6 +21,12 @@ struct GraticuleComponent
     float graticuleSpacingLongitude{1.};
     float graticuleSpacingLatitude{1.};
 
+    // Stream coast- and borderlines chunk by chunk to the GPU instead of caching their geometry.
+    bool streamGeometry{false};
+
+    // Draw the countries as filled polygons below the coast- and borderlines.
+    bool fillCountries{false};
+
     bool hasNewGraticule{false};
 };
 
@@ -12,6 +12,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "MaterialComponent.h"
+#include "../../rendering/BindlessManager.h"
 
 namespace vkf::scene
 {
@@ -19,7 +20,9 @@ namespace vkf::scene
 void MaterialComponent::addResource(const std::string &resourceName, uint32_t index)
 {
     resourceMap[resourceName] = index;
-    indices[currentResourceCount] = index;
+    resourceSlots[resourceName] = currentResourceCount;
+    // Handles of buffers and images carry their binding and generation, the shaders only need the descriptor index.
+    indices[currentResourceCount] = rendering::BindlessManager::getIndex(index);
     currentResourceCount++;
 }
 
@@ -37,6 +40,12 @@ uint32_t MaterialComponent::getResourceIndex(const std::string &resourceName)
     }
 }
 
+void MaterialComponent::updateResource(const std::string &resourceName, uint32_t index)
+{
+    resourceMap.at(resourceName) = index;
+    indices[resourceSlots.at(resourceName)] = rendering::BindlessManager::getIndex(index);
+}
+
 void MaterialComponent::setPipeline(uint32_t index)
 {
     currentPipeline = pipelines.at(index);
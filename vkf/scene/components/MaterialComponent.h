@@ -54,13 +54,23 @@ struct MaterialComponent
     ///
     uint32_t getResourceIndex(const std::string &resourceName);
 
+    ///
+    /// \brief Method to update a resource.
+    ///
+    /// This method replaces the index of a resource that was added before, e.g. with the handle of a frame uniform that
+    /// is allocated every frame. The position of the resource in the indices array is kept.
+    ///
+    void updateResource(const std::string &resourceName, uint32_t index);
+
     void setPipeline(uint32_t index);
 
-    static constexpr uint32_t maxSize{32};
+    // The last push constant is reserved for the versioned uniform base, see BindlessManager::FrameBaseIndex.
+    static constexpr uint32_t maxSize{31};
     std::array<uint32_t, maxSize> indices;
     std::deque<core::Pipeline *> pipelines;
     core::Pipeline *currentPipeline;
-    std::unordered_map<std::string, uint32_t> resourceMap; ///< Map to store resource names and their indices
+    std::unordered_map<std::string, uint32_t> resourceMap;   ///< Map to store resource names and their indices
+    std::unordered_map<std::string, uint32_t> resourceSlots; ///< Map to store resource names and their positions
 
     uint32_t currentResourceCount{0};
 };
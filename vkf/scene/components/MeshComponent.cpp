@@ -12,7 +12,9 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "MeshComponent.h"
+#include "../../common/PolylineSet.h"
 #include "../../core/Device.h"
+#include "../../core/UploadManager.h"
 #include <imgui.h>
 
 namespace vkf::scene
@@ -28,28 +30,153 @@ void MeshComponent::updateGui()
     ImGui::Spacing();
     std::string checkboxLabel = "Drawable##" + std::to_string(reinterpret_cast<uintptr_t>(this));
     ImGui::Checkbox(checkboxLabel.c_str(), &shouldDraw);
+    if (lodDrawOffsets.size() > 1)
+    {
+        ImGui::Text("Level of detail: %u of %zu (%zu polylines)", lod, lodDrawOffsets.size() - 2,
+                    lodDrawOffsets[lod + 1] - lodDrawOffsets[lod]);
+    }
     ImGui::Spacing();
 }
 
 void MeshComponent::uploadGeometry(std::vector<float> mesh, uint32_t vertexSize)
 {
-    device.getHandle().waitIdle();
-    vertexBuffer = std::make_shared<core::Buffer>(
-        device,
-        vk::BufferCreateInfo{.size = sizeof(float) * mesh.size(),
-                             .usage = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst},
-        VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT);
+    if (mesh.empty())
+    {
+        vertices.reset();
+        numVertices = 0;
+        return;
+    }
 
-    vk::BufferCreateInfo bufferCreateInfo{.size = sizeof(float) * mesh.size(),
-                                          .usage = vk::BufferUsageFlagBits::eTransferSrc};
-    core::Buffer stagingBuffer{device, bufferCreateInfo,
-                               VMA_ALLOCATION_CREATE_MAPPED_BIT |
-                                   VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT};
+    auto &uploads = device.getUploadManager();
+    vk::DeviceSize size = sizeof(float) * mesh.size();
 
-    stagingBuffer.updateData(mesh.data(), sizeof(float) * mesh.size(), 0);
+    // Assigning the new range frees the previous one once the frames that draw it have finished.
+    vertices = device.getGeometryArena().allocateVertices(size, vertexSize);
 
-    vertexBuffer->copyBuffer(stagingBuffer);
+    uploadTicket = uploads.uploadBuffer(vertices.getBuffer(), mesh.data(), size, vertices.getOffset());
     numVertices = static_cast<uint32_t>(mesh.size()) / (vertexSize / sizeof(float));
 }
 
+void MeshComponent::uploadGeometry(const float *x, const float *y, uint32_t vertexCount)
+{
+    if (vertexCount == 0)
+    {
+        vertices.reset();
+        numVertices = 0;
+        return;
+    }
+
+    auto &uploads = device.getUploadManager();
+    vk::DeviceSize size = 2 * sizeof(float) * vertexCount;
+
+    vertices = device.getGeometryArena().allocateVertices(size, 2 * sizeof(float));
+
+    auto staging = uploads.allocateStaging(size);
+    auto *stagedVertices = static_cast<float *>(staging.data);
+    for (uint32_t i = 0; i < vertexCount; i++)
+    {
+        stagedVertices[2 * i] = x[i];
+        stagedVertices[2 * i + 1] = y[i];
+    }
+
+    uploadTicket =
+        uploads.copyBuffer(*staging.buffer, vertices.getBuffer(), staging.offset, vertices.getOffset(), size);
+    numVertices = vertexCount;
+}
+
+void MeshComponent::uploadIndices(const uint32_t *indexData, uint32_t indexCount)
+{
+    numIndices = indexCount;
+    if (indexCount == 0)
+    {
+        indices.reset();
+        return;
+    }
+
+    indices = device.getGeometryArena().allocateIndices(indexCount);
+    uploadTicket = device.getUploadManager().uploadBuffer(indices.getBuffer(), indexData,
+                                                          sizeof(uint32_t) * indexCount, indices.getOffset());
+}
+
+void MeshComponent::beginStreamingUpload()
+{
+    vertices.reset();
+    vertexCapacity = 0;
+    numVertices = 0;
+    numStagedVertices = 0;
+    startIndices.clear();
+    vertexCounts.clear();
+}
+
+void MeshComponent::streamPolylines(const Met3D::PolylineSet &polylines)
+{
+    constexpr auto maxStagedVertices = static_cast<uint32_t>(streamingStagingSize / (2 * sizeof(float)));
+    auto *stagedVertices = static_cast<float *>(streamingStaging.data);
+
+    const float *x = polylines.getX();
+    const float *y = polylines.getY();
+    for (size_t polyline = 0; polyline < polylines.getNumPolylines(); polyline++)
+    {
+        uint32_t begin = polylines.getPolylineBegin(polyline);
+        uint32_t size = polylines.getPolylineSize(polyline);
+        startIndices.push_back(static_cast<int>(numVertices));
+        vertexCounts.push_back(static_cast<int>(size));
+
+        for (uint32_t i = begin; i < begin + size; i++)
+        {
+            if (numStagedVertices == maxStagedVertices)
+            {
+                flushStagingBuffer();
+            }
+            if (numStagedVertices == 0)
+            {
+                // The staged vertices are copied before the next staging memory is allocated, as required by the
+                // UploadManager.
+                streamingStaging = device.getUploadManager().allocateStaging(streamingStagingSize);
+                stagedVertices = static_cast<float *>(streamingStaging.data);
+            }
+            stagedVertices[2 * numStagedVertices] = x[i];
+            stagedVertices[2 * numStagedVertices + 1] = y[i];
+            numStagedVertices++;
+            numVertices++;
+        }
+    }
+}
+
+void MeshComponent::endStreamingUpload()
+{
+    flushStagingBuffer();
+}
+
+void MeshComponent::flushStagingBuffer()
+{
+    if (numStagedVertices == 0)
+    {
+        return;
+    }
+
+    auto &uploads = device.getUploadManager();
+    constexpr vk::DeviceSize vertexSize = 2 * sizeof(float);
+    uint32_t numFlushedVertices = numVertices - numStagedVertices;
+
+    // Grow the vertex range geometrically, the vertices streamed so far are
+    // copied on the GPU.
+    if (numVertices > vertexCapacity)
+    {
+        vertexCapacity = std::max(numVertices, 2 * vertexCapacity);
+        auto grownVertices = device.getGeometryArena().allocateVertices(vertexSize * vertexCapacity, vertexSize);
+        if (numFlushedVertices > 0)
+        {
+            uploads.copyBuffer(vertices.getBuffer(), grownVertices.getBuffer(), vertices.getOffset(),
+                               grownVertices.getOffset(), vertexSize * numFlushedVertices);
+        }
+        vertices = std::move(grownVertices);
+    }
+
+    uploadTicket =
+        uploads.copyBuffer(*streamingStaging.buffer, vertices.getBuffer(), streamingStaging.offset,
+                           vertices.getOffset() + vertexSize * numFlushedVertices, vertexSize * numStagedVertices);
+    numStagedVertices = 0;
+}
+
 } // namespace vkf::scene
\ No newline at end of file
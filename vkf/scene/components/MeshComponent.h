@@ -13,7 +13,14 @@
 
 #pragma once
 
-#include "../../core/Buffer.h"
+#include "../../core/GeometryArena.h"
+#include "../../core/UploadManager.h"
+
+// Forward declarations
+namespace Met3D
+{
+class PolylineSet;
+} // namespace Met3D
 
 namespace vkf::scene
 {
@@ -22,17 +29,16 @@ namespace vkf::scene
 /// \struct MeshComponent
 /// \brief Struct for managing mesh data for an entity in a scene.
 ///
-/// This struct provides functionality to store and manage mesh data. It contains a shared pointer to a Buffer object to
-/// store the mesh data, a uint32_t to store the number of vertices and a boolean to determine if the mesh should be
-/// drawn.
+/// This struct provides functionality to store and manage mesh data. The vertices and indices are stored in ranges of
+/// the GeometryArena of the Device, so meshes share their vertex and index buffers. It also stores the number of
+/// vertices and a boolean to determine if the mesh should be drawn.
 ///
 struct MeshComponent
 {
     ///
     /// \brief Constructor that takes a Device object and a vector of floats representing the mesh as parameters.
     ///
-    /// This constructor initializes the vertexBuffer member with a Buffer object created with the provided Device
-    /// object and mesh data. It also initializes the numVertices member with the size of the provided mesh data.
+    /// The mesh is empty until its vertices are uploaded with uploadGeometry() or a streaming upload.
     ///
     explicit MeshComponent(const core::Device &device);
 
@@ -40,15 +46,81 @@ struct MeshComponent
 
     void uploadGeometry(std::vector<float> mesh, uint32_t vertexSize);
 
+    ///
+    /// \brief Uploads 2D vertices that are given as separate x and y coordinate arrays.
+    ///
+    /// The coordinates are interleaved to the vec2 vertex layout while they are written to the staging buffer, so
+    /// structure-of-arrays geometry (e.g. a Met3D::PolylineSet) can be uploaded without creating a vertex list first.
+    ///
+    /// Like all uploads of the MeshComponent, the copy is recorded by the UploadManager and submitted before the next
+    /// frame, which draws the new vertices. The previous vertex range is kept alive until then. Uploading no vertices
+    /// releases the previous range.
+    ///
+    void uploadGeometry(const float *x, const float *y, uint32_t vertexCount);
+
+    ///
+    /// \brief Uploads the indices of an indexed mesh, which is then drawn with a single indexed draw.
+    ///
+    /// The vertices are uploaded separately with uploadGeometry(), so that a mesh whose vertices change, e.g. due to
+    /// another projection, keeps its indices. An indexCount of 0 removes the indices.
+    ///
+    void uploadIndices(const uint32_t *indexData, uint32_t indexCount);
+
+    ///
+    /// \brief Starts a streaming upload of 2D polylines, which replaces the current geometry.
+    ///
+    /// The polylines passed to streamPolylines() are written into chunks of streamingStagingSize bytes of the staging
+    /// ring of the UploadManager, which are copied into the vertex range whenever they are full. The draw ranges are
+    /// appended to startIndices and vertexCounts on the fly. The vertex range grows while vertices are streamed, so
+    /// the host memory required does not depend on the size of the geometry.
+    ///
+    void beginStreamingUpload();
+
+    ///
+    /// \brief Appends polylines to a streaming upload, each polyline becomes one draw of a multi-draw mesh.
+    ///
+    void streamPolylines(const Met3D::PolylineSet &polylines);
+
+    ///
+    /// \brief Copies the remaining staged vertices into the vertex range and finishes the streaming upload.
+    ///
+    void endStreamingUpload();
+
     const core::Device &device;
 
-    std::shared_ptr<core::Buffer> vertexBuffer;
-    uint32_t numVertices;
+    // Ranges of the GeometryArena. The draws start at their first vertex and index, see ForwardSubstage::draw().
+    core::GeometryAllocation vertices;
+    uint32_t numVertices = 0;
+    // Meshes with indices are drawn indexed, the draw ranges are ignored.
+    core::GeometryAllocation indices;
+    uint32_t numIndices = 0;
+    // Number of instances of each draw, e.g. repetitions of the globe.
+    uint32_t instanceCount = 1;
     bool shouldDraw = true;
 
     bool multiDraw = false;
     std::vector<int> startIndices;
     std::vector<int> vertexCounts;
+
+    // Levels of detail of a multi-draw mesh. Level i is drawn with the draws [lodDrawOffsets[i], lodDrawOffsets[i + 1])
+    // of startIndices and vertexCounts. If no levels are set, all draws are issued.
+    std::vector<size_t> lodDrawOffsets;
+    uint32_t lod = 0;
+
+    // Ticket of the last upload of the vertices or indices, see UploadManager::isComplete().
+    core::UploadTicket uploadTicket = 0;
+
+  private:
+    void flushStagingBuffer();
+
+    // Size of the staging memory chunks of streaming uploads, 32768 vec2 vertices.
+    static constexpr vk::DeviceSize streamingStagingSize = 256 * 1024;
+
+    core::StagingAllocation streamingStaging;
+    // Vertices of the current streaming upload that are in the staging memory, but not yet in the vertex range.
+    uint32_t numStagedVertices{0};
+    // Number of vertices that fit into the vertex range during a streaming upload.
+    uint32_t vertexCapacity{0};
 };
 
 } // namespace vkf::scene
\ No newline at end of file
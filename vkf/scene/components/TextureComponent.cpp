@@ -13,9 +13,9 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "TextureComponent.h"
-#include "../../core/Buffer.h"
 #include "../../core/Device.h"
 #include "../../core/Image.h"
+#include "../../core/UploadManager.h"
 #include <imgui.h>
 #include <stb_image.h>
 
@@ -51,16 +51,7 @@ core::Image TextureComponent::createImage()
                             .initialLayout = vk::ImageLayout::eUndefined},
         VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT};
 
-    vk::BufferCreateInfo bufferCreateInfo{.size = imageSize, .usage = vk::BufferUsageFlagBits::eTransferSrc};
-    core::Buffer stagingBuffer{device, bufferCreateInfo,
-                               VMA_ALLOCATION_CREATE_MAPPED_BIT |
-                                   VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT};
-
-    stagingBuffer.updateData(pixels, imageSize, 0);
-
-    texture.transitionImageLayout(vk::ImageLayout::eTransferDstOptimal);
-    texture.copyBufferToImage(stagingBuffer);
-    texture.transitionImageLayout(vk::ImageLayout::eShaderReadOnlyOptimal);
+    device.getUploadManager().uploadImage(texture, pixels, imageSize);
 
     stbi_image_free(pixels);
     hasNewTexture = false;
@@ -56,13 +56,7 @@ UUID BasemapActor::create(const core::Device &device, std::deque<core::Pipeline
 
     materialComp.addResource("camera", scene->getCamera()->getHandle());
 
-    vk::BufferCreateInfo bufferModelCreateInfo{.size = sizeof(GeotiffComponent::Data),
-                                               .usage = vk::BufferUsageFlagBits::eUniformBuffer};
-    core::Buffer bufferData{device, bufferModelCreateInfo,
-                            VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT};
-
-    auto entityBufferModelHandle = bindlessManager.storeBuffer(bufferData, vk::BufferUsageFlagBits::eUniformBuffer);
-    materialComp.addResource("data", entityBufferModelHandle);
+    materialComp.addResource("data", bindlessManager.storeVersionedUniform());
 
     auto &geotiffComp = entity.addComponent<scene::GeotiffComponent>(device);
     auto image = geotiffComp.createImage();
@@ -101,7 +95,8 @@ void BasemapActor::updateComponents()
     geotiffComp.data.poleLat = projectionComp.rotatedNorthPoleLatitude;
     geotiffComp.data.poleLon = projectionComp.rotatedNorthPoleLongitude;
 
-    bindlessManager.updateBuffer(materialComp.getResourceIndex("data"), &geotiffComp.data, sizeof(geotiffComp.data), 0);
+    bindlessManager.updateVersionedUniform(materialComp.getResourceIndex("data"), &geotiffComp.data,
+                                           sizeof(geotiffComp.data));
 
     if (geotiffComp.hasNewTexture)
     {
@@ -130,10 +125,16 @@ void BasemapActor::updateComponents()
     }
 }
 
+void BasemapActor::updateFrameUniforms(uint32_t cameraHandle)
+{
+    auto &materialComp = entity.getComponent<MaterialComponent>();
+    materialComp.updateResource("camera", cameraHandle);
+}
+
 void BasemapActor::destroy()
 {
     auto &materialComp = entity.getComponent<MaterialComponent>();
-    bindlessManager.removeBuffer(materialComp.getResourceIndex("data"));
+    bindlessManager.removeVersionedUniform(materialComp.getResourceIndex("data"));
     bindlessManager.removeImage(materialComp.getResourceIndex("texture"));
     entity.destroy();
 }
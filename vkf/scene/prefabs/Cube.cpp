@@ -121,24 +121,10 @@ UUID Cube::create(const core::Device &device, std::deque<core::Pipeline *> pipel
 
         auto &materialComp = child.addComponent<MaterialComponent>(pipelines);
 
+        // The color and model matrix are frame uniforms, which are allocated in updateFrameUniforms().
         materialComp.addResource("camera", scene->getCamera()->getHandle());
-
-        vk::BufferCreateInfo bufferCreateInfo{.size = 16, .usage = vk::BufferUsageFlagBits::eUniformBuffer};
-        core::Buffer bufferColor{device, bufferCreateInfo,
-                                 VMA_ALLOCATION_CREATE_MAPPED_BIT |
-                                     VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT};
-
-        vk::BufferCreateInfo bufferModelCreateInfo{.size = 64, .usage = vk::BufferUsageFlagBits::eUniformBuffer};
-        core::Buffer bufferModel{device, bufferModelCreateInfo,
-                                 VMA_ALLOCATION_CREATE_MAPPED_BIT |
-                                     VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT};
-
-        auto entityBufferHandle = bindlessManager.storeBuffer(bufferColor, vk::BufferUsageFlagBits::eUniformBuffer);
-        materialComp.addResource("color", entityBufferHandle);
-
-        auto entityBufferModelHandle =
-            bindlessManager.storeBuffer(bufferModel, vk::BufferUsageFlagBits::eUniformBuffer);
-        materialComp.addResource("model", entityBufferModelHandle);
+        materialComp.addResource("color", 0);
+        materialComp.addResource("model", 0);
         relationComp.addChild(std::move(child));
     }
 
@@ -202,11 +188,27 @@ void Cube::updateComponents()
             childColorComp.setColor(colorComp.color);
         }
 
+    }
+}
+
+void Cube::updateFrameUniforms(uint32_t cameraHandle)
+{
+    auto &relationComp = entity.getComponent<scene::RelationComponent>();
+    for (const auto &pair : relationComp.children)
+    {
+        auto child = pair.second;
+        auto &transformComp = child->getComponent<scene::TransformComponent>();
+        auto &childColorComp = child->getComponent<scene::ColorComponent>();
+
+        uint32_t modelHandle = bindlessManager.allocateFrameUniform(glm::value_ptr(transformComp.modelMatrix),
+                                                                    sizeof(transformComp.modelMatrix));
+        uint32_t colorHandle = bindlessManager.allocateFrameUniform(glm::value_ptr(childColorComp.color),
+                                                                    sizeof(childColorComp.color));
+
         auto &materialComp = child->getComponent<MaterialComponent>();
-        bindlessManager.updateBuffer(materialComp.getResourceIndex("model"), glm::value_ptr(transformComp.modelMatrix),
-                                     sizeof(transformComp.modelMatrix), 0);
-        bindlessManager.updateBuffer(materialComp.getResourceIndex("color"), glm::value_ptr(childColorComp.color),
-                                     sizeof(childColorComp.color), 0);
+        materialComp.updateResource("camera", cameraHandle);
+        materialComp.updateResource("model", modelHandle);
+        materialComp.updateResource("color", colorHandle);
     }
 }
 
@@ -216,9 +218,6 @@ void Cube::destroy()
     for (const auto &pair : relationComp.children)
     {
         auto child = pair.second;
-        auto &materialComp = child->getComponent<MaterialComponent>();
-        bindlessManager.removeBuffer(materialComp.getResourceIndex("color"));
-        bindlessManager.removeBuffer(materialComp.getResourceIndex("model"));
         child->destroy();
     }
 
@@ -75,6 +75,11 @@ class Cube : public Prefab
     ///
     void updateComponents() override;
 
+    ///
+    /// \brief Allocates the frame uniforms of the Cube entity.
+    ///
+    void updateFrameUniforms(uint32_t cameraHandle) override;
+
     static uint32_t vertexSize;
 
     static std::deque<rendering::PipelineBuilder> getPipelineBuilders(const core::Device &device,
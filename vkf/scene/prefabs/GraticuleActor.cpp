@@ -14,14 +14,21 @@
 
 #include "GraticuleActor.h"
 #include "../../common/Log.h"
+#include "../../common/ThreadPool.h"
 #include "../../common/Utility.h"
 #include "../../core/Shader.h"
 #include "../../rendering/BindlessManager.h"
 #include "../../rendering/PipelineBuilder.h"
 #include "../Camera.h"
 #include "../Scene.h"
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <glm/geometric.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/trigonometric.hpp>
 #include <imgui.h>
+#include <limits>
 
 namespace vkf::scene
 {
@@ -49,43 +56,42 @@ UUID GraticuleActor::create(const core::Device &device, std::deque<core::Pipelin
     auto &bboxComp = entity.addComponent<scene::BoundingBoxComponent>();
     bboxComp.isInput = true;
 
-    vk::BufferCreateInfo bufferModelCreateInfo{.size = 64, .usage = vk::BufferUsageFlagBits::eUniformBuffer};
-    core::Buffer bufferModel{device, bufferModelCreateInfo,
-                             VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT};
+    // The repetition and the graticule change while frames are in flight, so they are versioned uniforms.
+    entityRepetitionUniform = bindlessManager.storeVersionedUniform();
+    entityGraticuleUniform = bindlessManager.storeVersionedUniform();
 
-    entityBufferModelHandle = bindlessManager.storeBuffer(bufferModel, vk::BufferUsageFlagBits::eUniformBuffer);
+    updateDatasetScales();
 
-    std::array<std::string, 3> names = {"Graticule", "Coastline", "Borderline"};
+    std::array<std::string, 4> names = {"Graticule", "Coastline", "Borderline", "Countries"};
     auto &relationComp = entity.getComponent<scene::RelationComponent>();
-    for (uint32_t i = 0; i < 3; ++i)
+    for (uint32_t i = 0; i < names.size(); ++i)
     {
         auto child = Entity(registry);
         child.create();
 
-        child.addComponent<scene::IdComponent>(UUID());
+        auto type = static_cast<GraticuleType>(i);
+        auto childUUID = UUID();
+        childTypes.emplace(childUUID, type);
+
+        child.addComponent<scene::IdComponent>(childUUID);
         child.addComponent<scene::TagComponent>(std::move(names[i]));
-        child.addComponent<scene::ColorComponent>(glm::vec4{1.0f});
+        // The filled countries keep their own color, so that the lines remain visible.
+        child.addComponent<scene::ColorComponent>(type == GraticuleType::Country ? countryFillColor
+                                                                                 : glm::vec4{1.0f});
         child.addComponent<scene::RelationComponent>(entity.getHandle());
 
-        auto &meshComp = child.addComponent<scene::MeshComponent>(device);
-        meshComp.multiDraw = true;
-        uploadGeometry(static_cast<GraticuleType>(i), meshComp);
-
+        child.addComponent<scene::MeshComponent>(device);
         auto &materialComp = child.addComponent<MaterialComponent>(pipelines);
 
+        // The camera, color and model matrix change every frame, see updateFrameUniforms().
         materialComp.addResource("camera", scene->getCamera()->getHandle());
-
-        vk::BufferCreateInfo bufferCreateInfo{.size = 16, .usage = vk::BufferUsageFlagBits::eUniformBuffer};
-        core::Buffer bufferColor{device, bufferCreateInfo,
-                                 VMA_ALLOCATION_CREATE_MAPPED_BIT |
-                                     VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT};
-
-        auto entityBufferHandle = bindlessManager.storeBuffer(bufferColor, vk::BufferUsageFlagBits::eUniformBuffer);
-        materialComp.addResource("color", entityBufferHandle);
-
-        materialComp.addResource("model", entityBufferModelHandle);
+        materialComp.addResource("color", 0);
+        materialComp.addResource("model", 0);
+        materialComp.addResource("repetition", entityRepetitionUniform);
+        materialComp.addResource("graticule", entityGraticuleUniform);
         relationComp.addChild(std::move(child));
     }
+    updateGeometry();
 
     LOG_INFO("Prefab GraticuleActor created")
     return prefabUUID;
@@ -137,9 +143,7 @@ void GraticuleActor::updateGui()
 
 void GraticuleActor::updateComponents()
 {
-    auto &transformComp = entity.getComponent<scene::TransformComponent>();
     auto &graticuleComp = entity.getComponent<scene::GraticuleComponent>();
-    uint32_t graticule{};
     auto &bboxComp = entity.getComponent<scene::BoundingBoxComponent>();
 
     if (bboxComp.hasNewBbox)
@@ -154,189 +158,784 @@ void GraticuleActor::updateComponents()
 
     this->prevColor = colorComp.color;
 
+    if (updateDatasetScales())
+    {
+        graticuleComp.hasNewGraticule = true;
+    }
+
+    if (graticuleComp.hasNewGraticule)
+    {
+        updateGeometry();
+    }
+
+    uint32_t lod = selectLevelOfDetail();
+
     auto &relationComp = entity.getComponent<scene::RelationComponent>();
     for (const auto &pair : relationComp.children)
     {
         auto child = pair.second;
-        if (graticuleComp.hasNewGraticule)
-        {
-            auto &meshComp = child->getComponent<scene::MeshComponent>();
-            uploadGeometry(static_cast<GraticuleType>(graticule++), meshComp);
-        }
+        GraticuleType type = childTypes.at(pair.first);
+        auto &meshComp = child->getComponent<scene::MeshComponent>();
+        meshComp.lod = lod;
 
         auto &childColorComp = child->getComponent<scene::ColorComponent>();
 
-        if (colorChanged)
+        if (colorChanged && type != GraticuleType::Country)
         {
             childColorComp.setColor(colorComp.color);
         }
-
-        auto &materialComp = child->getComponent<MaterialComponent>();
-        bindlessManager.updateBuffer(materialComp.getResourceIndex("model"), glm::value_ptr(transformComp.modelMatrix),
-                                     sizeof(transformComp.modelMatrix), 0);
-        bindlessManager.updateBuffer(materialComp.getResourceIndex("color"), glm::value_ptr(childColorComp.color),
-                                     sizeof(childColorComp.color), 0);
     }
 
+    bindlessManager.updateVersionedUniform(entityRepetitionUniform, &globeRepetition, sizeof(globeRepetition));
+    bindlessManager.updateVersionedUniform(entityGraticuleUniform, &proceduralGraticule, sizeof(proceduralGraticule));
+
     if (graticuleComp.hasNewGraticule)
     {
         graticuleComp.hasNewGraticule = false;
     }
 }
 
+void GraticuleActor::updateFrameUniforms(uint32_t cameraHandle)
+{
+    // The children share the model matrix of the actor.
+    auto &transformComp = entity.getComponent<scene::TransformComponent>();
+    uint32_t modelHandle = bindlessManager.allocateFrameUniform(glm::value_ptr(transformComp.modelMatrix),
+                                                                sizeof(transformComp.modelMatrix));
+
+    auto &relationComp = entity.getComponent<scene::RelationComponent>();
+    for (const auto &pair : relationComp.children)
+    {
+        auto child = pair.second;
+        auto &childColorComp = child->getComponent<scene::ColorComponent>();
+        uint32_t colorHandle = bindlessManager.allocateFrameUniform(glm::value_ptr(childColorComp.color),
+                                                                    sizeof(childColorComp.color));
+
+        auto &materialComp = child->getComponent<MaterialComponent>();
+        materialComp.updateResource("camera", cameraHandle);
+        materialComp.updateResource("model", modelHandle);
+        materialComp.updateResource("color", colorHandle);
+    }
+}
+
 void GraticuleActor::destroy()
 {
     auto &relationComp = entity.getComponent<scene::RelationComponent>();
 
-    bindlessManager.removeBuffer(entityBufferModelHandle);
+    bindlessManager.removeVersionedUniform(entityRepetitionUniform);
+    bindlessManager.removeVersionedUniform(entityGraticuleUniform);
     for (const auto &pair : relationComp.children)
     {
         auto child = pair.second;
-        auto &materialComp = child->getComponent<MaterialComponent>();
-        bindlessManager.removeBuffer(materialComp.getResourceIndex("color"));
         child->destroy();
     }
     entity.destroy();
 }
 
-void GraticuleActor::uploadGeometry(GraticuleType type, MeshComponent &meshComp)
+void GraticuleActor::updateGeometry()
 {
-    LOG_DEBUG("Generating graticule and coast-/borderline geometry...")
+    auto &relationComp = entity.getComponent<scene::RelationComponent>();
+    bool shouldStreamGeometry = entity.getComponent<scene::GraticuleComponent>().streamGeometry;
+
+    struct GeneratedGeometry
+    {
+        // Only set if the projected geometry was not cached.
+        std::shared_ptr<const GraticuleGeometryCache::ProjectedGeometry> projectedGeometry;
+        GraticuleGeometryCache::ClippedGeometry clippedGeometry;
+    };
+
+    struct MeshUpdate
+    {
+        GraticuleType type;
+        GraticuleGeometryKey key;
+        MeshComponent *meshComp;
+        MaterialComponent *materialComp;
+        std::shared_ptr<const GraticuleGeometryCache::ClippedGeometry> clippedGeometry;
+        std::future<GeneratedGeometry> generation;
+    };
+
+    std::vector<MeshUpdate> updates;
+    updates.reserve(relationComp.children.size());
+    for (const auto &pair : relationComp.children)
+    {
+        GraticuleType type = childTypes.at(pair.first);
+        updates.push_back(MeshUpdate{.type = type,
+                                     .key = createGeometryKey(type),
+                                     .meshComp = &pair.second->getComponent<scene::MeshComponent>(),
+                                     .materialComp = &pair.second->getComponent<MaterialComponent>()});
+    }
+    if (updates.empty())
+    {
+        return;
+    }
 
+    // All children share the projection.
+    updateGlobeRepetition(updates.front().key.mapProjection);
+
+    // Reuse the results of earlier updates as far as possible: the clipped
+    // geometry if a previous configuration is restored, the projected
+    // geometry if only the bounding box has changed. The remaining geometry
+    // of all children is generated concurrently, each task with a
+    // GeometryHandling instance and proj context of its own.
+    auto usesPolylineGeometry = [&](const MeshUpdate &update) {
+        switch (update.type)
+        {
+        case GraticuleType::Graticule:
+            // The shader generates the graticule for all projections it
+            // implements, so that changing its parameters only requires a
+            // uniform update.
+            return update.key.mapProjection == ProjectionType::PROJ_LIBRARY;
+        case GraticuleType::Coastline:
+        case GraticuleType::Borderline:
+            return !shouldStreamGeometry;
+        case GraticuleType::Country:
+            return false;
+        }
+        return false;
+    };
+
+    for (MeshUpdate &update : updates)
+    {
+        if (!usesPolylineGeometry(update))
+        {
+            continue;
+        }
+        update.clippedGeometry = geometryCache.findClippedGeometry(update.key, bbox);
+        if (update.clippedGeometry)
+        {
+            continue;
+        }
+
+        std::shared_ptr<const GraticuleGeometryCache::ProjectedGeometry> cachedGeometry =
+            geometryCache.findProjectedGeometry(update.key);
+        update.generation = std::async(std::launch::async, [this, key = update.key, cachedGeometry]() {
+            // Proj contexts must not be used by two threads at once, hence
+            // every task projects its geometry in a context of its own.
+            PJ_CONTEXT *projContext = proj_context_create();
+            GeneratedGeometry generated;
+            if (!cachedGeometry)
+            {
+                generated.projectedGeometry =
+                    GraticuleGeometryCache::createProjectedGeometry(generateProjectedGeometry(key, projContext));
+            }
+            generated.clippedGeometry =
+                clipGeometry(key, cachedGeometry ? *cachedGeometry : *generated.projectedGeometry);
+            proj_context_destroy(projContext);
+            return generated;
+        });
+    }
+
+    for (MeshUpdate &update : updates)
+    {
+        if (!update.generation.valid())
+        {
+            continue;
+        }
+        GeneratedGeometry generated = update.generation.get();
+        if (generated.projectedGeometry)
+        {
+            geometryCache.storeProjectedGeometry(update.key, std::move(generated.projectedGeometry));
+        }
+        update.clippedGeometry =
+            geometryCache.storeClippedGeometry(update.key, bbox, std::move(generated.clippedGeometry));
+    }
+
+    // The uploads of all children are recorded by the UploadManager and submitted together before the next frame.
+    Met3D::GeometryHandling geo;
+    uint32_t lod = selectLevelOfDetail();
+    for (MeshUpdate &update : updates)
+    {
+        MeshComponent &meshComp = *update.meshComp;
+        MaterialComponent &materialComp = *update.materialComp;
+        meshComp.instanceCount = numGlobeRepetitions;
+
+        if (update.type == GraticuleType::Country)
+        {
+            materialComp.setPipeline(filledPolygonPipelineIndex);
+            uploadFilledPolygons(update.key, meshComp);
+            continue;
+        }
+
+        if (update.type == GraticuleType::Graticule && !usesPolylineGeometry(update))
+        {
+            updateProceduralGraticule(update.key, meshComp);
+            materialComp.setPipeline(proceduralGraticulePipelineIndex);
+            continue;
+        }
+        materialComp.setPipeline(polylinePipelineIndex);
+
+        if (!usesPolylineGeometry(update))
+        {
+            streamGeometry(update.key, meshComp);
+            continue;
+        }
+
+        // The polyline set already stores the vertices contiguously, only the
+        // draw ranges need to be extracted.
+        const GraticuleGeometryCache::ClippedGeometry &clippedGeometry = *update.clippedGeometry;
+        geo.flattenPolygonsToVertexList(clippedGeometry.polylines, &meshComp.startIndices, &meshComp.vertexCounts);
+        meshComp.multiDraw = true;
+        meshComp.lodDrawOffsets = clippedGeometry.lodDrawOffsets;
+        meshComp.lod = lod;
+
+        meshComp.uploadGeometry(clippedGeometry.polylines.getX(), clippedGeometry.polylines.getY(),
+                                static_cast<uint32_t>(clippedGeometry.polylines.getNumVertices()));
+    }
+}
+
+void GraticuleActor::updateProceduralGraticule(const GraticuleGeometryKey &key, MeshComponent &meshComp)
+{
+    // Use the same meridians, parallels and vertices as
+    // GeometryHandling::generate2DGraticuleGeometry().
+    std::vector<float> longitudes =
+        createRange(key.graticuleLongitudes[0], key.graticuleLongitudes[1], key.graticuleLongitudes[2]);
+    std::vector<float> latitudes =
+        createRange(key.graticuleLatitudes[0], key.graticuleLatitudes[1], key.graticuleLatitudes[2]);
+    std::sort(longitudes.begin(), longitudes.end());
+    std::sort(latitudes.begin(), latitudes.end());
+
+    float lonVertexSpacing = key.graticuleSpacingLongitude > 0.0f ? key.graticuleSpacingLongitude : 1.0f;
+    float latVertexSpacing = key.graticuleSpacingLatitude > 0.0f ? key.graticuleSpacingLatitude : 1.0f;
+
+    auto getStep = [](const std::vector<float> &values) { return values.size() > 1 ? values[1] - values[0] : 0.0f; };
+
+    // The vertices of a line are accumulated in float as in
+    // generate2DGraticuleGeometry(), so the number of segments is counted the
+    // same way instead of being computed from the extent of the line.
+    auto countSegments = [](float first, float last, float spacing) {
+        uint32_t numVertices = 0;
+        for (float value = first; value <= last; value += spacing)
+        {
+            numVertices++;
+        }
+        return numVertices > 0 ? numVertices - 1 : 0;
+    };
+
+    // As on the CPU, meridians require at least two latitudes and parallels
+    // at least two longitudes. A single longitude or latitude gives a single
+    // meridian or parallel, whose distance to the next one is unused.
+    proceduralGraticule = ProceduralGraticule{};
+    if (!longitudes.empty() && latitudes.size() > 1)
+    {
+        proceduralGraticule.meridians =
+            glm::vec4(longitudes.front(), getStep(longitudes), latitudes.front(), latVertexSpacing);
+        proceduralGraticule.counts.x = static_cast<uint32_t>(longitudes.size());
+        proceduralGraticule.counts.y = countSegments(latitudes.front(), latitudes.back(), latVertexSpacing);
+    }
+    if (!latitudes.empty() && longitudes.size() > 1)
+    {
+        proceduralGraticule.parallels =
+            glm::vec4(latitudes.front(), getStep(latitudes), longitudes.front(), lonVertexSpacing);
+        proceduralGraticule.counts.z = static_cast<uint32_t>(latitudes.size());
+        proceduralGraticule.counts.w = countSegments(longitudes.front(), longitudes.back(), lonVertexSpacing);
+    }
+
+    proceduralGraticule.rotatedPole =
+        glm::vec4(key.rotatedNorthPoleLongitude, key.rotatedNorthPoleLatitude,
+                  key.mapProjection == ProjectionType::ROTATEDLATLON ? 1.0f : 0.0f, rotatedGridMaxSegmentLength_deg);
+
+    // Every segment is drawn as a separate line of two vertices. The vertices
+    // of a previous polyline graticule are released, so that their offset in
+    // the geometry arena is not added to gl_VertexIndex.
+    const glm::uvec4 &counts = proceduralGraticule.counts;
+    meshComp.vertices.reset();
+    meshComp.multiDraw = false;
+    meshComp.startIndices.clear();
+    meshComp.vertexCounts.clear();
+    meshComp.lodDrawOffsets.clear();
+    meshComp.lod = 0;
+    meshComp.numVertices = 2 * (counts.x * counts.y + counts.z * counts.w);
+}
+
+GraticuleGeometryKey GraticuleActor::createGeometryKey(GraticuleType type)
+{
     auto &graticuleComp = entity.getComponent<scene::GraticuleComponent>();
     auto &projectionComp = entity.getComponent<scene::ProjectionComponent>();
 
+    GraticuleGeometryKey key{};
+    key.type = type;
+    key.mapProjection = projectionComp.mapProjection;
+
+    // The graticule is densified as accurately as the coastlines drawn with it.
+    NaturalEarthScale scale = datasetScales[0];
+    switch (type)
+    {
+    case GraticuleType::Graticule:
+        key.graticuleLongitudes = graticuleComp.graticuleLongitudes;
+        key.graticuleLatitudes = graticuleComp.graticuleLatitudes;
+        key.graticuleSpacingLongitude = graticuleComp.graticuleSpacingLongitude;
+        key.graticuleSpacingLatitude = graticuleComp.graticuleSpacingLatitude;
+        break;
+    case GraticuleType::Coastline:
+        key.dataset = NaturalEarthRegistry::getShared().getPath(NaturalEarthLayer::Coastline, datasetScales[0]);
+        break;
+    case GraticuleType::Borderline:
+        scale = datasetScales[1];
+        key.dataset = NaturalEarthRegistry::getShared().getPath(NaturalEarthLayer::Borderline, scale);
+        break;
+    case GraticuleType::Country:
+        scale = datasetScales[2];
+        key.dataset = NaturalEarthRegistry::getShared().getPath(NaturalEarthLayer::Country, scale);
+        break;
+    }
+
+    if (key.mapProjection == ProjectionType::PROJ_LIBRARY)
+    {
+        key.projLibraryString = projectionComp.projLibraryString;
+    }
+    else if (key.mapProjection == ProjectionType::ROTATEDLATLON)
+    {
+        key.rotatedNorthPoleLongitude = projectionComp.rotatedNorthPoleLongitude;
+        key.rotatedNorthPoleLatitude = projectionComp.rotatedNorthPoleLatitude;
+    }
+
+    // Densifying more accurately than the positional error of the dataset
+    // would not be visible. Since the dataset scale follows the zoom level,
+    // so does the densification.
+    if (key.mapProjection != ProjectionType::CYLINDRICAL)
+    {
+        key.densificationTolerance_deg = NaturalEarthRegistry::getNominalError(scale);
+    }
+
+    return key;
+}
+
+Met3D::PolylineSet GraticuleActor::generateProjectedGeometry(const GraticuleGeometryKey &key,
+                                                             PJ_CONTEXT *projContext)
+{
+    LOG_DEBUG("Generating graticule and coast-/borderline geometry...")
+
     // Instantiate utility class for geometry handling.
-    Met3D::GeometryHandling geo;
-    geo.initProjProjection(projectionComp.projLibraryString);
-
-    auto rotatedNorthPole =
-        Met3D::PointF(projectionComp.rotatedNorthPoleLongitude, projectionComp.rotatedNorthPoleLatitude);
-    geo.initRotatedLonLatProjection(rotatedNorthPole);
-
-    // Heuristic value to eliminate line segments that after projection cross
-    // the map domain due to a connection that after projection is invalid.
-    // This happens when a line segment that connects two closeby vertices after
-    // projection leaves e.g. the eastern side of the map and re-enters on the
-    // western side (or vice versa).
-    // A value of "20deg" seems to work well with global data from NaturalEarth.
-    // NOTE (mr, 28Oct2020): This is "quick&dirty" workaround. The correct
-    // approach to this would be to perform some sort of test that checks if
-    // the correct connection of the two vertices after projection should cross
-    // map boundaries, in such as case the segment needs to be broken up.
-    // Another approach to this was previously implemented in BT's code, see
-    // Met.3D version 1.6 or earlier.
-    double rotatedGridMaxSegmentLength_deg = 20.;
+    Met3D::GeometryHandling geo(projContext);
+    initGeometryHandling(&geo, key);
 
     // Get bounding box in which the graticule will be displayed.
     auto geometryLimits = Met3D::RectF(-180., -90., 180., 90.);
 
-    std::vector<float> geometry;
+    // All stages of the geometry pipeline work on polyline sets allocated
+    // from the memory pool of the geometry handling object. Only the result,
+    // which is stored in the geometry cache, uses the default allocator.
+    Met3D::PolylineSet geometry{geo.getPolylineMemoryResource()};
+    Met3D::PolylineSet projectedGeometry;
 
-    switch (type)
+    switch (key.type)
     {
     case GraticuleType::Graticule: {
         // Generate graticule geometry.
         // ============================
         std::vector<float> graticuleLongitudes =
-            createRange(graticuleComp.graticuleLongitudes[0], graticuleComp.graticuleLongitudes[1],
-                        graticuleComp.graticuleLongitudes[2]);
+            createRange(key.graticuleLongitudes[0], key.graticuleLongitudes[1], key.graticuleLongitudes[2]);
         std::vector<float> graticuleLatitudes =
-            createRange(graticuleComp.graticuleLatitudes[0], graticuleComp.graticuleLatitudes[1],
-                        graticuleComp.graticuleLatitudes[2]);
+            createRange(key.graticuleLatitudes[0], key.graticuleLatitudes[1], key.graticuleLatitudes[2]);
 
-        Met3D::Vector2D graticuleSpacing = Met3D::Vector2D(
-            Met3D::PointF(graticuleComp.graticuleSpacingLongitude, graticuleComp.graticuleSpacingLatitude));
+        Met3D::Vector2D graticuleSpacing =
+            Met3D::Vector2D(Met3D::PointF(key.graticuleSpacingLongitude, key.graticuleSpacingLatitude));
 
-        // Generate graticule geometry.
-        std::vector<std::vector<Met3D::PointF>> graticule =
-            geo.generate2DGraticuleGeometry(graticuleLongitudes, graticuleLatitudes, graticuleSpacing);
-
-        // Project and clip the generated graticule geometry.
-        graticule = projectAndClipGeometry(&geo, graticule, bbox, rotatedGridMaxSegmentLength_deg);
+        // Densified projections insert vertices where the projected lines
+        // curve, so the lines start from a coarse sampling. The coarse
+        // spacing is a multiple of the configured spacing that still ends
+        // each line on the last meridian or parallel.
+        if (key.densificationTolerance_deg > 0.0f)
+        {
+            auto getCoarseSpacing = [](float spacing, const std::vector<float> &values) {
+                if (spacing <= 0.0f || values.size() < 2)
+                {
+                    return spacing;
+                }
+                auto [minValue, maxValue] = std::minmax_element(values.begin(), values.end());
+                float numSteps = std::round((*maxValue - *minValue) / spacing);
+                for (float factor = std::floor(coarseGraticuleVertexSpacing_deg / spacing); factor > 1.0f; factor--)
+                {
+                    if (std::fmod(numSteps, factor) == 0.0f)
+                    {
+                        return spacing * factor;
+                    }
+                }
+                return spacing;
+            };
+            graticuleSpacing.x = getCoarseSpacing(key.graticuleSpacingLongitude, graticuleLongitudes);
+            graticuleSpacing.y = getCoarseSpacing(key.graticuleSpacingLatitude, graticuleLatitudes);
+        }
 
-        // Convert list of polygons to vertex list for OpenGL rendering.
-        std::vector<float> verticesGraticule;
-        geo.flattenPolygonsToVertexList(graticule, &verticesGraticule, &meshComp.startIndices, &meshComp.vertexCounts);
-        LOG_DEBUG("Graticule and coast-/borderline geometry was generated.")
-        geometry = verticesGraticule;
+        // Generate graticule geometry.
+        geo.generate2DGraticuleGeometry(graticuleLongitudes, graticuleLatitudes, graticuleSpacing, &geometry);
         break;
     }
-    case GraticuleType::Coastline: {
-        // Read coastline geometry from shapefile.
-        // =======================================
+    case GraticuleType::Coastline:
+    case GraticuleType::Borderline: {
+        // Read coast- or borderline geometry from shapefile.
+        // ==================================================
 
         // For projection and clippling to work correctly, we load coastline and
         // borderline geometry on the entire globe, then clip to the bounding
         // box after projection. Performance seems to be accaptable (mr, 28Oct2020).
+        geo.read2DGeometryFromShapefile(key.dataset, geometryLimits, &geometry);
+        break;
+    }
+    default:
+        LOG_ERROR("Graticule type not supported.")
+        return projectedGeometry;
+    }
+
+    projectGeometry(&geo, key, &geometry, &projectedGeometry);
+    LOG_DEBUG("Graticule and coast-/borderline geometry was generated.")
+    return projectedGeometry;
+}
 
-        std::string coastFile = PROJECT_ROOT_DIR + std::string("/assets/ne_50m_coastline/ne_50m_coastline.shp");
-        std::vector<std::vector<Met3D::PointF>> coastlines = geo.read2DGeometryFromShapefile(coastFile, geometryLimits);
+void GraticuleActor::streamGeometry(const GraticuleGeometryKey &key, MeshComponent &meshComp)
+{
+    LOG_DEBUG("Streaming coast-/borderline geometry...")
 
-        coastlines = projectAndClipGeometry(&geo, coastlines, bbox, rotatedGridMaxSegmentLength_deg);
+    Met3D::GeometryHandling geo;
+    initGeometryHandling(&geo, key);
 
-        std::vector<float> verticesCoastlines;
-        geo.flattenPolygonsToVertexList(coastlines, &verticesCoastlines, &meshComp.startIndices,
-                                        &meshComp.vertexCounts);
-        LOG_DEBUG("Graticule and coast-/borderline geometry was generated.")
-        geometry = verticesCoastlines;
-        break;
+    auto geometryLimits = Met3D::RectF(-180., -90., 180., 90.);
+    Met3D::RectF clipRect = getClipRect(key.mapProjection);
+    Met3D::PolylineSet clippedChunk{geo.getPolylineMemoryResource()};
+
+    meshComp.beginStreamingUpload();
+    bool success = geo.read2DGeometryFromShapefileInChunks(
+        key.dataset, geometryLimits, maxVerticesPerStreamedChunk, [&](Met3D::PolylineSet *chunk) {
+            projectPolylines(&geo, key, chunk);
+            clippedChunk.clear();
+            geo.clipPolygons(*chunk, clipRect, &clippedChunk);
+            meshComp.streamPolylines(clippedChunk);
+        });
+    meshComp.endStreamingUpload();
+
+    meshComp.multiDraw = true;
+    meshComp.lodDrawOffsets.clear();
+    meshComp.lod = 0;
+
+    if (!success)
+    {
+        LOG_ERROR("Could not stream geometry from shapefile {}.", key.dataset)
+        return;
     }
-    case GraticuleType::Borderline: {
-        // Read borderline geometry from shapefile.
-        // ========================================
-
-        std::string borderFile =
-            PROJECT_ROOT_DIR +
-            std::string("/assets/ne_50m_admin_0_boundary_lines_land/ne_50m_admin_0_boundary_lines_land.shp");
-        std::vector<std::vector<Met3D::PointF>> borderlines =
-            geo.read2DGeometryFromShapefile(borderFile, geometryLimits);
-
-        borderlines = projectAndClipGeometry(&geo, borderlines, bbox, rotatedGridMaxSegmentLength_deg);
-
-        std::vector<float> verticesBorderlines;
-        geo.flattenPolygonsToVertexList(borderlines, &verticesBorderlines, &meshComp.startIndices,
-                                        &meshComp.vertexCounts);
-        LOG_DEBUG("Graticule and coast-/borderline geometry was generated.")
-        geometry = verticesBorderlines;
-        break;
+    LOG_DEBUG("Coast-/borderline geometry was streamed.")
+}
+
+void GraticuleActor::uploadFilledPolygons(const GraticuleGeometryKey &key, MeshComponent &meshComp)
+{
+    meshComp.multiDraw = false;
+    meshComp.lodDrawOffsets.clear();
+    meshComp.lod = 0;
+    meshComp.shouldDraw = entity.getComponent<scene::GraticuleComponent>().fillCountries;
+    if (!meshComp.shouldDraw)
+    {
+        return;
     }
-    default:
-        LOG_ERROR("Graticule type not supported.")
+
+    // The projected mesh only depends on the dataset and the projection, a
+    // change of the bbox keeps the uploaded mesh.
+    if (uploadedCountryPolygonsKey == key)
+    {
+        meshComp.shouldDraw = hasUploadedCountryPolygons;
+        return;
+    }
+    uploadedCountryPolygonsKey.reset();
+
+    Met3D::GeometryHandling geo;
+    if (countryPolygonsDataset != key.dataset)
+    {
+        countryPolygonsDataset.clear();
+        if (!geo.read2DPolygonsFromShapefile(key.dataset, &countryPolygons))
+        {
+            LOG_ERROR("Could not read country polygons from shapefile {}.", key.dataset)
+            meshComp.shouldDraw = false;
+            return;
+        }
+        countryPolygonsDataset = key.dataset;
+    }
+
+    // Only the vertices are transformed, the triangles are reused.
+    size_t numVertices = countryPolygons.getNumVertices();
+    std::vector<float> x = countryPolygons.x;
+    std::vector<float> y = countryPolygons.y;
+    initGeometryHandling(&geo, key);
+    if (key.mapProjection == ProjectionType::PROJ_LIBRARY)
+    {
+        // Failed points are set to NaN by the transformation.
+        std::vector<double> projectedX(x.begin(), x.end());
+        std::vector<double> projectedY(y.begin(), y.end());
+        geo.geographicalToProjectedCoordinates(projectedX.data(), projectedY.data(), numVertices);
+        for (size_t i = 0; i < numVertices; i++)
+        {
+            x[i] = static_cast<float>(projectedX[i]);
+            y[i] = static_cast<float>(projectedY[i]);
+        }
+    }
+    else if (key.mapProjection == ProjectionType::ROTATEDLATLON)
+    {
+        geo.geographicalToRotatedCoordinates(x.data(), y.data(), x.data(), y.data(), numVertices);
+    }
+
+    // Drop the triangles that could not be projected and those that wrap
+    // around the map: in proj projections the triangles with an edge across
+    // the domain boundary, tested on the geographical vertices like the
+    // polylines, and in rotated lon-lat projections the triangles that span
+    // more than half of the map after the rotation.
+    std::vector<uint32_t> indices;
+    indices.reserve(countryPolygons.indices.size());
+    for (size_t i = 0; i < countryPolygons.indices.size(); i += 3)
+    {
+        const uint32_t *triangle = countryPolygons.indices.data() + i;
+        float minX = std::numeric_limits<float>::infinity();
+        float maxX = -std::numeric_limits<float>::infinity();
+        bool isFinite = true;
+        bool canConnect = true;
+        for (size_t corner = 0; corner < 3; corner++)
+        {
+            float vertexX = x[triangle[corner]];
+            isFinite = isFinite && std::isfinite(vertexX) && std::isfinite(y[triangle[corner]]);
+            minX = std::min(minX, vertexX);
+            maxX = std::max(maxX, vertexX);
+
+            if (key.mapProjection == ProjectionType::PROJ_LIBRARY)
+            {
+                uint32_t next = triangle[(corner + 1) % 3];
+                Met3D::PointF p1{countryPolygons.x[triangle[corner]], countryPolygons.y[triangle[corner]]};
+                Met3D::PointF p2{countryPolygons.x[next], countryPolygons.y[next]};
+                canConnect = canConnect && geo.canConnectPointPairInDstProjection(p1, p2);
+            }
+        }
+        if (!isFinite || !canConnect || (key.mapProjection == ProjectionType::ROTATEDLATLON && maxX - minX > 180.0f))
+        {
+            continue;
+        }
+        indices.insert(indices.end(), triangle, triangle + 3);
+    }
+
+    uploadedCountryPolygonsKey = key;
+    hasUploadedCountryPolygons = !indices.empty();
+    if (!hasUploadedCountryPolygons)
+    {
+        meshComp.shouldDraw = false;
         return;
     }
 
-    meshComp.uploadGeometry(geometry, vertexSize);
+    meshComp.uploadGeometry(x.data(), y.data(), static_cast<uint32_t>(numVertices));
+    meshComp.uploadIndices(indices.data(), static_cast<uint32_t>(indices.size()));
+}
+
+Met3D::RectF GraticuleActor::getClipRect(ProjectionType mapProjection) const
+{
+    // If the bbox of a cylindrical projection exceeds the globe, the globe is
+    // repeated by instancing and the shader clips the repetitions in x.
+    if (mapProjection == ProjectionType::CYLINDRICAL && (bbox.left < -180. || bbox.right > 180.))
+    {
+        return Met3D::RectF(-180., bbox.top, 180., bbox.bottom);
+    }
+    return bbox;
+}
+
+GraticuleGeometryCache::ClippedGeometry GraticuleActor::clipGeometry(
+    const GraticuleGeometryKey &key, const GraticuleGeometryCache::ProjectedGeometry &projectedGeometry)
+{
+    Met3D::GeometryHandling geo;
+    GraticuleGeometryCache::ClippedGeometry clippedGeometry;
+
+    // Clip line geometry to the bounding box that is rendered. The spatial
+    // index restricts clipping to the polylines near the bbox.
+    geo.clipPolygons(projectedGeometry.polylines, projectedGeometry.index, getClipRect(key.mapProjection),
+                     &clippedGeometry.polylines);
+
+    // Append the coarser levels of detail behind the full resolution
+    // geometry. All levels are uploaded at once, so that switching between
+    // them only changes the range of polylines that is drawn.
+    Met3D::PolylineSet &polylines = clippedGeometry.polylines;
+    std::pmr::vector<float> tolerances(polylines.getNumVertices(), geo.getPolylineMemoryResource());
+    geo.computeSimplificationTolerances(polylines, tolerances.data());
+
+    Met3D::PolylineSet simplifiedGeometry{geo.getPolylineMemoryResource()};
+    float bboxSize = std::max(bbox.width(), std::abs(bbox.height()));
+    for (float toleranceFraction : lodToleranceFractions)
+    {
+        geo.simplifyPolylines(polylines, tolerances.data(), toleranceFraction * bboxSize, &simplifiedGeometry);
+    }
+
+    size_t numPolylines = polylines.getNumPolylines();
+    clippedGeometry.lodDrawOffsets.assign(1, 0);
+    for (size_t level = 0; level <= lodToleranceFractions.size(); level++)
+    {
+        clippedGeometry.lodDrawOffsets.push_back(clippedGeometry.lodDrawOffsets.back() + numPolylines);
+    }
+    polylines.appendPolylines(simplifiedGeometry);
+
+    return clippedGeometry;
 }
 
-std::vector<std::vector<Met3D::PointF>> GraticuleActor::projectAndClipGeometry(
-    Met3D::GeometryHandling *geo, std::vector<std::vector<Met3D::PointF>> geometry, Met3D::RectF bbox,
-    double rotatedGridMaxSegmentLength_deg)
+float GraticuleActor::getVisibleMapHeight()
+{
+    auto &transformComp = entity.getComponent<scene::TransformComponent>();
+    Camera *camera = transformComp.camera;
+
+    // The map lies in the xz-plane of the model.
+    float distance = glm::length(camera->getPosition() - camera->getTarget());
+    return 2.0f * distance * std::tan(glm::radians(camera->getFieldOfView()) / 2.0f) /
+           std::max(transformComp.scale.x, transformComp.scale.z);
+}
+
+bool GraticuleActor::updateDatasetScales()
 {
     auto &projectionComp = entity.getComponent<scene::ProjectionComponent>();
 
-    // Projection-dependent operations.
-    if (projectionComp.mapProjection == ProjectionType::CYLINDRICAL)
+    float mapUnitsPerDegree =
+        projectionComp.mapProjection == ProjectionType::PROJ_LIBRARY ? projMapUnitsPerDegree : 1.0f;
+    float maxError_deg = datasetMaxScreenError * getVisibleMapHeight() / mapUnitsPerDegree;
+
+    auto &naturalEarth = NaturalEarthRegistry::getShared();
+    std::array<NaturalEarthLayer, 3> layers = {NaturalEarthLayer::Coastline, NaturalEarthLayer::Borderline,
+                                               NaturalEarthLayer::Country};
+    bool changed = false;
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        NaturalEarthScale scale = naturalEarth.selectScale(layers[i], maxError_deg);
+        if (scale != datasetScales[i])
+        {
+            LOG_DEBUG("Switching {} to {}", naturalEarth.getPath(layers[i], datasetScales[i]),
+                      naturalEarth.getPath(layers[i], scale))
+            datasetScales[i] = scale;
+            changed = true;
+        }
+        // Prefetching caches polylines, the countries are cached as triangulations when they are filled.
+        if (layers[i] != NaturalEarthLayer::Country)
+        {
+            naturalEarth.prefetchNeighbours(layers[i], scale);
+        }
+    }
+    return changed;
+}
+
+uint32_t GraticuleActor::selectLevelOfDetail()
+{
+    // Select the coarsest level whose simplification error is not visible.
+    float maxError = lodMaxScreenError * getVisibleMapHeight();
+    float bboxSize = std::max(bbox.width(), std::abs(bbox.height()));
+    uint32_t lod = 0;
+    for (size_t level = 0; level < lodToleranceFractions.size(); level++)
     {
-        // Cylindrical projections may display bounding boxed outside the
-        // -180..180 degrees range, hence enlarge the geometry if required.
-        // TODO: Joshua: This doesn't work correctly yet with bigger bounding boxes.
-        geometry = geo->enlargeGeometryToBBoxIfNecessary(geometry, bbox);
+        if (lodToleranceFractions[level] * bboxSize <= maxError)
+        {
+            lod = static_cast<uint32_t>(level) + 1;
+        }
     }
-    else if (projectionComp.mapProjection == ProjectionType::PROJ_LIBRARY)
+    return lod;
+}
+
+void GraticuleActor::updateGlobeRepetition(ProjectionType mapProjection)
+{
+    globeRepetition.clipRect = glm::vec4(bbox.left, bbox.top, bbox.right, bbox.bottom);
+    globeRepetition.firstShift = 0.0f;
+    globeRepetition.shift = 0.0f;
+    numGlobeRepetitions = 1;
+
+    if (mapProjection != ProjectionType::CYLINDRICAL)
     {
-        geometry = geo->geographicalToProjectedCoordinates(geometry);
+        return;
     }
-    else if (projectionComp.mapProjection == ProjectionType::ROTATEDLATLON)
+
+    // Globe i covers the longitudes [-180 + i * 360, 180 + i * 360], draw all
+    // globes that intersect the bbox.
+    auto firstGlobe = static_cast<int32_t>(std::floor((bbox.left - 180.0f) / 360.0f)) + 1;
+    auto lastGlobe = static_cast<int32_t>(std::ceil((bbox.right + 180.0f) / 360.0f)) - 1;
+    if (lastGlobe < firstGlobe)
     {
-        geometry = geo->geographicalToRotatedCoordinates(geometry);
-        geometry = geo->splitLineSegmentsLongerThanThreshold(geometry, rotatedGridMaxSegmentLength_deg);
+        return;
     }
 
-    // Clip line geometry to the bounding box that is rendered.
-    geometry = geo->clipPolygons(geometry, bbox);
+    globeRepetition.firstShift = 360.0f * static_cast<float>(firstGlobe);
+    globeRepetition.shift = 360.0f;
+    numGlobeRepetitions = static_cast<uint32_t>(lastGlobe - firstGlobe + 1);
+}
 
-    return geometry;
+void GraticuleActor::initGeometryHandling(Met3D::GeometryHandling *geo, const GraticuleGeometryKey &key)
+{
+    if (key.mapProjection == ProjectionType::PROJ_LIBRARY)
+    {
+        geo->initProjProjection(key.projLibraryString);
+    }
+    else if (key.mapProjection == ProjectionType::ROTATEDLATLON)
+    {
+        geo->initRotatedLonLatProjection(
+            Met3D::PointF(key.rotatedNorthPoleLongitude, key.rotatedNorthPoleLatitude));
+    }
+}
+
+void GraticuleActor::projectGeometry(Met3D::GeometryHandling *geo, const GraticuleGeometryKey &key,
+                                     Met3D::PolylineSet *geometry, Met3D::PolylineSet *projectedGeometry)
+{
+    if (key.mapProjection == ProjectionType::CYLINDRICAL)
+    {
+        // Cylindrical projections use the geographical coordinates.
+        projectedGeometry->appendPolylines(*geometry);
+        return;
+    }
+
+    // All projection stages treat each polyline independently. Larger
+    // geometries are therefore split into chunks of consecutive polylines
+    // that are processed in parallel and appended in their original order,
+    // which gives the same result as processing them at once.
+    ThreadPool &threadPool = ThreadPool::getShared();
+    size_t numVertices = geometry->getNumVertices();
+    size_t numChunks = std::min<size_t>(threadPool.getNumThreads(), numVertices / minVerticesPerChunk);
+
+    if (numChunks <= 1)
+    {
+        projectPolylines(geo, key, geometry);
+        projectedGeometry->appendPolylines(*geometry);
+        return;
+    }
+
+    // Chunk c contains the polylines [chunkBegin[c], chunkBegin[c + 1]), the
+    // chunks are balanced by their number of vertices.
+    std::vector<size_t> chunkBegin{0};
+    for (size_t polyline = 0; polyline < geometry->getNumPolylines(); polyline++)
+    {
+        size_t chunkEndVertex = numVertices * chunkBegin.size() / numChunks;
+        if (chunkBegin.size() < numChunks && geometry->getPolylineBegin(polyline) >= chunkEndVertex)
+        {
+            chunkBegin.push_back(polyline);
+        }
+    }
+    chunkBegin.push_back(geometry->getNumPolylines());
+    numChunks = chunkBegin.size() - 1;
+
+    std::vector<Met3D::PolylineSet> projectedChunks(numChunks);
+    threadPool.parallelFor(numChunks, [&](size_t chunk) {
+        // Proj objects must not be shared between threads, hence every chunk
+        // creates its transformations in a context of its own.
+        PJ_CONTEXT *projContext = proj_context_create();
+        {
+            Met3D::GeometryHandling chunkGeo(projContext);
+            initGeometryHandling(&chunkGeo, key);
+
+            Met3D::PolylineSet chunkGeometry{chunkGeo.getPolylineMemoryResource()};
+            chunkGeometry.appendPolylines(*geometry, chunkBegin[chunk], chunkBegin[chunk + 1] - chunkBegin[chunk]);
+            projectPolylines(&chunkGeo, key, &chunkGeometry);
+            projectedChunks[chunk].appendPolylines(chunkGeometry);
+        }
+        proj_context_destroy(projContext);
+    });
+
+    for (const Met3D::PolylineSet &projectedChunk : projectedChunks)
+    {
+        projectedGeometry->appendPolylines(projectedChunk);
+    }
+}
+
+void GraticuleActor::projectPolylines(Met3D::GeometryHandling *geo, const GraticuleGeometryKey &key,
+                                      Met3D::PolylineSet *geometry)
+{
+    // Projection-dependent operations.
+    if (key.mapProjection == ProjectionType::PROJ_LIBRARY)
+    {
+        geo->geographicalToProjectedCoordinatesAdaptive(geometry,
+                                                        key.densificationTolerance_deg * projMapUnitsPerDegree);
+    }
+    else if (key.mapProjection == ProjectionType::ROTATEDLATLON)
+    {
+        geo->geographicalToRotatedCoordinatesAdaptive(geometry, key.densificationTolerance_deg);
+    }
 }
 
 uint32_t GraticuleActor::vertexSize = sizeof(glm::vec2);
@@ -367,7 +966,48 @@ std::deque<rendering::PipelineBuilder> GraticuleActor::getPipelineBuilders(const
 
     pipelineBuilder.setVertexInputCreateInfo(vertexInfo, bindingDescription, attributeDescriptions);
 
-    return {std::move(pipelineBuilder)};
+    // The procedural graticule has no vertex input, each pair of vertices
+    // forms a separate line segment.
+    auto graticulePipelineBuilder = Prefab::getPipelineBuilder(device, renderPass, bindlessManager);
+
+    graticulePipelineBuilder.setInputAssemblyCreateInfo(
+        vk::PipelineInputAssemblyStateCreateInfo{.topology = vk::PrimitiveTopology::eLineList});
+
+    core::Shader graticuleShader{std::string(PROJECT_ROOT_DIR) + "/shaders/graticule.glsl"};
+    graticulePipelineBuilder.setShaderStageCreateInfos(device, graticuleShader);
+
+    graticulePipelineBuilder.setRasterizerCreateInfo(vk::PipelineRasterizationStateCreateInfo{
+        .polygonMode = vk::PolygonMode::eFill, .frontFace = vk::FrontFace::eCounterClockwise, .lineWidth = 2.0f});
+
+    // Filled polygons are drawn as indexed triangle lists. The depth bias
+    // keeps the lines in the same plane in front of them.
+    auto polygonPipelineBuilder = Prefab::getPipelineBuilder(device, renderPass, bindlessManager);
+
+    polygonPipelineBuilder.setInputAssemblyCreateInfo(
+        vk::PipelineInputAssemblyStateCreateInfo{.topology = vk::PrimitiveTopology::eTriangleList});
+
+    core::Shader polygonShader{std::string(PROJECT_ROOT_DIR) + "/shaders/simple_geometry.glsl"};
+    polygonPipelineBuilder.setShaderStageCreateInfos(device, polygonShader);
+
+    polygonPipelineBuilder.setRasterizerCreateInfo(
+        vk::PipelineRasterizationStateCreateInfo{.polygonMode = vk::PolygonMode::eFill,
+                                                 .cullMode = vk::CullModeFlagBits::eNone,
+                                                 .frontFace = vk::FrontFace::eCounterClockwise,
+                                                 .depthBiasEnable = VK_TRUE,
+                                                 .depthBiasConstantFactor = 1.0f,
+                                                 .depthBiasSlopeFactor = 1.0f,
+                                                 .lineWidth = 1.0f});
+
+    std::vector<vk::VertexInputAttributeDescription> polygonAttributeDescriptions = {
+        vk::VertexInputAttributeDescription{
+            .location = 0, .binding = 0, .format = vk::Format::eR32G32Sfloat, .offset = 0}};
+    polygonPipelineBuilder.setVertexInputCreateInfo(vertexInfo, bindingDescription, polygonAttributeDescriptions);
+
+    std::deque<rendering::PipelineBuilder> pipelineBuilders;
+    pipelineBuilders.push_back(std::move(pipelineBuilder));
+    pipelineBuilders.push_back(std::move(graticulePipelineBuilder));
+    pipelineBuilders.push_back(std::move(polygonPipelineBuilder));
+    return pipelineBuilders;
 }
 
 } // namespace vkf::scene
\ No newline at end of file
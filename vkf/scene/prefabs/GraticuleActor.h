@@ -15,21 +15,22 @@
 #pragma once
 
 #include "../../common/GeometryHandling.h"
+#include "../../common/NaturalEarthRegistry.h"
+#include "GraticuleGeometryCache.h"
 #include "Prefab.h"
+#include <array>
+#include <glm/vec2.hpp>
 #include <glm/vec4.hpp>
+#include <optional>
+#include <unordered_map>
 
 namespace vkf::scene
 {
 
 // Forward declarations
+struct MaterialComponent;
 struct MeshComponent;
-
-enum class GraticuleType
-{
-    Graticule,
-    Coastline,
-    Borderline
-};
+enum class ProjectionType;
 
 ///
 /// \class GraticuleActor
@@ -52,6 +53,8 @@ class GraticuleActor : public Prefab
 
     void updateComponents() override;
 
+    void updateFrameUniforms(uint32_t cameraHandle) override;
+
     static uint32_t vertexSize;
 
     static std::deque<rendering::PipelineBuilder> getPipelineBuilders(const core::Device &device,
@@ -59,16 +62,209 @@ class GraticuleActor : public Prefab
                                                                       rendering::BindlessManager &bindlessManager);
 
   private:
-    void uploadGeometry(GraticuleType type, MeshComponent &meshComponent);
+    // Layout of the "repetition" uniform buffer of the shader.
+    struct GlobeRepetition
+    {
+        glm::vec4 clipRect;
+        float firstShift;
+        float shift;
+        glm::vec2 padding;
+    };
+
+    // Layout of the "graticule" uniform buffer of the procedural graticule shader.
+    struct ProceduralGraticule
+    {
+        // First longitude, distance between meridians, first latitude and vertex spacing of the meridians.
+        glm::vec4 meridians;
+        // First latitude, distance between parallels, first longitude and vertex spacing of the parallels.
+        glm::vec4 parallels;
+        // Number of meridians, segments per meridian, number of parallels and segments per parallel.
+        glm::uvec4 counts;
+        // Longitude and latitude of the rotated pole, 1 for rotated lon-lat projections and the maximum segment length.
+        glm::vec4 rotatedPole;
+    };
+
+    ///
+    /// \brief Updates the meshes of all children after the graticule, the projection or the bbox has changed.
+    ///
+    /// The polyline geometry that is not cached yet is generated for all children concurrently. The uploads of all
+    /// children are recorded by the UploadManager and submitted with the next frame, so an update does not wait for the
+    /// GPU.
+    ///
+    void updateGeometry();
+
+    ///
+    /// \brief Sets up the shader generated graticule described by key, no vertices are uploaded.
+    ///
+    /// The shader generates the vertices of the graticule from gl_VertexIndex and applies cylindrical or rotated
+    /// lon-lat projections. Projections with proj are generated on the CPU.
+    ///
+    void updateProceduralGraticule(const GraticuleGeometryKey &key, MeshComponent &meshComponent);
+
+    ///
+    /// \brief Selects the level of detail of the meshes from the distance of the camera and the size of the bbox.
+    ///
+    /// Level 0 is the full resolution geometry, level i > 0 is simplified with the tolerance lodToleranceFractions[i - 1]
+    /// relative to the bbox size. The coarsest level whose tolerance is below lodMaxScreenError of the visible map
+    /// height is selected.
+    ///
+    [[nodiscard]] uint32_t selectLevelOfDetail();
+
+    ///
+    /// \brief Returns the height of the map region that is visible around the camera target, in map units.
+    ///
+    [[nodiscard]] float getVisibleMapHeight();
+
+    ///
+    /// \brief Selects the Natural Earth scale of the coast- and borderlines from the visible map height.
+    ///
+    /// The coarsest installed scale whose nominal error is below datasetMaxScreenError of the visible map height is
+    /// selected, and the neighbouring scales are prefetched for the next zoom step.
+    ///
+    /// \return True if the scale of a dataset has changed.
+    ///
+    bool updateDatasetScales();
+
+    ///
+    /// \brief Computes the instances that repeat the globe across the bbox for the given projection.
+    ///
+    /// Cylindrical projections may display bboxes outside the -180..180 degrees range. Instead of copying the geometry
+    /// for each repetition of the globe, the geometry is uploaded once and drawn with one instance per repetition that
+    /// is shifted by 360 degrees in x. The shader clips the instances to the bbox.
+    ///
+    void updateGlobeRepetition(ProjectionType mapProjection);
+
+    ///
+    /// \brief Returns the parameters of the ProjectionComponent and GraticuleComponent that affect the given mesh.
+    ///
+    [[nodiscard]] GraticuleGeometryKey createGeometryKey(GraticuleType type);
+
+    ///
+    /// \brief Generates or reads the geometry described by key and projects it.
+    ///
+    /// The transformations are created in projContext, which must not be used by another thread at the same time.
+    ///
+    static Met3D::PolylineSet generateProjectedGeometry(const GraticuleGeometryKey &key, PJ_CONTEXT *projContext);
+
+    ///
+    /// \brief Reads, projects, clips and uploads the coast- or borderlines described by key in chunks.
+    ///
+    /// The chunks are written straight into the staging buffer of the mesh, so that the host memory required is
+    /// bounded by the chunk size. The geometry is neither cached nor simplified to levels of detail.
+    ///
+    void streamGeometry(const GraticuleGeometryKey &key, MeshComponent &meshComponent);
+
+    ///
+    /// \brief Projects and uploads the filled country polygons described by key.
+    ///
+    /// The polygons are triangulated once per dataset, see GeometryHandling::read2DPolygonsFromShapefile(). A change of
+    /// the projection only transforms the vertices, the triangles are kept except for those that cannot be projected.
+    /// The mesh is clipped to the bbox by the shader, so a change of the bbox keeps the uploaded mesh.
+    ///
+    void uploadFilledPolygons(const GraticuleGeometryKey &key, MeshComponent &meshComponent);
+
+    ///
+    /// \brief Returns the rectangle the projected geometry is clipped to on the CPU.
+    ///
+    [[nodiscard]] Met3D::RectF getClipRect(ProjectionType mapProjection) const;
+
+    ///
+    /// \brief Clips projected geometry to bbox and appends its simplified levels of detail.
+    ///
+    [[nodiscard]] GraticuleGeometryCache::ClippedGeometry clipGeometry(
+        const GraticuleGeometryKey &key, const GraticuleGeometryCache::ProjectedGeometry &projectedGeometry);
+
+    ///
+    /// \brief Initializes the projections of geo according to key.
+    ///
+    static void initGeometryHandling(Met3D::GeometryHandling *geo, const GraticuleGeometryKey &key);
+
+    ///
+    /// \brief Projects geometry and appends the result to projectedGeometry.
+    ///
+    /// Geometries with more than minVerticesPerChunk vertices are processed in parallel chunks, each with its own
+    /// GeometryHandling instance and proj context. The result is identical to the serial processing.
+    ///
+    static void projectGeometry(Met3D::GeometryHandling *geo, const GraticuleGeometryKey &key,
+                                Met3D::PolylineSet *geometry, Met3D::PolylineSet *projectedGeometry);
+
+    ///
+    /// \brief Transforms geometry to the map projection of key.
+    ///
+    /// Proj and rotated lon-lat projections densify the polylines adaptively, such that the projected lines deviate
+    /// by at most key.densificationTolerance_deg from the exact curves, and break them where they cross the map
+    /// boundary.
+    ///
+    static void projectPolylines(Met3D::GeometryHandling *geo, const GraticuleGeometryKey &key,
+                                 Met3D::PolylineSet *geometry);
+
+    static constexpr uint32_t polylinePipelineIndex = 0;
+    static constexpr uint32_t proceduralGraticulePipelineIndex = 1;
+    static constexpr uint32_t filledPolygonPipelineIndex = 2;
+
+    // Heuristic value to eliminate line segments that after projection cross
+    // the map domain due to a connection that after projection is invalid.
+    // This happens when a line segment that connects two closeby vertices after
+    // projection leaves e.g. the eastern side of the map and re-enters on the
+    // western side (or vice versa).
+    // A value of "20deg" seems to work well with global data from NaturalEarth.
+    // NOTE (mr, 28Oct2020): This is "quick&dirty" workaround. The correct
+    // approach to this would be to perform some sort of test that checks if
+    // the correct connection of the two vertices after projection should cross
+    // map boundaries, in such as case the segment needs to be broken up.
+    // Another approach to this was previously implemented in BT's code, see
+    // Met.3D version 1.6 or earlier.
+    // Polylines generated on the CPU are broken at the exact map boundary by
+    // the adaptive densification instead, the value is only used by the
+    // procedural graticule shader.
+    static constexpr float rotatedGridMaxSegmentLength_deg = 20.0f;
+
+    // Smallest number of vertices for which a chunk is processed by a thread of its own.
+    static constexpr size_t minVerticesPerChunk = 16384;
+    // Largest number of vertices of a chunk of streamed coast- or borderlines.
+    static constexpr size_t maxVerticesPerStreamedChunk = 16384;
+
+    // Douglas-Peucker tolerances of the simplified levels of detail relative to the bbox size. For the global lon-lat
+    // map, they correspond to 0.045, 0.18 and 0.72 degrees.
+    static constexpr std::array<float, 3> lodToleranceFractions = {1.0f / 8000.0f, 1.0f / 2000.0f, 1.0f / 500.0f};
+    // Largest simplification error relative to the visible map height, about one pixel.
+    static constexpr float lodMaxScreenError = 1.0f / 1000.0f;
+
+    // Largest positional error of the coast- and borderline datasets relative to the visible map height.
+    static constexpr float datasetMaxScreenError = 1.0f / 250.0f;
+    // Approximate length of a degree at the equator in proj map units, which are metres divided by
+    // Met3D::MetConstants::scaleFactorToFitProjectedCoordsTo360Range.
+    static constexpr float projMapUnitsPerDegree =
+        static_cast<float>(111320.0 / Met3D::MetConstants::scaleFactorToFitProjectedCoordsTo360Range);
+
+    // Vertex spacing of graticule lines before adaptive densification, in degrees.
+    static constexpr float coarseGraticuleVertexSpacing_deg = 10.0f;
+
+    // Default color of the filled countries.
+    inline static const glm::vec4 countryFillColor{0.85f, 0.82f, 0.7f, 1.0f};
 
-    std::vector<std::vector<Met3D::PointF>> projectAndClipGeometry(Met3D::GeometryHandling *geo,
-                                                                   std::vector<std::vector<Met3D::PointF>> geometry,
-                                                                   Met3D::RectF bbox,
-                                                                   double rotatedGridMaxSegmentLength_deg);
+    // Number of configurations per stage whose geometry is kept, e.g. to switch between projections instantly.
+    static constexpr size_t geometryCacheCapacity = 16;
 
     Met3D::RectF bbox = {-180., -90., 180., 90.};
+    GraticuleGeometryCache geometryCache{geometryCacheCapacity};
+    // Natural Earth scales of the coastlines, borderlines and countries.
+    std::array<NaturalEarthScale, 3> datasetScales{NaturalEarthScale::Scale50m, NaturalEarthScale::Scale50m,
+                                                   NaturalEarthScale::Scale50m};
+    // Triangulated country polygons in geographical coordinates and the shapefile they were read from.
+    Met3D::TriangleMesh countryPolygons;
+    std::string countryPolygonsDataset;
+    // Key of the projected country polygons in the country mesh and whether any of their triangles could be projected.
+    std::optional<GraticuleGeometryKey> uploadedCountryPolygonsKey;
+    bool hasUploadedCountryPolygons{false};
+    // Geometry type of each child mesh.
+    std::unordered_map<UUID, GraticuleType> childTypes;
     glm::vec4 prevColor;
-    uint32_t entityBufferModelHandle;
+    uint32_t entityRepetitionUniform;
+    uint32_t entityGraticuleUniform;
+    GlobeRepetition globeRepetition{};
+    ProceduralGraticule proceduralGraticule{};
+    uint32_t numGlobeRepetitions = 1;
 };
 
 } // namespace vkf::scene
\ No newline at end of file
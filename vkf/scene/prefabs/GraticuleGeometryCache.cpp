@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file GraticuleGeometryCache.cpp
+/// \brief This file implements the GraticuleGeometryCache class, which memoizes the geometry of GraticuleActor meshes.
+///
+/// The GraticuleGeometryCache class is part of the vkf::scene namespace. It stores the results of the stages of the
+/// graticule geometry pipeline, so that a GraticuleActor only recomputes the stages whose parameters have changed.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GraticuleGeometryCache.h"
+
+#include <algorithm>
+
+namespace vkf::scene
+{
+
+namespace
+{
+
+bool isSameRect(const Met3D::RectF &a, const Met3D::RectF &b)
+{
+    return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
+} // namespace
+
+GraticuleGeometryCache::GraticuleGeometryCache(size_t capacity) : capacity{capacity}
+{
+}
+
+std::shared_ptr<const GraticuleGeometryCache::ProjectedGeometry> GraticuleGeometryCache::findProjectedGeometry(
+    const GraticuleGeometryKey &key)
+{
+    // Projected geometry does not depend on the bbox, all entries use the default one.
+    return find(projectedEntries, key, Met3D::RectF{});
+}
+
+std::shared_ptr<const GraticuleGeometryCache::ProjectedGeometry> GraticuleGeometryCache::storeProjectedGeometry(
+    const GraticuleGeometryKey &key, Met3D::PolylineSet polylines)
+{
+    return storeProjectedGeometry(key, createProjectedGeometry(std::move(polylines)));
+}
+
+std::shared_ptr<const GraticuleGeometryCache::ProjectedGeometry> GraticuleGeometryCache::storeProjectedGeometry(
+    const GraticuleGeometryKey &key, std::shared_ptr<const ProjectedGeometry> geometry)
+{
+    return store<ProjectedGeometry>(projectedEntries, key, Met3D::RectF{}, std::move(geometry));
+}
+
+std::shared_ptr<const GraticuleGeometryCache::ProjectedGeometry> GraticuleGeometryCache::createProjectedGeometry(
+    Met3D::PolylineSet polylines)
+{
+    auto geometry = std::make_shared<ProjectedGeometry>();
+    geometry->polylines = std::move(polylines);
+    geometry->index = Met3D::PolylineIndex(geometry->polylines);
+    return geometry;
+}
+
+std::shared_ptr<const GraticuleGeometryCache::ClippedGeometry> GraticuleGeometryCache::findClippedGeometry(
+    const GraticuleGeometryKey &key, Met3D::RectF bbox)
+{
+    return find(clippedEntries, key, bbox);
+}
+
+std::shared_ptr<const GraticuleGeometryCache::ClippedGeometry> GraticuleGeometryCache::storeClippedGeometry(
+    const GraticuleGeometryKey &key, Met3D::RectF bbox, ClippedGeometry geometry)
+{
+    return store<ClippedGeometry>(clippedEntries, key, bbox, std::make_shared<ClippedGeometry>(std::move(geometry)));
+}
+
+template <typename Geometry>
+std::shared_ptr<const Geometry> GraticuleGeometryCache::find(std::vector<Entry<Geometry>> &entries,
+                                                             const GraticuleGeometryKey &key,
+                                                             const Met3D::RectF &bbox)
+{
+    for (Entry<Geometry> &entry : entries)
+    {
+        if (entry.key == key && isSameRect(entry.bbox, bbox))
+        {
+            entry.lastUse = ++useCounter;
+            return entry.geometry;
+        }
+    }
+    return nullptr;
+}
+
+template <typename Geometry>
+std::shared_ptr<const Geometry> GraticuleGeometryCache::store(std::vector<Entry<Geometry>> &entries,
+                                                              const GraticuleGeometryKey &key,
+                                                              const Met3D::RectF &bbox,
+                                                              std::shared_ptr<const Geometry> geometry)
+{
+    if (entries.size() >= capacity)
+    {
+        auto leastRecentlyUsed = std::min_element(entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+            return a.lastUse < b.lastUse;
+        });
+        entries.erase(leastRecentlyUsed);
+    }
+    entries.push_back(Entry<Geometry>{key, bbox, geometry, ++useCounter});
+    return geometry;
+}
+
+} // namespace vkf::scene
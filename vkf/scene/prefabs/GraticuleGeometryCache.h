@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \file GraticuleGeometryCache.h
+/// \brief This file declares the GraticuleGeometryCache class, which memoizes the geometry of GraticuleActor meshes.
+///
+/// The GraticuleGeometryCache class is part of the vkf::scene namespace. It stores the results of the stages of the
+/// graticule geometry pipeline, so that a GraticuleActor only recomputes the stages whose parameters have changed.
+///
+/// \author Joshua Lowe
+/// \date 10/17/2026
+///
+/// The license and distribution terms for this file may be found in the file LICENSE in this distribution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "../../common/GeometryHandling.h"
+#include "../../common/PolylineIndex.h"
+#include "../../common/PolylineSet.h"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vkf::scene
+{
+
+// Forward declarations
+enum class ProjectionType;
+
+enum class GraticuleType
+{
+    Graticule,
+    Coastline,
+    Borderline,
+    Country
+};
+
+///
+/// \struct GraticuleGeometryKey
+/// \brief Parameters that determine the projected geometry of a GraticuleActor mesh.
+///
+/// Parameters that do not affect a mesh are left at their default values, so that changing them does not invalidate
+/// the cached geometry of the mesh. E.g. the graticule spacing is only set for graticule meshes and the rotated pole is
+/// only set for rotated lon-lat projections.
+///
+struct GraticuleGeometryKey
+{
+    GraticuleType type;
+    // Shapefile of coast- and borderlines or country polygons.
+    std::string dataset;
+    std::array<float, 3> graticuleLongitudes{};
+    std::array<float, 3> graticuleLatitudes{};
+    float graticuleSpacingLongitude{0.0f};
+    float graticuleSpacingLatitude{0.0f};
+    ProjectionType mapProjection;
+    std::string projLibraryString;
+    float rotatedNorthPoleLongitude{0.0f};
+    float rotatedNorthPoleLatitude{0.0f};
+    // Largest deviation of the densified polylines from the projected curves in degrees, only set for proj and
+    // rotated lon-lat projections.
+    float densificationTolerance_deg{0.0f};
+
+    bool operator==(const GraticuleGeometryKey &other) const = default;
+};
+
+///
+/// \class GraticuleGeometryCache
+/// \brief Memoizes projected and clipped graticule geometry.
+///
+/// Projected geometry is stored per GraticuleGeometryKey together with a spatial index, so that a change of the bbox
+/// only requires clipping. Clipped geometry, including its levels of detail, is stored per key and bbox, so that
+/// switching back to a previous projection or bbox only requires the upload. Each stage keeps at most capacity entries
+/// and evicts the least recently used one. The returned geometry stays valid while it is referenced, also if its entry
+/// is evicted. The cache itself must only be used by one thread.
+///
+class GraticuleGeometryCache
+{
+  public:
+    struct ProjectedGeometry
+    {
+        Met3D::PolylineSet polylines;
+        Met3D::PolylineIndex index;
+    };
+
+    struct ClippedGeometry
+    {
+        // Polylines of all levels of detail, see MeshComponent::lodDrawOffsets.
+        Met3D::PolylineSet polylines;
+        std::vector<size_t> lodDrawOffsets;
+    };
+
+    explicit GraticuleGeometryCache(size_t capacity);
+
+    ///
+    /// \brief Returns the projected geometry of key, or nullptr if it is not cached.
+    ///
+    std::shared_ptr<const ProjectedGeometry> findProjectedGeometry(const GraticuleGeometryKey &key);
+
+    ///
+    /// \brief Stores the projected polylines of key and builds their spatial index.
+    ///
+    std::shared_ptr<const ProjectedGeometry> storeProjectedGeometry(const GraticuleGeometryKey &key,
+                                                                    Met3D::PolylineSet polylines);
+
+    ///
+    /// \brief Stores projected geometry that was created with createProjectedGeometry().
+    ///
+    std::shared_ptr<const ProjectedGeometry> storeProjectedGeometry(const GraticuleGeometryKey &key,
+                                                                    std::shared_ptr<const ProjectedGeometry> geometry);
+
+    ///
+    /// \brief Builds the spatial index of projected polylines without storing them, may be called from any thread.
+    ///
+    static std::shared_ptr<const ProjectedGeometry> createProjectedGeometry(Met3D::PolylineSet polylines);
+
+    ///
+    /// \brief Returns the geometry of key clipped to bbox, or nullptr if it is not cached.
+    ///
+    std::shared_ptr<const ClippedGeometry> findClippedGeometry(const GraticuleGeometryKey &key, Met3D::RectF bbox);
+
+    std::shared_ptr<const ClippedGeometry> storeClippedGeometry(const GraticuleGeometryKey &key, Met3D::RectF bbox,
+                                                                ClippedGeometry geometry);
+
+  private:
+    template <typename Geometry> struct Entry
+    {
+        GraticuleGeometryKey key;
+        Met3D::RectF bbox;
+        std::shared_ptr<const Geometry> geometry;
+        uint64_t lastUse;
+    };
+
+    template <typename Geometry>
+    std::shared_ptr<const Geometry> find(std::vector<Entry<Geometry>> &entries, const GraticuleGeometryKey &key,
+                                         const Met3D::RectF &bbox);
+
+    template <typename Geometry>
+    std::shared_ptr<const Geometry> store(std::vector<Entry<Geometry>> &entries, const GraticuleGeometryKey &key,
+                                          const Met3D::RectF &bbox, std::shared_ptr<const Geometry> geometry);
+
+    size_t capacity;
+    uint64_t useCounter{0};
+    std::vector<Entry<ProjectedGeometry>> projectedEntries;
+    std::vector<Entry<ClippedGeometry>> clippedEntries;
+};
+
+} // namespace vkf::scene
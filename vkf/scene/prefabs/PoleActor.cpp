@@ -133,25 +133,36 @@ void PoleActor::updateComponents()
     for (const auto &pair : relationComp.children)
     {
         auto pole = pair.second;
-        auto &relationPoleComp = pole->getComponent<scene::RelationComponent>();
-        auto &transformComp = pole->getComponent<scene::TransformComponent>();
         auto &poleComp = pole->getComponent<PoleComponent>();
 
         if (colorChanged)
         {
             poleComp.poleData.geometryColor = colorComp.color;
         }
+    }
+}
+
+void PoleActor::updateFrameUniforms(uint32_t cameraHandle)
+{
+    auto &relationComp = entity.getComponent<scene::RelationComponent>();
+    for (const auto &pair : relationComp.children)
+    {
+        auto pole = pair.second;
+        auto &relationPoleComp = pole->getComponent<scene::RelationComponent>();
+        auto &transformComp = pole->getComponent<scene::TransformComponent>();
+        auto &poleComp = pole->getComponent<PoleComponent>();
+
+        // The lines and ticks of a pole share its uniforms.
+        uint32_t modelHandle = bindlessManager.allocateFrameUniform(glm::value_ptr(transformComp.modelMatrix),
+                                                                    sizeof(transformComp.modelMatrix));
+        uint32_t dataHandle = bindlessManager.allocateFrameUniform(&poleComp.poleData, sizeof(poleComp.poleData));
 
         for (const auto &childPair : relationPoleComp.children)
         {
-            auto child = childPair.second;
-            auto &materialComp = child->getComponent<MaterialComponent>();
-
-            bindlessManager.updateBuffer(materialComp.getResourceIndex("model"),
-                                         glm::value_ptr(transformComp.modelMatrix), sizeof(transformComp.modelMatrix),
-                                         0);
-            bindlessManager.updateBuffer(materialComp.getResourceIndex("data"), &poleComp.poleData,
-                                         sizeof(poleComp.poleData), 0);
+            auto &materialComp = childPair.second->getComponent<MaterialComponent>();
+            materialComp.updateResource("camera", cameraHandle);
+            materialComp.updateResource("model", modelHandle);
+            materialComp.updateResource("data", dataHandle);
         }
     }
 }
@@ -166,17 +177,9 @@ void PoleActor::destroy()
         auto &relationPoleComp = pole->getComponent<scene::RelationComponent>();
         auto &idComp = pole->getComponent<scene::IdComponent>();
 
-        for (bool once{true}; auto &childPair : relationPoleComp.children)
+        for (auto &childPair : relationPoleComp.children)
         {
-            auto child = childPair.second;
-            auto &materialComp = child->getComponent<MaterialComponent>();
-            if (once)
-            {
-                bindlessManager.removeBuffer(materialComp.getResourceIndex("data"));
-                bindlessManager.removeBuffer(materialComp.getResourceIndex("model"));
-                once = false;
-            }
-            child->destroy();
+            childPair.second->destroy();
         }
 
         scene->removeGlobalFunction(idComp.uuid);
@@ -196,23 +199,8 @@ void PoleActor::createPole()
     pole.addComponent<scene::TransformComponent>(scene->getCamera(), glm::vec3{0.0f}, glm::vec3{0.0f}, glm::vec3{1.0f});
     auto &poleComp = pole.addComponent<scene::PoleComponent>(scene->getCamera());
 
-    vk::BufferCreateInfo bufferModelCreateInfo{.size = 64, .usage = vk::BufferUsageFlagBits::eUniformBuffer};
-    core::Buffer bufferModel{*device, bufferModelCreateInfo,
-                             VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT};
-
-    auto entityBufferModelHandle = bindlessManager.storeBuffer(bufferModel, vk::BufferUsageFlagBits::eUniformBuffer);
-
-    vk::BufferCreateInfo bufferDataCreateInfo{.size = sizeof(PoleComponent::PoleData),
-                                              .usage = vk::BufferUsageFlagBits::eUniformBuffer};
-    core::Buffer bufferData{*device, bufferDataCreateInfo,
-                            VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT};
-
-    auto entityBufferDataHandle = bindlessManager.storeBuffer(bufferData, vk::BufferUsageFlagBits::eUniformBuffer);
-
-    scene->addGlobalFunction(idComp.uuid, [&, entityBufferDataHandle]() {
-        poleComp.updateData();
-        bindlessManager.updateBuffer(entityBufferDataHandle, &poleComp.poleData, sizeof(poleComp.poleData), 0);
-    });
+    // The pole data is copied into a frame uniform by updateFrameUniforms().
+    scene->addGlobalFunction(idComp.uuid, [&poleComp]() { poleComp.updateData(); });
 
     auto &relationPoleComp = pole.addComponent<scene::RelationComponent>(entity.getHandle());
 
@@ -232,9 +220,9 @@ void PoleActor::createPole()
 
         materialComp.addResource("camera", scene->getCamera()->getHandle());
 
-        materialComp.addResource("model", entityBufferModelHandle);
+        materialComp.addResource("model", 0);
 
-        materialComp.addResource("data", entityBufferDataHandle);
+        materialComp.addResource("data", 0);
 
         auto &meshComp = child.addComponent<scene::MeshComponent>(*device);
 
@@ -264,17 +252,9 @@ void PoleActor::destroyPole()
 
         device->getHandle().waitIdle();
 
-        for (bool once{true}; auto &childPair : relationPoleComp.children)
+        for (auto &childPair : relationPoleComp.children)
         {
-            auto child = childPair.second;
-            auto &materialComp = child->getComponent<MaterialComponent>();
-            if (once)
-            {
-                bindlessManager.removeBuffer(materialComp.getResourceIndex("data"));
-                bindlessManager.removeBuffer(materialComp.getResourceIndex("model"));
-                once = false;
-            }
-            child->destroy();
+            childPair.second->destroy();
         }
 
         scene->removeGlobalFunction(idComp.uuid);
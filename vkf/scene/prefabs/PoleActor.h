@@ -50,6 +50,8 @@ class PoleActor : public Prefab
 
     void updateComponents() override;
 
+    void updateFrameUniforms(uint32_t cameraHandle) override;
+
     static uint32_t vertexSize;
 
     static std::deque<rendering::PipelineBuilder> getPipelineBuilders(const core::Device &device,
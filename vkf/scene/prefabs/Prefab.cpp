@@ -59,6 +59,7 @@ rendering::PipelineBuilder Prefab::getPipelineBuilder(const core::Device &device
 
     auto &pipelineLayout = bindlessManager.getPipelineLayout();
     pipelineBuilder.setPipelineLayout(pipelineLayout);
+    pipelineBuilder.setPipelineFlags(bindlessManager.getPipelineCreateFlags());
     pipelineBuilder.setRenderPass(*renderPass.getHandle());
 
     return pipelineBuilder;
@@ -60,6 +60,17 @@ class Prefab
     ///
     virtual void updateComponents() = 0;
 
+    ///
+    /// \brief Pure virtual method to allocate the frame uniforms of a prefab.
+    ///
+    /// This method is called every frame for all prefabs. It copies the per-object uniforms, e.g. model matrices and
+    /// colors, into the frame uniform ring of the BindlessManager and updates the resources of the materials to the
+    /// new handles. It must be implemented in any concrete subclass.
+    ///
+    /// \param cameraHandle The handle of the camera uniform of the current frame.
+    ///
+    virtual void updateFrameUniforms(uint32_t cameraHandle) = 0;
+
     ///
     /// \brief Static method to get a PipelineBuilder for a prefab.
     ///
@@ -58,13 +58,8 @@ UUID Texture2D::create(const core::Device &device, std::deque<core::Pipeline *>
     auto &materialComp = entity.addComponent<MaterialComponent>(std::move(pipelines));
 
     materialComp.addResource("camera", scene->getCamera()->getHandle());
-
-    vk::BufferCreateInfo bufferModelCreateInfo{.size = 64, .usage = vk::BufferUsageFlagBits::eUniformBuffer};
-    core::Buffer bufferModel{device, bufferModelCreateInfo,
-                             VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT};
-
-    auto entityBufferModelHandle = bindlessManager.storeBuffer(bufferModel, vk::BufferUsageFlagBits::eUniformBuffer);
-    materialComp.addResource("model", entityBufferModelHandle);
+    // Set every frame by updateFrameUniforms().
+    materialComp.addResource("model", 0);
 
     auto &textureComp = entity.addComponent<scene::TextureComponent>(device);
     auto image = textureComp.createImage();
@@ -95,13 +90,9 @@ void Texture2D::updateGui()
 
 void Texture2D::updateComponents()
 {
-    auto &transformComp = entity.getComponent<scene::TransformComponent>();
     auto &textureComp = entity.getComponent<scene::TextureComponent>();
 
     auto &materialComp = entity.getComponent<MaterialComponent>();
-    bindlessManager.updateBuffer(materialComp.getResourceIndex("model"), glm::value_ptr(transformComp.modelMatrix),
-                                 sizeof(transformComp.modelMatrix), 0);
-
     if (textureComp.hasNewTexture)
     {
         auto image = textureComp.createImage();
@@ -109,10 +100,20 @@ void Texture2D::updateComponents()
     }
 }
 
+void Texture2D::updateFrameUniforms(uint32_t cameraHandle)
+{
+    auto &transformComp = entity.getComponent<scene::TransformComponent>();
+    uint32_t modelHandle = bindlessManager.allocateFrameUniform(glm::value_ptr(transformComp.modelMatrix),
+                                                                sizeof(transformComp.modelMatrix));
+
+    auto &materialComp = entity.getComponent<MaterialComponent>();
+    materialComp.updateResource("camera", cameraHandle);
+    materialComp.updateResource("model", modelHandle);
+}
+
 void Texture2D::destroy()
 {
     auto &materialComp = entity.getComponent<MaterialComponent>();
-    bindlessManager.removeBuffer(materialComp.getResourceIndex("model"));
     bindlessManager.removeImage(materialComp.getResourceIndex("texture"));
     entity.destroy();
 }
@@ -74,6 +74,11 @@ class Texture2D : public Prefab
     ///
     void updateComponents() override;
 
+    ///
+    /// \brief Allocates the frame uniforms of the Texture2D prefab.
+    ///
+    void updateFrameUniforms(uint32_t cameraHandle) override;
+
     static uint32_t vertexSize;
 
     static std::deque<rendering::PipelineBuilder> getPipelineBuilders(const core::Device &device,